@@ -0,0 +1,67 @@
+include_guard(GLOBAL)
+cmake_policy(VERSION 3.28)
+
+# glslc ships with the vulkan sdk, tools/binaries is checked first so a pinned compiler can live in the repository.
+find_program(GLSLC_EXECUTABLE glslc
+  HINTS "${CMAKE_SOURCE_DIR}/tools/binaries" "$ENV{VULKAN_SDK}/bin"
+  REQUIRED
+)
+message(STATUS "Compiling shaders with: ${GLSLC_EXECUTABLE}")
+
+set(VENUS_EMBED_SPIRV_SCRIPT "${CMAKE_CURRENT_LIST_DIR}/embedSpirv.cmake")
+set(VENUS_SHADER_REGISTRY_TEMPLATE "${CMAKE_CURRENT_LIST_DIR}/shaderRegistry.cpp.in")
+
+# Compiles every .vert, .frag and .comp shader in 'shader_directory' to SPIR-V at build time and embeds the words into
+# 'target' through a generated shader registry, see shaderRegistry.hpp. Shaders are looked up by file name.
+function(venus_embed_shaders target shader_directory)
+  file(GLOB shader_sources CONFIGURE_DEPENDS
+    "${shader_directory}/*.vert"
+    "${shader_directory}/*.frag"
+    "${shader_directory}/*.comp"
+  )
+
+  set(generated_directory "${CMAKE_CURRENT_BINARY_DIR}/generatedShaders")
+  file(MAKE_DIRECTORY "${generated_directory}")
+
+  set(shader_word_files "")
+  set(VENUS_SHADER_ARRAYS "")
+  set(VENUS_SHADER_ENTRIES "")
+  list(LENGTH shader_sources VENUS_SHADER_COUNT)
+
+  foreach(shader_source IN LISTS shader_sources)
+    get_filename_component(shader_name "${shader_source}" NAME)
+    string(MAKE_C_IDENTIFIER "${shader_name}" shader_identifier)
+    string(TOUPPER "${shader_identifier}" shader_identifier)
+
+    set(spirv_file "${generated_directory}/${shader_name}.spv")
+    set(word_file "${generated_directory}/${shader_name}.words")
+
+    # the depfile lists #include'd shader sources so editing one recompiles every shader using it.
+    add_custom_command(
+      OUTPUT "${spirv_file}" "${word_file}"
+      COMMAND "${GLSLC_EXECUTABLE}" --target-env=vulkan1.3 -MD -MF "${spirv_file}.d" -MT "${spirv_file}"
+              "${shader_source}" -o "${spirv_file}"
+      COMMAND "${CMAKE_COMMAND}" -DSPIRV_FILE=${spirv_file} -DWORD_FILE=${word_file} -P "${VENUS_EMBED_SPIRV_SCRIPT}"
+      DEPENDS "${shader_source}" "${VENUS_EMBED_SPIRV_SCRIPT}"
+      DEPFILE "${spirv_file}.d"
+      COMMENT "Compiling and embedding shader ${shader_name}"
+      VERBATIM
+    )
+
+    list(APPEND shader_word_files "${word_file}")
+    string(APPEND VENUS_SHADER_ARRAYS
+      "\t\tconstexpr auto ${shader_identifier} = std::to_array<uint32_t>({\n#include \"${shader_name}.words\"\n\t\t});\n")
+    string(APPEND VENUS_SHADER_ENTRIES
+      "\t\t\tEmbeddedShader{.name = \"${shader_name}\", .code = ${shader_identifier}},\n")
+  endforeach()
+
+  set(registry_source "${generated_directory}/shaderRegistry.cpp")
+  configure_file("${VENUS_SHADER_REGISTRY_TEMPLATE}" "${registry_source}" @ONLY)
+
+  set_source_files_properties(${shader_word_files} PROPERTIES HEADER_FILE_ONLY ON)
+  target_sources(${target} PRIVATE "${registry_source}" ${shader_word_files})
+  target_include_directories(${target} PRIVATE "${generated_directory}")
+
+  # shader hot reload recompiles with the same compiler, see shaderWatcher.hpp.
+  target_compile_definitions(${target} PRIVATE VENUS_GLSLC_EXECUTABLE="${GLSLC_EXECUTABLE}")
+endfunction()
@@ -0,0 +1,14 @@
+# Run in script mode by embedShaders.cmake, turns the SPIR-V binary SPIRV_FILE into the comma separated list of words
+# WORD_FILE that the generated shader registry #includes as an array initializer.
+cmake_minimum_required(VERSION 3.28)
+
+file(READ "${SPIRV_FILE}" spirv_hex HEX)
+string(LENGTH "${spirv_hex}" spirv_hex_length)
+math(EXPR spirv_hex_remainder "${spirv_hex_length} % 8")
+if(spirv_hex_length EQUAL 0 OR NOT spirv_hex_remainder EQUAL 0)
+  message(FATAL_ERROR "${SPIRV_FILE} is not a whole number of SPIR-V words.")
+endif()
+
+# glslc writes little endian words, reassembling each word from its bytes keeps the values right on any host.
+string(REGEX REPLACE "(..)(..)(..)(..)" "0x\\4\\3\\2\\1U,\n" spirv_words "${spirv_hex}")
+file(WRITE "${WORD_FILE}" "${spirv_words}")
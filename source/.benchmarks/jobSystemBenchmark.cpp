@@ -0,0 +1,94 @@
+#include "jobSystem.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+namespace {
+	// usage: V_jobSystemBenchmark
+	// Reports the scheduling cost of an empty job and how a compute bound parallelFor scales from one thread up to
+	// hardware_concurrency threads. Build with the release preset, debug builds mostly measure asserts.
+	// Every run first checks that a parallelFor of more chunks than a job ring holds visits each index exactly once.
+	constexpr uint32_t EMPTY_JOB_BATCH = 1000;
+	constexpr uint32_t EMPTY_JOB_BATCH_COUNT = 200;
+
+	constexpr uint32_t SCALING_ELEMENT_COUNT = 1U << 22U;
+	constexpr uint32_t SCALING_GRAIN_SIZE = 4096;
+	constexpr uint32_t SCALING_REPEAT_COUNT = 10;
+
+	// sixteen times JobSystem::JOB_RING_CAPACITY chunks of one index each.
+	constexpr uint32_t OVERFLOW_CHUNK_COUNT = 16 * venus::JobSystem::JOB_RING_CAPACITY;
+
+	using Clock = std::chrono::steady_clock;
+
+	auto visitsEveryChunkOnce(venus::JobSystem &jobSystem) -> bool {
+		std::vector<std::atomic<uint32_t>> visits(OVERFLOW_CHUNK_COUNT);
+		jobSystem.parallelFor(OVERFLOW_CHUNK_COUNT, 1, [&visits](uint32_t begin, uint32_t end) {
+			for(uint32_t i = begin; i < end; ++i) {
+				visits[i].fetch_add(1, std::memory_order_relaxed);
+			}
+		});
+		return std::ranges::all_of(visits, [](const std::atomic<uint32_t> &count) { return count.load() == 1; });
+	}
+
+	auto measureEmptyJobNanoseconds(venus::JobSystem &jobSystem) -> double {
+		const auto START = Clock::now();
+		for(uint32_t batch = 0; batch < EMPTY_JOB_BATCH_COUNT; ++batch) {
+			venus::JobCounter counter;
+			for(uint32_t job = 0; job < EMPTY_JOB_BATCH; ++job) {
+				jobSystem.schedule([]() {}, &counter);
+			}
+			jobSystem.wait(counter);
+		}
+		const std::chrono::duration<double, std::nano> ELAPSED = Clock::now() - START;
+		return ELAPSED.count() / static_cast<double>(EMPTY_JOB_BATCH * EMPTY_JOB_BATCH_COUNT);
+	}
+
+	auto measureParallelForMilliseconds(venus::JobSystem &jobSystem, std::vector<float> &values) -> double {
+		const auto START = Clock::now();
+		for(uint32_t repeat = 0; repeat < SCALING_REPEAT_COUNT; ++repeat) {
+			jobSystem.parallelFor(static_cast<uint32_t>(values.size()), SCALING_GRAIN_SIZE, [&values](uint32_t begin, uint32_t end) {
+				for(uint32_t i = begin; i < end; ++i) {
+					values[i] = std::sqrt((values[i] * values[i]) + 1.0F);
+				}
+			});
+		}
+		const std::chrono::duration<double, std::milli> ELAPSED = Clock::now() - START;
+		return ELAPSED.count() / SCALING_REPEAT_COUNT;
+	}
+}  // namespace
+
+auto main() -> int {
+	const uint32_t maxThreads = std::max(std::thread::hardware_concurrency(), 1U);
+	std::vector<float> values(SCALING_ELEMENT_COUNT, 1.0F);
+
+	std::cout << std::fixed << std::setprecision(2);
+	std::cout << "threads  ns/empty-job  parallelFor-ms  speedup\n";
+
+	double singleThreadMilliseconds = 0.0;
+	for(uint32_t threadCount = 1; threadCount <= maxThreads; ++threadCount) {
+		venus::JobSystem jobSystem(threadCount);
+		if(!visitsEveryChunkOnce(jobSystem)) {
+			std::cerr << "parallelFor over " << OVERFLOW_CHUNK_COUNT << " chunks lost or repeated a chunk with "
+								<< threadCount << " threads.\n";
+			return 1;
+		}
+
+		const double jobNanoseconds = measureEmptyJobNanoseconds(jobSystem);
+		const double forMilliseconds = measureParallelForMilliseconds(jobSystem, values);
+		if(threadCount == 1) {
+			singleThreadMilliseconds = forMilliseconds;
+		}
+
+		std::cout << std::setw(7) << threadCount << std::setw(14) << jobNanoseconds << std::setw(16) << forMilliseconds
+							<< std::setw(9) << (singleThreadMilliseconds / forMilliseconds) << '\n';
+	}
+
+	return 0;
+}
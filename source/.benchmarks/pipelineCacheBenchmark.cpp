@@ -0,0 +1,65 @@
+#include "application.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string_view>
+#include <system_error>
+
+namespace {
+	// usage: V_pipelineCacheBenchmark [--windowed]
+	// Starts the renderer once with the pipeline cache file removed and then again with the file the first run left
+	// behind, reporting how long renderer and pipeline creation took in each case. Runs headless unless '--windowed'
+	// is passed.
+	constexpr const char *BENCHMARK_CACHE_PATH = "cache/pipelineCacheBenchmark.cache";
+	constexpr uint32_t WARM_RUN_COUNT = 3;
+
+	auto startRenderer(const bool &headless) -> venus::StartupReport {
+		const venus::ApplicationConfigDetails config{
+			.identity = {.name = "Venus Pipeline Cache Benchmark", .version = {.major = 1, .minor = 0, .patch = 0}},
+			.windowConfig = {.title = "Venus Pipeline Cache Benchmark",
+											 .ResolutionBit = venus::RESOLUTION_4x3_SVGA_BIT,
+											 .AspectRatioFlag = venus::ASPECT_RATIO_4_BY_3_FLAG_BIT,
+											 .WindowModeFlag = venus::WINDOW_MODE_NORMAL_FLAG_BIT,
+											 .PresentPolicyFlag = venus::PRESENT_POLICY_MAX_THROUGHPUT_FLAG_BIT},
+			.headlessConfig = {.enabled = headless, .frameCount = 1},
+			.renderThreadConfig = {.enabled = false},
+			.pipelineCacheConfig = {.filePath = BENCHMARK_CACHE_PATH},
+			.shaderConfig = {.overrideDirectory = nullptr, .watchDirectory = nullptr}};
+
+		// the cache is written back when the application is destroyed, before the next run starts.
+		const auto application = std::make_unique<venus::Application>(config);
+		return application->getStartupReport();
+	}
+
+	void printReport(const char *label, const venus::StartupReport &report) {
+		std::cout << std::setw(6) << label << std::setw(13) << report.rendererCreationMilliseconds << std::setw(13)
+							<< report.pipelineCreationMilliseconds << std::setw(7) << report.pipelineCacheHits << std::setw(9)
+							<< report.pipelineCacheMisses << std::setw(8) << (report.pipelineCacheLoaded ? "yes" : "no") << '\n';
+	}
+}  // namespace
+
+auto main(int argc, char **argv) -> int {
+	const bool headless = argc < 2 || std::string_view(argv[1]) != "--windowed";
+
+	std::error_code error;
+	std::filesystem::remove(BENCHMARK_CACHE_PATH, error);
+
+	std::cout << std::fixed << std::setprecision(3);
+	std::cout << "   run  renderer-ms  pipeline-ms  hits  misses  loaded\n";
+
+	try {
+		printReport("cold", startRenderer(headless));
+		for(uint32_t run = 0; run < WARM_RUN_COUNT; ++run) {
+			printReport("warm", startRenderer(headless));
+		}
+	} catch(const std::exception &e) {
+		std::cerr << e.what() << '\n';
+		return 1;
+	}
+
+	std::filesystem::remove(BENCHMARK_CACHE_PATH, error);
+	return 0;
+}
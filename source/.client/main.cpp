@@ -1,26 +1,125 @@
 #include "application.hpp"
 
+#include <array>
+#include <charconv>
+#include <cmath>
 #include <iostream>
 #include <memory>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <system_error>
+
+namespace {
+	constexpr std::string_view USAGE = "usage: V_client [--headless [<frame-count>]] [--render-thread] "
+																		 "[--shader-dir <directory>] [--watch-shaders <source directory>]\n";
+
+	// nothing when the frame count is not a whole number, leaving it out runs the default number of frames.
+	auto parseHeadlessConfig(std::span<char *> args) -> std::optional<venus::HeadlessConfigDetails> {
+		venus::HeadlessConfigDetails headless{.enabled = false, .frameCount = 0};
+		for(size_t i = 1; i < args.size(); ++i) {
+			if(std::string_view(args[i]) != "--headless") {
+				continue;
+			}
+
+			headless.enabled = true;
+			if(i + 1 < args.size() && !std::string_view(args[i + 1]).starts_with("--")) {
+				const std::string_view countArg(args[i + 1]);
+				const char *countEnd = countArg.data() + countArg.size();
+				const auto [parsedEnd, error] = std::from_chars(countArg.data(), countEnd, headless.frameCount);
+				if(error != std::errc() || parsedEnd != countEnd) {
+					std::cerr << "invalid frame count '" << countArg << "'\n";
+					return std::nullopt;
+				}
+			}
+		}
+		return headless;
+	}
+
+	auto parseRenderThreadConfig(std::span<char *> args) -> venus::RenderThreadConfigDetails {
+		venus::RenderThreadConfigDetails renderThread{.enabled = false};
+		for(size_t i = 1; i < args.size(); ++i) {
+			if(std::string_view(args[i]) == "--render-thread") {
+				renderThread.enabled = true;
+			}
+		}
+		return renderThread;
+	}
+
+	auto parseShaderConfig(std::span<char *> args) -> venus::ShaderConfigDetails {
+		venus::ShaderConfigDetails shaders{.overrideDirectory = nullptr, .watchDirectory = nullptr};
+		for(size_t i = 1; i + 1 < args.size(); ++i) {
+			if(std::string_view(args[i]) == "--shader-dir") {
+				shaders.overrideDirectory = args[i + 1];
+			} else if(std::string_view(args[i]) == "--watch-shaders") {
+				shaders.watchDirectory = args[i + 1];
+			}
+		}
+		return shaders;
+	}
+
+	// facing the viewer, wound clockwise as seen on screen.
+	constexpr std::array<venus::MeshVertex, 3> TRIANGLE_VERTICES{
+		{{.position = {0.0F, -0.5F, 0.0F}, .normal = {0.0F, 0.0F, -1.0F}, .uv = {0.5F, 0.0F}},
+		 {.position = {0.5F, 0.5F, 0.0F}, .normal = {0.0F, 0.0F, -1.0F}, .uv = {1.0F, 1.0F}},
+		 {.position = {-0.5F, 0.5F, 0.0F}, .normal = {0.0F, 0.0F, -1.0F}, .uv = {0.0F, 1.0F}}}};
+	constexpr std::array<uint32_t, 3> TRIANGLE_INDICES{0, 1, 2};
+
+	// column major rotation about the view axis.
+	auto rotationZ(const float &radians) -> std::array<float, 16> {
+		const float cosine = std::cos(radians);
+		const float sine = std::sin(radians);
+		return {cosine, sine, 0.0F, 0.0F, -sine, cosine, 0.0F, 0.0F, 0.0F, 0.0F, 1.0F, 0.0F, 0.0F, 0.0F, 0.0F, 1.0F};
+	}
+}  // namespace
+
+auto main(int argc, char **argv) -> int {
+	const std::optional<venus::HeadlessConfigDetails> headlessConfig = parseHeadlessConfig(std::span(argv, argc));
+	if(!headlessConfig.has_value()) {
+		std::cerr << USAGE;
+		return 1;
+	}
 
-auto main() -> int {
 	venus::ApplicationIdentityDetails appID{.name = "Venus Client", .version = {.major = 1, .minor = 0, .patch = 0}};
 
 	venus::WindowConfigDetails windowDetails{.title = "Venus Client",
 																					 .ResolutionBit = venus::RESOLUTION_4x3_SVGA_BIT,
 																					 .AspectRatioFlag = venus::ASPECT_RATIO_4_BY_3_FLAG_BIT,
-																					 .WindowModeFlag = venus::WINDOW_MODE_NORMAL_FLAG_BIT};
+																					 .WindowModeFlag = venus::WINDOW_MODE_NORMAL_FLAG_BIT,
+																					 .PresentPolicyFlag = venus::PRESENT_POLICY_LOW_LATENCY_FLAG_BIT};
 
-	venus::ApplicationConfigDetails config{.identity = appID, .windowConfig = windowDetails};
+	venus::ApplicationConfigDetails config{.identity = appID,
+																				 .windowConfig = windowDetails,
+																				 .headlessConfig = headlessConfig.value(),
+																				 .renderThreadConfig = parseRenderThreadConfig(std::span(argv, argc)),
+																				 .pipelineCacheConfig = {.filePath = "cache/pipeline.cache"},
+																				 .shaderConfig = parseShaderConfig(std::span(argv, argc))};
 
 	std::unique_ptr<venus::Application> VNS_APP = std::make_unique<venus::Application>(config);
 
 	try {
+		const venus::MeshHandle triangle =
+			VNS_APP->createMesh({.vertices = TRIANGLE_VERTICES, .indices = TRIANGLE_INDICES});
+		const venus::MaterialHandle material = VNS_APP->createMaterial(
+			{.vertexShader = nullptr, .fragmentShader = nullptr, .baseColor = {1.0F, 0.45F, 0.1F, 1.0F}});
+
+		venus::Application &app = *VNS_APP;
+		VNS_APP->setFrameCallback([&app, triangle, material](const venus::FrameState &frameState) {
+			app.submitDraw({.mesh = triangle,
+											.material = material,
+											.transform = rotationZ(static_cast<float>(frameState.simulationSeconds))});
+		});
 		VNS_APP->run();
 	} catch(const std::exception &e) {
 		std::cerr << e.what() << '\n';
 		return 1;
 	}
 
+	if(config.headlessConfig.enabled) {
+		const venus::FrameThroughputReport report = VNS_APP->getThroughputReport();
+		std::cout << "frames: " << report.frameCount << " seconds: " << report.elapsedSeconds
+							<< " fps: " << report.framesPerSecond << " ms/frame: " << report.averageFrameMilliseconds << '\n';
+	}
+
 	return 0;
-}
\ No newline at end of file
+}
@@ -4,6 +4,9 @@
 #include "VN_logger.hpp"
 #include "runtime.hpp"
 
+// STDLIB
+#include <utility>
+
 namespace venus {
 
 	Application::Application(const ApplicationConfigDetails &configDetails): m_details(configDetails) {
@@ -24,4 +27,30 @@ namespace venus {
 		m_runtime->startEngine();
 	}
 
+	auto Application::createMesh(const MeshData &meshData) -> MeshHandle { return m_runtime->createMesh(meshData); }
+
+	void Application::destroyMesh(const MeshHandle &mesh) { m_runtime->destroyMesh(mesh); }
+
+	auto Application::createTexture(const TextureData &textureData) -> TextureHandle {
+		return m_runtime->createTexture(textureData);
+	}
+
+	void Application::destroyTexture(const TextureHandle &texture) { m_runtime->destroyTexture(texture); }
+
+	auto Application::createMaterial(const MaterialDetails &details) -> MaterialHandle {
+		return m_runtime->createMaterial(details);
+	}
+
+	auto Application::submitDraw(const DrawPacket &packet) -> bool { return m_runtime->submitDraw(packet); }
+
+	void Application::setFrameCallback(FrameCallback frameCallback) {
+		m_runtime->setFrameCallback(std::move(frameCallback));
+	}
+
+	auto Application::getThroughputReport() const -> FrameThroughputReport { return m_runtime->getThroughputReport(); }
+
+	auto Application::getFrameTimingReport() const -> FrameTimingReport { return m_runtime->getFrameTimingReport(); }
+
+	auto Application::getStartupReport() const -> StartupReport { return m_runtime->getStartupReport(); }
+
 }  // namespace venus
@@ -2,6 +2,9 @@
 #define VENUS_APPLICATION_HPP
 
 // PROJECT
+#include "drawPacket.hpp"
+#include "frameState.hpp"
+#include "frameStatistics.hpp"
 #include "venusConfigOptions.hpp"
 
 // STDLIB
@@ -20,6 +23,11 @@ namespace venus {
    *          To properly start a program using Venus, you must populate the required config struct data-fields,
    *          and then call the function 'run()'.
    *
+   *          Meshes and materials may be created before or during 'run()'. Each frame the callback set with
+   *          'setFrameCallback()' runs on the main thread, draws submitted from it are drawn in that frame. 'submitDraw()'
+   *          may also be called from any other thread, lock free, the draw then lands in whichever frame is being
+   *          gathered. Draws are not retained, a mesh that should stay visible is submitted every frame.
+   *
    */
 	class Application {
 	public:
@@ -34,6 +42,35 @@ namespace venus {
 
 		void run();
 
+		// Any thread. The mesh data is copied, throws when the mesh buffers or handles are exhausted.
+		[[nodiscard]] auto createMesh(const MeshData &meshData) -> MeshHandle;
+		// Any thread. The mesh stops being drawn right away, its handle may be reused afterwards.
+		void destroyMesh(const MeshHandle &mesh);
+
+		// Any thread. The texels are copied, throws when they do not fit the staging ring or the handles are exhausted.
+		[[nodiscard]] auto createTexture(const TextureData &textureData) -> TextureHandle;
+		// Any thread. Materials using the texture stop being drawn right away, its handle may be reused afterwards.
+		void destroyTexture(const TextureHandle &texture);
+
+		// Any thread. Throws once MAX_MATERIALS exist.
+		[[nodiscard]] auto createMaterial(const MaterialDetails &details) -> MaterialHandle;
+
+		// Any thread, lock free. False when the frame's draw list is full and the packet was dropped.
+		auto submitDraw(const DrawPacket &packet) -> bool;
+
+		// Must be set before 'run()'.
+		void setFrameCallback(FrameCallback frameCallback);
+
+		// Frame throughput of the last call to 'run()', this is how headless benchmarks report their results.
+		[[nodiscard]] auto getThroughputReport() const -> FrameThroughputReport;
+
+		// Min/avg/p95/p99 cpu phase and gpu pass timings over the most recent frames, safe to call while 'run()' draws.
+		[[nodiscard]] auto getFrameTimingReport() const -> FrameTimingReport;
+
+		// Renderer creation cost measured while constructing the application, including pipeline cache hits.
+		// Blocks until pipelines still compiling in the background are built.
+		[[nodiscard]] auto getStartupReport() const -> StartupReport;
+
 	private:
 		ApplicationConfigDetails m_details;
 		std::unique_ptr<Runtime> m_runtime;
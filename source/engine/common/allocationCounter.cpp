@@ -0,0 +1,72 @@
+#include "allocationCounter.hpp"
+
+// STDLIB
+#include <cstdlib>
+#include <new>
+
+namespace venus::memory {
+#if defined(VENUS_TRACK_ALLOCATIONS)
+	namespace {  // ANONYMOUS NAMESPACE BEGIN
+		// trivially constructible so accessing it never requires a tls-initialization guard.
+		thread_local uint64_t THREAD_ALLOCATION_COUNT = 0;
+
+		auto countedAllocate(std::size_t size) -> void * {
+			++THREAD_ALLOCATION_COUNT;
+			return std::malloc(size == 0 ? 1 : size);  // NOLINT
+		}
+
+		auto countedAlignedAllocate(std::size_t size, std::align_val_t alignment) -> void * {
+			++THREAD_ALLOCATION_COUNT;
+			const auto ALIGN = static_cast<std::size_t>(alignment);
+			// aligned_alloc requires the size to be a multiple of the alignment.
+			const std::size_t ALIGNED_SIZE = ((size == 0 ? 1 : size) + ALIGN - 1) & ~(ALIGN - 1);
+			return std::aligned_alloc(ALIGN, ALIGNED_SIZE);  // NOLINT
+		}
+	}  // namespace
+	// ANONYMOUS NAMESPACE END
+
+	auto threadAllocationCount() noexcept -> uint64_t { return THREAD_ALLOCATION_COUNT; }
+#else
+	auto threadAllocationCount() noexcept -> uint64_t { return 0; }
+#endif
+}  // namespace venus::memory
+
+#if defined(VENUS_TRACK_ALLOCATIONS)
+// The standard library routes the array and nothrow forms of operator new/delete through these,
+// so replacing them is enough to count every c++ heap allocation in the process.
+// NOLINTBEGIN
+void *operator new(std::size_t size) {
+	void *memory = venus::memory::countedAllocate(size);
+	if(memory == nullptr) {
+		throw std::bad_alloc();
+	}
+	return memory;
+}
+
+void *operator new(std::size_t size, std::align_val_t alignment) {
+	void *memory = venus::memory::countedAlignedAllocate(size, alignment);
+	if(memory == nullptr) {
+		throw std::bad_alloc();
+	}
+	return memory;
+}
+
+void operator delete(void *memory) noexcept { std::free(memory); }
+
+void operator delete(void *memory, std::size_t size) noexcept {
+	(void) size;
+	std::free(memory);
+}
+
+void operator delete(void *memory, std::align_val_t alignment) noexcept {
+	(void) alignment;
+	std::free(memory);
+}
+
+void operator delete(void *memory, std::size_t size, std::align_val_t alignment) noexcept {
+	(void) size;
+	(void) alignment;
+	std::free(memory);
+}
+// NOLINTEND
+#endif
@@ -0,0 +1,31 @@
+#ifndef VENUS_ALLOCATION_COUNTER_HPP
+#define VENUS_ALLOCATION_COUNTER_HPP
+
+// STDLIB
+#include <cstdint>
+
+namespace venus::memory {
+
+#if defined(VENUS_TRACK_ALLOCATIONS)
+	static constexpr bool ALLOCATION_TRACKING_ENABLED = true;
+#else
+	static constexpr bool ALLOCATION_TRACKING_ENABLED = false;
+#endif
+
+	/**
+   * @brief Reports how many heap allocations the calling thread has made.
+   *
+   * @details When venus is configured with the TRACK_ALLOCATIONS cmake option the global operator new is replaced
+   *          with a counting version, sampling this value before and after a block of code tells you exactly how many
+   *          allocations that block made on the current thread. The counter is thread-local so background threads,
+   *          such as the logger backend, do not pollute the measurement.
+   *
+   *          When allocation tracking is disabled this function always returns zero.
+   *
+   * @return uint64_t
+   */
+	[[nodiscard]] auto threadAllocationCount() noexcept -> uint64_t;
+
+}  // namespace venus::memory
+
+#endif  // VENUS_ALLOCATION_COUNTER_HPP
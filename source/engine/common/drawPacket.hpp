@@ -0,0 +1,79 @@
+#ifndef VENUS_DRAW_PACKET_HPP
+#define VENUS_DRAW_PACKET_HPP
+
+// STDLIB
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace venus {
+
+	// The vertex format every mesh is stored in, interleaved in one shared vertex buffer.
+	struct MeshVertex {
+		std::array<float, 3> position;
+		std::array<float, 3> normal;
+		std::array<float, 2> uv;
+	};
+
+	// Triangle list geometry, copied when the mesh is created so the caller may free it right away.
+	struct MeshData {
+		std::span<const MeshVertex> vertices;
+		std::span<const uint32_t> indices;
+	};
+
+	struct MeshHandle {
+		uint32_t index = UINT32_MAX;
+
+		[[nodiscard]] auto isValid() const -> bool { return index != UINT32_MAX; }
+	};
+
+	// Tightly packed 8-bit sRGB RGBA texels, row by row. Copied when the texture is created so the caller may free them
+	// right away.
+	struct TextureData {
+		uint32_t width;
+		uint32_t height;
+		std::span<const std::byte> texels;
+	};
+
+	struct TextureHandle {
+		uint32_t index = UINT32_MAX;
+
+		[[nodiscard]] auto isValid() const -> bool { return index != UINT32_MAX; }
+	};
+
+	/**
+   * @brief How the meshes drawn with a material are shaded.
+   *
+   * @details Shader names are file names in source/shaders, null names select the built-in mesh shaders. Custom shaders
+   *          must accept MeshVertex at locations 0 to 2 and the draw's push constants, see shaders/mesh.vert.
+   *          The base color texture multiplies the base color, draws wait until it has been uploaded.
+   */
+	struct MaterialDetails {
+		const char *vertexShader;
+		const char *fragmentShader;
+		std::array<float, 4> baseColor;
+		TextureHandle baseColorTexture{};  // none by default.
+	};
+
+	// The default handle is the built-in material, plain white with the built-in mesh shaders.
+	struct MaterialHandle {
+		uint32_t index = 0;
+	};
+
+	/**
+   * @brief One mesh drawn once with one material.
+   *
+   * @details 'transform' is a column major matrix taking mesh positions straight to clip space.
+   *          A packet naming a mesh whose data is still being uploaded, or a material whose pipeline is still compiling,
+   *          is skipped for that frame. Packets whose mesh lies entirely outside clip space are culled on the gpu.
+   */
+	struct DrawPacket {
+		MeshHandle mesh;
+		MaterialHandle material;
+		std::array<float, 16> transform;
+	};
+
+}  // namespace venus
+
+#endif  // VENUS_DRAW_PACKET_HPP
@@ -0,0 +1,29 @@
+#ifndef VENUS_FRAME_STATE_HPP
+#define VENUS_FRAME_STATE_HPP
+
+// STDLIB
+#include <cstdint>
+#include <functional>
+
+namespace venus {
+
+	/**
+   * @brief Snapshot of everything the renderer needs to draw one frame.
+   *
+   * @details Produced by the main thread once per frame and handed to the renderer by value, when the renderer runs on
+   *          its own thread the snapshot travels through a triple buffer so the two threads never share mutable state.
+   */
+	struct FrameState {
+		uint64_t frameNumber;
+		double simulationSeconds;  // time since the runtime loop started when this state was produced.
+		float deltaSeconds;        // time since the previous state was produced.
+		uint32_t drawList;         // the draw packet list sealed for this frame, see DrawPacketQueue.
+	};
+
+	// Called on the main thread once per frame before its state is handed to the renderer, draws submitted from it are
+	// drawn in that frame. 'drawList' is not sealed yet when the callback runs.
+	using FrameCallback = std::function<void(const FrameState &frameState)>;
+
+}  // namespace venus
+
+#endif  // VENUS_FRAME_STATE_HPP
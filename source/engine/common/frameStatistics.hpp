@@ -0,0 +1,100 @@
+#ifndef VENUS_FRAME_STATISTICS_HPP
+#define VENUS_FRAME_STATISTICS_HPP
+
+// STDLIB
+#include <array>
+#include <cstdint>
+
+namespace venus {
+
+	/**
+   * @brief Throughput of a finished runtime loop.
+   *
+   * @details Populated by the runtime once its loop exits, it is mainly useful for headless runs
+   *          where a fixed number of frames is rendered and the cost per frame is what we want to gate on.
+   */
+	struct FrameThroughputReport {
+		uint64_t frameCount;
+		double elapsedSeconds;
+		double framesPerSecond;
+		double averageFrameMilliseconds;
+	};
+
+	/**
+   * @brief Cost of bringing up the renderer.
+   *
+   * @details Pipeline creation is the part of startup a warm pipeline cache speeds up, cache hits and misses are as
+   *          reported by the driver through pipeline creation feedback. Pipelines whose driver did not report either are
+   *          counted in neither.
+   *
+   *          Pipelines compile on background threads after the renderer is created, so renderer creation does not
+   *          include them. Their creation time is summed over the compiler threads.
+   */
+	struct StartupReport {
+		double rendererCreationMilliseconds;
+		double pipelineCreationMilliseconds;
+		uint32_t pipelineCacheHits;
+		uint32_t pipelineCacheMisses;
+		bool pipelineCacheLoaded;
+	};
+
+	// Maximum number of gpu passes the frame profiler can time with timestamp queries.
+	static constexpr uint32_t MAX_PROFILED_GPU_PASSES = 8;
+
+	/**
+   * @brief CPU phases of a single frame, in the order the renderer executes them.
+   */
+	enum FrameCpuPhase : uint8_t {
+		FRAME_PHASE_PRESENT_WAIT = 0,
+		FRAME_PHASE_FENCE_WAIT,
+		FRAME_PHASE_HOUSEKEEPING,  // retiring resources, shader reloads and registry updates before acquiring.
+		FRAME_PHASE_ACQUIRE,
+		FRAME_PHASE_RECORD,
+		FRAME_PHASE_SUBMIT,
+		FRAME_PHASE_PRESENT,
+		FRAME_PHASE_COUNT
+	};
+
+	/**
+   * @brief What limited a frame.
+   *
+   * @details A frame is a fence stall when most of its cpu time was spent waiting on the gpu to release a frame in flight.
+   *          Otherwise it is gpu bound when its gpu pass time exceeds the cpu time spent doing actual work, and cpu bound if not.
+   *          Time spent in present-wait pacing is deliberate idling and is never counted as work.
+   */
+	enum FrameBottleneck : uint8_t {
+		FRAME_BOTTLENECK_CPU = 0,
+		FRAME_BOTTLENECK_GPU,
+		FRAME_BOTTLENECK_FENCE_STALL,
+		FRAME_BOTTLENECK_COUNT
+	};
+
+	struct FrameTimingStatistics {
+		double minMilliseconds;
+		double averageMilliseconds;
+		double p95Milliseconds;
+		double p99Milliseconds;
+		uint32_t sampleCount;
+	};
+
+	/**
+   * @brief Timing statistics over the frame profiler history.
+   *
+   * @details Only the first 'gpuPassCount' entries of 'gpuPasses' are populated, in the order the passes were registered.
+   *          GPU timings arrive a few frames late since they can only be read once the gpu has finished the frame.
+   *
+   *          Present intervals are measured between frames reaching the display when present-wait is available,
+   *          otherwise between successive present calls.
+   */
+	struct FrameTimingReport {
+		FrameTimingStatistics cpuFrame;
+		FrameTimingStatistics presentInterval;
+		std::array<FrameTimingStatistics, FRAME_PHASE_COUNT> cpuPhases;
+		std::array<FrameTimingStatistics, MAX_PROFILED_GPU_PASSES> gpuPasses;
+		uint32_t gpuPassCount;
+		std::array<uint32_t, FRAME_BOTTLENECK_COUNT> bottleneckCounts;
+	};
+
+}  // namespace venus
+
+#endif  // VENUS_FRAME_STATISTICS_HPP
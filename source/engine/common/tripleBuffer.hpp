@@ -0,0 +1,78 @@
+#ifndef VENUS_TRIPLE_BUFFER_HPP
+#define VENUS_TRIPLE_BUFFER_HPP
+
+// STDLIB
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace venus {
+
+	/**
+   * @brief A lock-free single producer, single consumer triple buffer.
+   *
+   * @details The producer fills 'writeBuffer()' and publishes it, the consumer takes the most recently published buffer
+   *          with 'consume()' and reads it through 'readBuffer()'. Neither side ever waits on the other, a producer that
+   *          runs ahead simply replaces the unconsumed buffer so the consumer always sees the newest complete state.
+   *
+   *          The three buffers rotate between a back buffer owned by the producer, a front buffer owned by the consumer
+   *          and a middle buffer handed over with a single atomic exchange, its dirty bit marks unconsumed data.
+   *
+   *          This object cannot be copied. This object cannot be moved.
+   */
+	template<typename T>
+	class TripleBuffer {
+	public:
+		TripleBuffer() = default;
+		~TripleBuffer() = default;
+
+		TripleBuffer(const TripleBuffer &) = delete;
+		auto operator=(const TripleBuffer &) -> TripleBuffer & = delete;
+
+		TripleBuffer(const TripleBuffer &&) = delete;
+		auto operator=(const TripleBuffer &&) -> TripleBuffer & = delete;
+
+		// Producer only.
+		[[nodiscard]] auto writeBuffer() -> T & { return m_buffers[m_backIndex]; }
+
+		// Producer only, hands the write buffer to the consumer and starts writing into a free one.
+		void publish() {
+			const uint8_t previous = m_middle.exchange(m_backIndex | DIRTY_BIT, std::memory_order_acq_rel);
+			m_backIndex = previous & INDEX_MASK;
+		}
+
+		// Consumer only, returns false when nothing was published since the last call and the read buffer is unchanged.
+		auto consume() -> bool {
+			if((m_middle.load(std::memory_order_relaxed) & DIRTY_BIT) == 0) {
+				return false;
+			}
+			const uint8_t previous = m_middle.exchange(m_frontIndex, std::memory_order_acq_rel);
+			m_frontIndex = previous & INDEX_MASK;
+			return true;
+		}
+
+		// Consumer only.
+		[[nodiscard]] auto readBuffer() const -> const T & { return m_buffers[m_frontIndex]; }
+
+		// Either side, true while a published buffer has not been consumed yet.
+		[[nodiscard]] auto hasUnconsumed() const -> bool {
+			return (m_middle.load(std::memory_order_acquire) & DIRTY_BIT) != 0;
+		}
+
+	private:
+		static constexpr uint8_t DIRTY_BIT = 0x4;
+		static constexpr uint8_t INDEX_MASK = 0x3;
+		static constexpr size_t CACHE_LINE_SIZE = 64;
+
+		std::array<T, 3> m_buffers{};
+
+		// each index is owned by one side, keeping them on separate cache lines avoids false sharing.
+		alignas(CACHE_LINE_SIZE) uint8_t m_backIndex = 0;
+		alignas(CACHE_LINE_SIZE) std::atomic<uint8_t> m_middle = 1;
+		alignas(CACHE_LINE_SIZE) uint8_t m_frontIndex = 2;
+	};
+
+}  // namespace venus
+
+#endif  // VENUS_TRIPLE_BUFFER_HPP
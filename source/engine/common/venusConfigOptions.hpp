@@ -94,6 +94,27 @@ namespace venus {
 		WINDOW_MODE_BORDERLESS_FLAG_BIT = 1 << 2
 	};
 
+	/**
+   * @brief Presentation pacing policy bit-flags.
+   *
+   * @details Selects how frames are presented and paced against the display.
+   *
+   *          Low latency prefers mailbox presentation and, where VK_KHR_present_wait is available, waits for the previous frame
+   *          to reach the display before starting the next one, this keeps input-to-photon latency as low as possible.
+   *
+   *          Max throughput prefers immediate then mailbox presentation and never paces the cpu, frames may tear.
+   *
+   *          V-sync always uses fifo presentation and, where VK_KHR_present_wait is available, allows at most two frames
+   *          to queue for the display.
+   *
+   *          Leaving this unset (zero) selects low latency.
+   */
+	enum PresentPolicyFlags : uint8_t {
+		PRESENT_POLICY_LOW_LATENCY_FLAG_BIT = 1 << 0,
+		PRESENT_POLICY_MAX_THROUGHPUT_FLAG_BIT = 1 << 1,
+		PRESENT_POLICY_VSYNC_FLAG_BIT = 1 << 2
+	};
+
 	struct ApplicationVersion {
 		unsigned int major;
 		unsigned int minor;
@@ -105,6 +126,7 @@ namespace venus {
 		VNS_RESOLUTION_BIT ResolutionBit;
 		AspectRatio AspectRatioFlag;
 		WindowModeFlags WindowModeFlag;
+		PresentPolicyFlags PresentPolicyFlag;
 	};
 
 	struct ApplicationIdentityDetails {
@@ -112,12 +134,72 @@ namespace venus {
 		ApplicationVersion version;
 	};
 
+	// Frame count used by headless runs that leave 'HeadlessConfigDetails::frameCount' at zero.
+	static constexpr uint32_t DEFAULT_HEADLESS_FRAME_COUNT = 1000;
+
+	/**
+   * @brief Headless benchmarking configuration.
+   *
+   * @details When enabled Venus initializes glfw with its null platform, which creates windows without a display server
+   *          and backs their surfaces with VK_EXT_headless_surface. The full renderer loop runs exactly as it would on a desktop,
+   *          for 'frameCount' frames, after which the runtime stops and reports its frame throughput.
+   *
+   *          This is intended for display-less machines running a software driver such as lavapipe.
+   */
+	struct HeadlessConfigDetails {
+		bool enabled;
+		uint32_t frameCount;
+	};
+
+	/**
+   * @brief Render thread configuration.
+   *
+   * @details When enabled the renderer draws on a dedicated thread while the main thread keeps handling glfw events and
+   *          producing frame states, so a blocking present or fence wait no longer delays input.
+   *          When disabled both run in lockstep on the main thread.
+   */
+	struct RenderThreadConfigDetails {
+		bool enabled;
+	};
+
+	/**
+   * @brief Pipeline cache persistence.
+   *
+   * @details Compiled pipelines are loaded from 'filePath' at startup and written back to it on shutdown, so only the
+   *          first launch on a device, or the first after a driver update, pays the full pipeline compilation cost.
+   *          A relative path is resolved against the working directory, a null path keeps the cache in memory only.
+   */
+	struct PipelineCacheConfigDetails {
+		const char *filePath;
+	};
+
+	/**
+   * @brief Shader loading configuration.
+   *
+   * @details Shaders are compiled from source/shaders when Venus is built and embedded into the binary, so by default
+   *          no shader file is read at runtime and shaders can never drift from the code using them.
+   *          During development 'overrideDirectory' may name a directory of '<shader file name>.spv' binaries, such as
+   *          'mesh.vert.spv', which are loaded instead of their embedded copies. A null directory disables overrides.
+   *
+   *          Setting 'watchDirectory' as well enables hot reload, shader sources saved there are recompiled with glslc into
+   *          the override directory and every pipeline using them is rebuilt while the application keeps running.
+   *          Hot reload needs inotify and an override directory, a null watch directory disables it.
+   */
+	struct ShaderConfigDetails {
+		const char *overrideDirectory;
+		const char *watchDirectory;
+	};
+
 	/**
    * @brief Configures how exactly Venus should build your app.
    */
 	struct ApplicationConfigDetails {
 		ApplicationIdentityDetails identity;
 		WindowConfigDetails windowConfig;
+		HeadlessConfigDetails headlessConfig;
+		RenderThreadConfigDetails renderThreadConfig;
+		PipelineCacheConfigDetails pipelineCacheConfig;
+		ShaderConfigDetails shaderConfig;
 	};
 
 }  // namespace venus
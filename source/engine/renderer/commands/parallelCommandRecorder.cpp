@@ -0,0 +1,155 @@
+#include "parallelCommandRecorder.hpp"
+#include "VN_logger.hpp"
+#include "jobSystem.hpp"
+#include "logicalDevice.hpp"
+
+// STDLIB
+#include <algorithm>
+#include <cassert>
+#include <format>
+#include <stdexcept>
+
+namespace venus {
+	namespace {  // ANONYMOUS NAMESPACE BEGIN
+		auto sliceFor(const uint32_t &sliceIndex, const uint32_t &sliceCount, const uint32_t &drawCount) -> DrawSlice {
+			// the remainder is spread over the first slices so no two slices differ by more than one draw.
+			const uint32_t baseCount = drawCount / sliceCount;
+			const uint32_t remainder = drawCount % sliceCount;
+			return {.firstDraw = (sliceIndex * baseCount) + std::min(sliceIndex, remainder),
+							.drawCount = baseCount + (sliceIndex < remainder ? 1 : 0)};
+		}
+	}  // namespace
+	// ANONYMOUS NAMESPACE END
+
+	ParallelCommandRecorder::ParallelCommandRecorder(const std::shared_ptr<LogicalDevice> &logicalDevicePtr,
+																									 const std::shared_ptr<JobSystem> &jobSystemPtr):
+		m_logicalDevice(logicalDevicePtr), m_jobSystem(jobSystemPtr) {
+		// more slices than threads would only add pools and secondary buffers to execute without adding parallelism.
+		const uint32_t maxSliceCount = std::clamp(m_jobSystem->getThreadCount(), 1U, MAX_RECORD_SLICES);
+
+		m_slicePools.resize(maxSliceCount);
+		m_recordedBuffers.resize(maxSliceCount, VK_NULL_HANDLE);
+		createSlicePools();
+
+		VN_LOG_INFO(std::format("Parallel command recorder created with up to {} slices.", maxSliceCount));
+	}
+
+	ParallelCommandRecorder::~ParallelCommandRecorder() { destroySlicePools(); }
+
+	auto ParallelCommandRecorder::record(const uint32_t &frameIndex, const VkCommandBufferInheritanceInfo &inheritanceInfo,
+																			 const uint32_t &drawCount, const uint32_t &minDrawsPerSlice,
+																			 RecordSliceFunc recordFunc, void *userData) -> std::span<const VkCommandBuffer> {
+		assert(frameIndex < MAX_FRAMES_IN_FLIGHT);
+		assert(recordFunc != nullptr);
+		if(drawCount == 0) {
+			return {};
+		}
+
+		const uint32_t wantedSlices = std::max(drawCount / std::max(minDrawsPerSlice, 1U), 1U);
+		const uint32_t sliceCount = std::min(wantedSlices, getMaxSliceCount());
+
+		m_job = {.frameIndex = frameIndex,
+						 .inheritanceInfo = &inheritanceInfo,
+						 .drawCount = drawCount,
+						 .sliceCount = sliceCount,
+						 .recordFunc = recordFunc,
+						 .userData = userData};
+		m_recordFailed.store(false, std::memory_order_relaxed);
+
+		JobCounter slicesRecorded;
+		for(uint32_t sliceIndex = 1; sliceIndex < sliceCount; ++sliceIndex) {
+			m_jobSystem->schedule([this, sliceIndex]() { recordSliceNoThrow(sliceIndex); }, &slicesRecorded);
+		}
+
+		recordSliceNoThrow(0);
+		m_jobSystem->wait(slicesRecorded);
+
+		if(m_recordFailed.load(std::memory_order_relaxed)) {
+			VN_LOG_CRITICAL("Failed to record secondary command buffers.");
+			throw std::runtime_error("Failed to record secondary command buffers.");
+		}
+
+		return {m_recordedBuffers.data(), sliceCount};
+	}
+
+	void ParallelCommandRecorder::recordSliceNoThrow(const uint32_t &sliceIndex) noexcept {
+		// jobs must not throw, the failure is reported by 'record()' once every slice has finished.
+		try {
+			recordSlice(sliceIndex);
+		} catch(const std::exception &error) {
+			VN_LOG_ERROR(std::format("Recording slice {} failed: {}", sliceIndex, error.what()));
+			m_recordFailed.store(true, std::memory_order_relaxed);
+		}
+	}
+
+	void ParallelCommandRecorder::recordSlice(const uint32_t &sliceIndex) {
+		const SlicePool &slicePool = m_slicePools[sliceIndex][m_job.frameIndex];
+
+		if(vkResetCommandPool(m_logicalDevice->getHandle(), slicePool.pool, 0) != VK_SUCCESS) {
+			throw std::runtime_error("Failed to reset slice command pool.");
+		}
+
+		const VkCommandBufferBeginInfo beginInfo{
+			.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+			.pNext = nullptr,
+			.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT | VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT,
+			.pInheritanceInfo = m_job.inheritanceInfo};
+
+		if(vkBeginCommandBuffer(slicePool.commandBuffer, &beginInfo) != VK_SUCCESS) {
+			throw std::runtime_error("Failed to begin recording secondary command buffer.");
+		}
+
+		m_job.recordFunc(slicePool.commandBuffer, sliceFor(sliceIndex, m_job.sliceCount, m_job.drawCount),
+										 m_job.userData);
+
+		if(vkEndCommandBuffer(slicePool.commandBuffer) != VK_SUCCESS) {
+			throw std::runtime_error("Failed to record secondary command buffer.");
+		}
+
+		m_recordedBuffers[sliceIndex] = slicePool.commandBuffer;
+	}
+
+	void ParallelCommandRecorder::createSlicePools() {
+		const auto indices = m_logicalDevice->queueFamilyIndices();
+		assert(indices.graphicsFamilyIndex.has_value());
+
+		const VkCommandPoolCreateInfo poolInfo{.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO,
+																					 .pNext = nullptr,
+																					 .flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT,
+																					 .queueFamilyIndex = indices.graphicsFamilyIndex.value()};  // NOLINT
+
+		for(auto &framePools : m_slicePools) {
+			for(auto &slicePool : framePools) {
+				if(vkCreateCommandPool(m_logicalDevice->getHandle(), &poolInfo, nullptr, &slicePool.pool) != VK_SUCCESS) {
+					VN_LOG_CRITICAL("Failed to create slice command pool.");
+					throw std::runtime_error("Failed to create slice command pool.");
+				}
+
+				const VkCommandBufferAllocateInfo allocInfo{.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
+																										.pNext = nullptr,
+																										.commandPool = slicePool.pool,
+																										.level = VK_COMMAND_BUFFER_LEVEL_SECONDARY,
+																										.commandBufferCount = 1};
+
+				if(vkAllocateCommandBuffers(m_logicalDevice->getHandle(), &allocInfo, &slicePool.commandBuffer) !=
+					 VK_SUCCESS) {
+					VN_LOG_CRITICAL("Failed to allocate secondary command buffer.");
+					throw std::runtime_error("Failed to allocate secondary command buffer.");
+				}
+			}
+		}
+	}
+
+	void ParallelCommandRecorder::destroySlicePools() {
+		// destroying a pool frees every command buffer allocated from it.
+		for(auto &framePools : m_slicePools) {
+			for(auto &slicePool : framePools) {
+				if(slicePool.pool != VK_NULL_HANDLE) {
+					vkDestroyCommandPool(m_logicalDevice->getHandle(), slicePool.pool, nullptr);
+					slicePool = {};
+				}
+			}
+		}
+	}
+
+}  // namespace venus
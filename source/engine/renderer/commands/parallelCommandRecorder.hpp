@@ -0,0 +1,99 @@
+#ifndef VENUS_PARALLEL_COMMAND_RECORDER_HPP
+#define VENUS_PARALLEL_COMMAND_RECORDER_HPP
+
+// PROJECT
+#include "renderConfig.hpp"
+
+// THIRD PARTY
+#include "volk.h"
+
+// STDLIB
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace venus {
+	class LogicalDevice;
+	class JobSystem;
+
+	// A contiguous range of the draw list recorded into one secondary command buffer.
+	struct DrawSlice {
+		uint32_t firstDraw;
+		uint32_t drawCount;
+	};
+
+	// Called once per slice on the recording thread, 'commandBuffer' is already begun and is ended afterwards.
+	// Secondary command buffers inherit nothing but the attachment formats, so dynamic state must be set in every slice.
+	using RecordSliceFunc = void (*)(VkCommandBuffer commandBuffer, const DrawSlice &slice, void *userData);
+
+	/**
+   * @brief Records secondary command buffers for disjoint slices of a draw list on the job system.
+   *
+   * @details Every slice owns one transient command pool per frame in flight with a single secondary command buffer,
+   *          a pool is only touched by the one job recording its slice so no locking is needed whichever thread runs it.
+   *          At the start of a record each slice resets its pool for that frame wholesale instead of resetting buffers.
+   *
+   *          The calling thread records the first slice itself and helps with the others while it waits, 'record()'
+   *          returns once every slice is finished with the buffers in draw order, ready for vkCmdExecuteCommands.
+   *          Small draw lists are split into fewer slices so each job has enough work to be worth scheduling, how many
+   *          draws that takes is up to the caller since what a draw records varies.
+   *
+   *          Scheduling jobs does not allocate, nothing in the per-frame path allocates.
+   *
+   *          This object cannot be copied. This object cannot be moved.
+   */
+	class ParallelCommandRecorder {
+	public:
+		explicit ParallelCommandRecorder(const std::shared_ptr<LogicalDevice> &logicalDevicePtr,
+																		 const std::shared_ptr<JobSystem> &jobSystemPtr);
+		~ParallelCommandRecorder();
+
+		ParallelCommandRecorder(const ParallelCommandRecorder &) = delete;
+		auto operator=(const ParallelCommandRecorder &) -> ParallelCommandRecorder & = delete;
+
+		ParallelCommandRecorder(const ParallelCommandRecorder &&) = delete;
+		auto operator=(const ParallelCommandRecorder &&) -> ParallelCommandRecorder & = delete;
+
+		// Must only be called once the last submission from 'frameIndex' has completed, the frame's pools are reset.
+		// Must be called from a job system thread. Every slice but a lone one gets at least 'minDrawsPerSlice' draws.
+		[[nodiscard]] auto record(const uint32_t &frameIndex, const VkCommandBufferInheritanceInfo &inheritanceInfo,
+															const uint32_t &drawCount, const uint32_t &minDrawsPerSlice, RecordSliceFunc recordFunc,
+															void *userData) -> std::span<const VkCommandBuffer>;
+
+		[[nodiscard]] auto getMaxSliceCount() const -> uint32_t { return static_cast<uint32_t>(m_slicePools.size()); }
+
+	private:
+		std::shared_ptr<LogicalDevice> m_logicalDevice;
+		std::shared_ptr<JobSystem> m_jobSystem;
+
+		struct SlicePool {
+			VkCommandPool pool = VK_NULL_HANDLE;
+			VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+		};
+		std::vector<std::array<SlicePool, MAX_FRAMES_IN_FLIGHT>> m_slicePools;
+		std::vector<VkCommandBuffer> m_recordedBuffers;
+		void createSlicePools();
+		void destroySlicePools();
+
+		// written before the slice jobs are scheduled and only read by them afterwards.
+		struct RecordJob {
+			uint32_t frameIndex;
+			const VkCommandBufferInheritanceInfo *inheritanceInfo;
+			uint32_t drawCount;
+			uint32_t sliceCount;
+			RecordSliceFunc recordFunc;
+			void *userData;
+		};
+		RecordJob m_job{};
+		std::atomic<bool> m_recordFailed = false;
+
+		void recordSliceNoThrow(const uint32_t &sliceIndex) noexcept;
+		void recordSlice(const uint32_t &sliceIndex);
+	};
+
+}  // namespace venus
+
+#endif  // VENUS_PARALLEL_COMMAND_RECORDER_HPP
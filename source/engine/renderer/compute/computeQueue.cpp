@@ -0,0 +1,139 @@
+#include "computeQueue.hpp"
+#include "VN_logger.hpp"
+#include "logicalDevice.hpp"
+#include "timelineSemaphore.hpp"
+
+// STDLIB
+#include <format>
+#include <stdexcept>
+
+namespace venus {
+	namespace {  // ANONYMOUS NAMESPACE BEGIN
+		// compute results feed indirect draws and the shaders of the main pass, everything before them may overlap.
+		constexpr VkPipelineStageFlags2 COMPUTE_CONSUMER_STAGES =
+			VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_2_VERTEX_ATTRIBUTE_INPUT_BIT |
+			VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT;
+	}  // namespace
+	// ANONYMOUS NAMESPACE END
+
+	ComputeQueue::ComputeQueue(const std::shared_ptr<LogicalDevice> &logicalDevicePtr):
+		m_logicalDevice(logicalDevicePtr), m_async(logicalDevicePtr->hasAsyncCompute()) {
+		const uint32_t graphicsFamily = m_logicalDevice->queueFamilyIndices().graphicsFamilyIndex.value();  // NOLINT
+		const uint32_t computeFamily = m_logicalDevice->getComputeFamilyIndex();
+		m_sharingFamilies = {graphicsFamily, computeFamily};
+		m_sharingFamilyCount = m_async && graphicsFamily != computeFamily ? 2 : 1;
+
+		if(m_async) {
+			m_computeTimeline = std::make_unique<TimelineSemaphore>(m_logicalDevice->getHandle());
+			createCommandBuffers();
+		}
+
+		VN_LOG_INFO(m_async ? std::format("Compute work runs async on queue family {}.", computeFamily) :
+													"Compute work is recorded into the graphics command buffer.");
+	}
+
+	ComputeQueue::~ComputeQueue() {
+		if(m_async) {
+			m_computeTimeline->wait(m_computeTimeline->lastSubmittedValue());
+			for(VkCommandPool commandPool : m_commandPools) {
+				vkDestroyCommandPool(m_logicalDevice->getHandle(), commandPool, nullptr);
+			}
+			m_computeTimeline.reset();
+		}
+
+		VN_LOG_INFO("Compute queue has been destroyed.");
+	}
+
+	auto ComputeQueue::begin(const uint32_t &frameIndex, VkCommandBuffer graphicsCommandBuffer) -> VkCommandBuffer {
+		if(!m_async) {
+			return graphicsCommandBuffer;
+		}
+
+		if(vkResetCommandPool(m_logicalDevice->getHandle(), m_commandPools[frameIndex], 0) != VK_SUCCESS) {
+			VN_LOG_CRITICAL("Failed to reset compute pool.");
+			throw std::runtime_error("Failed to reset compute pool.");
+		}
+
+		const VkCommandBufferBeginInfo beginInfo{.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+																						 .pNext = nullptr,
+																						 .flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT,
+																						 .pInheritanceInfo = nullptr};
+		if(vkBeginCommandBuffer(m_commandBuffers[frameIndex], &beginInfo) != VK_SUCCESS) {
+			VN_LOG_CRITICAL("Failed to begin recording compute buffer.");
+			throw std::runtime_error("Failed to begin recording compute buffer.");
+		}
+		return m_commandBuffers[frameIndex];
+	}
+
+	auto ComputeQueue::submit(const uint32_t &frameIndex, const std::optional<VkSemaphoreSubmitInfo> &uploadWait)
+		-> std::optional<VkSemaphoreSubmitInfo> {
+		if(!m_async) {
+			return std::nullopt;
+		}
+
+		const VkCommandBuffer commandBuffer = m_commandBuffers[frameIndex];
+		if(vkEndCommandBuffer(commandBuffer) != VK_SUCCESS) {
+			VN_LOG_CRITICAL("Failed to record compute buffer.");
+			throw std::runtime_error("Failed to record compute buffer.");
+		}
+
+		const uint64_t computeValue = m_computeTimeline->peekNextValue();
+		const VkSemaphoreSubmitInfo signalInfo{.sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO,
+																					 .pNext = nullptr,
+																					 .semaphore = m_computeTimeline->getHandle(),
+																					 .value = computeValue,
+																					 .stageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT,
+																					 .deviceIndex = 0};
+		const VkCommandBufferSubmitInfo commandBufferInfo{.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO,
+																											.pNext = nullptr,
+																											.commandBuffer = commandBuffer,
+																											.deviceMask = 0};
+		const VkSubmitInfo2 submitInfo{.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO_2,
+																	 .pNext = nullptr,
+																	 .flags = 0,
+																	 .waitSemaphoreInfoCount = uploadWait.has_value() ? 1U : 0U,
+																	 .pWaitSemaphoreInfos = uploadWait.has_value() ? &uploadWait.value() : nullptr,
+																	 .commandBufferInfoCount = 1,
+																	 .pCommandBufferInfos = &commandBufferInfo,
+																	 .signalSemaphoreInfoCount = 1,
+																	 .pSignalSemaphoreInfos = &signalInfo};
+
+		if(vkQueueSubmit2(m_logicalDevice->getComputeQueue(), 1, &submitInfo, VK_NULL_HANDLE) != VK_SUCCESS) {
+			VN_LOG_CRITICAL("Failed to submit compute queue.");
+			throw std::runtime_error("Failed to submit compute queue.");
+		}
+		m_computeTimeline->commitSubmittedValue(computeValue);
+
+		return VkSemaphoreSubmitInfo{.sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO,
+																 .pNext = nullptr,
+																 .semaphore = m_computeTimeline->getHandle(),
+																 .value = computeValue,
+																 .stageMask = COMPUTE_CONSUMER_STAGES,
+																 .deviceIndex = 0};
+	}
+
+	void ComputeQueue::createCommandBuffers() {
+		const VkCommandPoolCreateInfo poolInfo{.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO,
+																					 .pNext = nullptr,
+																					 .flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT,
+																					 .queueFamilyIndex = m_logicalDevice->getComputeFamilyIndex()};
+
+		for(uint32_t frame = 0; frame < MAX_FRAMES_IN_FLIGHT; ++frame) {
+			if(vkCreateCommandPool(m_logicalDevice->getHandle(), &poolInfo, nullptr, &m_commandPools[frame]) != VK_SUCCESS) {
+				VN_LOG_CRITICAL("Failed to create compute pool.");
+				throw std::runtime_error("Failed to create compute pool.");
+			}
+
+			const VkCommandBufferAllocateInfo allocInfo{.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
+																									.pNext = nullptr,
+																									.commandPool = m_commandPools[frame],
+																									.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY,
+																									.commandBufferCount = 1};
+			if(vkAllocateCommandBuffers(m_logicalDevice->getHandle(), &allocInfo, &m_commandBuffers[frame]) != VK_SUCCESS) {
+				VN_LOG_CRITICAL("Failed to allocate compute command buffer.");
+				throw std::runtime_error("Failed to allocate compute command buffer.");
+			}
+		}
+	}
+
+}  // namespace venus
@@ -0,0 +1,83 @@
+#ifndef VENUS_COMPUTE_QUEUE_HPP
+#define VENUS_COMPUTE_QUEUE_HPP
+
+// PROJECT
+#include "renderConfig.hpp"
+
+// THIRD PARTY
+#include "volk.h"
+
+// STDLIB
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+
+namespace venus {
+	class LogicalDevice;
+	class TimelineSemaphore;
+
+	/**
+   * @brief Where a frame's compute work is recorded and submitted, the graphics queue or an async compute queue.
+   *
+   * @details With a compute queue of its own the frame's dispatches go into a command buffer of their own, submitted
+   *          before the graphics work and signaling the compute timeline. The graphics submission waits on that value
+   *          only at the stages reading compute results, so the dispatches overlap the end of the previous frame's
+   *          rendering. Without one, 'begin()' hands back the graphics command buffer and the work is recorded inline,
+   *          ordered by the barriers the passes record anyway.
+   *
+   *          Resources written on one queue and read on the other must be created with VK_SHARING_MODE_CONCURRENT over
+   *          'getSharingFamilies()' when it holds two families, so no ownership transfers are needed.
+   *
+   *          A frame's command buffer is reused once the graphics timeline reached that frame's value, the graphics
+   *          submission waited on its compute work so that has completed as well.
+   *
+   *          Render thread only. This object cannot be copied. This object cannot be moved.
+   */
+	class ComputeQueue {
+	public:
+		explicit ComputeQueue(const std::shared_ptr<LogicalDevice> &logicalDevicePtr);
+		~ComputeQueue();
+
+		ComputeQueue(const ComputeQueue &) = delete;
+		auto operator=(const ComputeQueue &) -> ComputeQueue & = delete;
+
+		ComputeQueue(const ComputeQueue &&) = delete;
+		auto operator=(const ComputeQueue &&) -> ComputeQueue & = delete;
+
+		[[nodiscard]] auto isAsync() const -> bool { return m_async; }
+
+		// The command buffer the frame's compute work is recorded into, 'graphicsCommandBuffer' when not async.
+		// The graphics command buffer must already be recording.
+		[[nodiscard]] auto begin(const uint32_t &frameIndex, VkCommandBuffer graphicsCommandBuffer) -> VkCommandBuffer;
+
+		/**
+     * @brief Submits the frame's compute work when async, before the graphics work of the frame is submitted.
+     *
+     * @details 'uploadWait' is the wait UploadQueue returned for this frame, compute work reading uploaded data waits
+     *          on it as well. Returns the wait the graphics submission must add, nothing when not async.
+     */
+		[[nodiscard]] auto submit(const uint32_t &frameIndex, const std::optional<VkSemaphoreSubmitInfo> &uploadWait)
+			-> std::optional<VkSemaphoreSubmitInfo>;
+
+		[[nodiscard]] auto getSharingFamilies() const -> std::span<const uint32_t> {
+			return {m_sharingFamilies.data(), m_sharingFamilyCount};
+		}
+
+	private:
+		std::shared_ptr<LogicalDevice> m_logicalDevice;
+		bool m_async = false;
+		std::unique_ptr<TimelineSemaphore> m_computeTimeline;
+		std::array<uint32_t, 2> m_sharingFamilies{};
+		uint32_t m_sharingFamilyCount = 1;
+
+		// only created when async.
+		std::array<VkCommandPool, MAX_FRAMES_IN_FLIGHT> m_commandPools{};
+		std::array<VkCommandBuffer, MAX_FRAMES_IN_FLIGHT> m_commandBuffers{};
+		void createCommandBuffers();
+	};
+
+}  // namespace venus
+
+#endif  // VENUS_COMPUTE_QUEUE_HPP
@@ -0,0 +1,247 @@
+#include "bindlessDescriptors.hpp"
+#include "VN_logger.hpp"
+#include "logicalDevice.hpp"
+#include "renderConfig.hpp"
+
+// STDLIB
+#include <array>
+#include <format>
+#include <stdexcept>
+
+namespace venus {
+	namespace {  // ANONYMOUS NAMESPACE BEGIN
+		// written while frames using the set are in flight, and left unwritten where nothing lives yet.
+		constexpr VkDescriptorBindingFlags BINDLESS_BINDING_FLAGS = VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT |
+																																VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT |
+																																VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT;
+
+		constexpr uint32_t BINDLESS_BINDING_COUNT = 3;
+	}  // namespace
+	// ANONYMOUS NAMESPACE END
+
+	BindlessDescriptors::BindlessDescriptors(const std::shared_ptr<LogicalDevice> &logicalDevicePtr):
+		m_logicalDevice(logicalDevicePtr),
+		m_freeSampledImages(createFreeList(MAX_BINDLESS_SAMPLED_IMAGES, "sampled images")),
+		m_freeSamplers(createFreeList(MAX_BINDLESS_SAMPLERS, "samplers")),
+		m_freeStorageBuffers(createFreeList(MAX_BINDLESS_STORAGE_BUFFERS, "storage buffers")) {
+		createSetLayout();
+		createSet();
+		createPipelineLayout();
+		createDefaultSampler();
+
+		// the first sampler added takes element 0.
+		static_cast<void>(addSampler(m_defaultSampler));
+
+		VN_LOG_INFO(std::format("Bindless descriptors created for {} images, {} samplers and {} storage buffers.",
+														MAX_BINDLESS_SAMPLED_IMAGES, MAX_BINDLESS_SAMPLERS, MAX_BINDLESS_STORAGE_BUFFERS));
+	}
+
+	BindlessDescriptors::~BindlessDescriptors() {
+		const VkDevice device = m_logicalDevice->getHandle();
+		vkDestroySampler(device, m_defaultSampler, nullptr);
+		vkDestroyPipelineLayout(device, m_pipelineLayout, nullptr);
+		// frees the set along with it.
+		vkDestroyDescriptorPool(device, m_descriptorPool, nullptr);
+		vkDestroyDescriptorSetLayout(device, m_setLayout, nullptr);
+
+		VN_LOG_INFO("Bindless descriptors have been destroyed.");
+	}
+
+	auto BindlessDescriptors::addSampledImage(VkImageView imageView) -> uint32_t {
+		const VkDescriptorImageInfo imageInfo{
+			.sampler = VK_NULL_HANDLE, .imageView = imageView, .imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL};
+
+		const std::scoped_lock lock(m_mutex);
+		const uint32_t index = takeIndex(m_freeSampledImages);
+		write(BINDLESS_BINDING_SAMPLED_IMAGES, index, VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, &imageInfo, nullptr);
+		return index;
+	}
+
+	auto BindlessDescriptors::addSampler(VkSampler sampler) -> uint32_t {
+		const VkDescriptorImageInfo imageInfo{
+			.sampler = sampler, .imageView = VK_NULL_HANDLE, .imageLayout = VK_IMAGE_LAYOUT_UNDEFINED};
+
+		const std::scoped_lock lock(m_mutex);
+		const uint32_t index = takeIndex(m_freeSamplers);
+		write(BINDLESS_BINDING_SAMPLERS, index, VK_DESCRIPTOR_TYPE_SAMPLER, &imageInfo, nullptr);
+		return index;
+	}
+
+	auto BindlessDescriptors::addStorageBuffer(VkBuffer buffer, const VkDeviceSize &offset, const VkDeviceSize &range)
+		-> uint32_t {
+		const VkDescriptorBufferInfo bufferInfo{.buffer = buffer, .offset = offset, .range = range};
+
+		const std::scoped_lock lock(m_mutex);
+		const uint32_t index = takeIndex(m_freeStorageBuffers);
+		write(BINDLESS_BINDING_STORAGE_BUFFERS, index, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, nullptr, &bufferInfo);
+		return index;
+	}
+
+	// removed elements keep their stale descriptor, partially bound bindings allow it as long as nothing uses them.
+	void BindlessDescriptors::removeSampledImage(const uint32_t &index) {
+		const std::scoped_lock lock(m_mutex);
+		m_freeSampledImages.indices.push_back(index);
+	}
+
+	void BindlessDescriptors::removeSampler(const uint32_t &index) {
+		const std::scoped_lock lock(m_mutex);
+		m_freeSamplers.indices.push_back(index);
+	}
+
+	void BindlessDescriptors::removeStorageBuffer(const uint32_t &index) {
+		const std::scoped_lock lock(m_mutex);
+		m_freeStorageBuffers.indices.push_back(index);
+	}
+
+	void BindlessDescriptors::bind(VkCommandBuffer commandBuffer, const VkPipelineBindPoint &bindPoint) const {
+		vkCmdBindDescriptorSets(commandBuffer, bindPoint, m_pipelineLayout, 0, 1, &m_descriptorSet, 0, nullptr);
+	}
+
+	void BindlessDescriptors::createSetLayout() {
+		const std::array<VkDescriptorSetLayoutBinding, BINDLESS_BINDING_COUNT> bindings{
+			{{.binding = BINDLESS_BINDING_SAMPLED_IMAGES,
+				.descriptorType = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,
+				.descriptorCount = MAX_BINDLESS_SAMPLED_IMAGES,
+				.stageFlags = VK_SHADER_STAGE_ALL,
+				.pImmutableSamplers = nullptr},
+			 {.binding = BINDLESS_BINDING_SAMPLERS,
+				.descriptorType = VK_DESCRIPTOR_TYPE_SAMPLER,
+				.descriptorCount = MAX_BINDLESS_SAMPLERS,
+				.stageFlags = VK_SHADER_STAGE_ALL,
+				.pImmutableSamplers = nullptr},
+			 {.binding = BINDLESS_BINDING_STORAGE_BUFFERS,
+				.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+				.descriptorCount = MAX_BINDLESS_STORAGE_BUFFERS,
+				.stageFlags = VK_SHADER_STAGE_ALL,
+				.pImmutableSamplers = nullptr}}};
+
+		const std::array<VkDescriptorBindingFlags, BINDLESS_BINDING_COUNT> bindingFlags{
+			BINDLESS_BINDING_FLAGS, BINDLESS_BINDING_FLAGS, BINDLESS_BINDING_FLAGS};
+		const VkDescriptorSetLayoutBindingFlagsCreateInfo bindingFlagsInfo{
+			.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO,
+			.pNext = nullptr,
+			.bindingCount = static_cast<uint32_t>(bindingFlags.size()),
+			.pBindingFlags = bindingFlags.data()};
+
+		const VkDescriptorSetLayoutCreateInfo layoutInfo{
+			.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
+			.pNext = &bindingFlagsInfo,
+			.flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT,
+			.bindingCount = static_cast<uint32_t>(bindings.size()),
+			.pBindings = bindings.data()};
+
+		if(vkCreateDescriptorSetLayout(m_logicalDevice->getHandle(), &layoutInfo, nullptr, &m_setLayout) != VK_SUCCESS) {
+			VN_LOG_CRITICAL("Failed to create bindless descriptor set layout.");
+			throw std::runtime_error("Failed to create bindless descriptor set layout.");
+		}
+	}
+
+	void BindlessDescriptors::createSet() {
+		const std::array<VkDescriptorPoolSize, BINDLESS_BINDING_COUNT> poolSizes{
+			{{.type = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, .descriptorCount = MAX_BINDLESS_SAMPLED_IMAGES},
+			 {.type = VK_DESCRIPTOR_TYPE_SAMPLER, .descriptorCount = MAX_BINDLESS_SAMPLERS},
+			 {.type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, .descriptorCount = MAX_BINDLESS_STORAGE_BUFFERS}}};
+
+		const VkDescriptorPoolCreateInfo poolInfo{.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
+																							.pNext = nullptr,
+																							.flags = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT,
+																							.maxSets = 1,
+																							.poolSizeCount = static_cast<uint32_t>(poolSizes.size()),
+																							.pPoolSizes = poolSizes.data()};
+
+		if(vkCreateDescriptorPool(m_logicalDevice->getHandle(), &poolInfo, nullptr, &m_descriptorPool) != VK_SUCCESS) {
+			VN_LOG_CRITICAL("Failed to create bindless descriptor pool.");
+			throw std::runtime_error("Failed to create bindless descriptor pool.");
+		}
+
+		const VkDescriptorSetAllocateInfo allocInfo{.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
+																								.pNext = nullptr,
+																								.descriptorPool = m_descriptorPool,
+																								.descriptorSetCount = 1,
+																								.pSetLayouts = &m_setLayout};
+
+		if(vkAllocateDescriptorSets(m_logicalDevice->getHandle(), &allocInfo, &m_descriptorSet) != VK_SUCCESS) {
+			VN_LOG_CRITICAL("Failed to allocate bindless descriptor set.");
+			throw std::runtime_error("Failed to allocate bindless descriptor set.");
+		}
+	}
+
+	void BindlessDescriptors::createPipelineLayout() {
+		const VkPushConstantRange pushConstantRange{
+			.stageFlags = PUSH_CONSTANT_STAGES, .offset = 0, .size = PUSH_CONSTANT_SIZE};
+		const VkPipelineLayoutCreateInfo pipelineLayoutInfo{.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
+																												.pNext = nullptr,
+																												.flags = 0,
+																												.setLayoutCount = 1,
+																												.pSetLayouts = &m_setLayout,
+																												.pushConstantRangeCount = 1,
+																												.pPushConstantRanges = &pushConstantRange};
+
+		if(vkCreatePipelineLayout(m_logicalDevice->getHandle(), &pipelineLayoutInfo, nullptr, &m_pipelineLayout) !=
+			 VK_SUCCESS) {
+			VN_LOG_CRITICAL("Failed to create bindless pipeline layout.");
+			throw std::runtime_error("Failed to create bindless pipeline layout.");
+		}
+	}
+
+	void BindlessDescriptors::createDefaultSampler() {
+		const VkSamplerCreateInfo samplerInfo{.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO,
+																					.pNext = nullptr,
+																					.flags = 0,
+																					.magFilter = VK_FILTER_LINEAR,
+																					.minFilter = VK_FILTER_LINEAR,
+																					.mipmapMode = VK_SAMPLER_MIPMAP_MODE_LINEAR,
+																					.addressModeU = VK_SAMPLER_ADDRESS_MODE_REPEAT,
+																					.addressModeV = VK_SAMPLER_ADDRESS_MODE_REPEAT,
+																					.addressModeW = VK_SAMPLER_ADDRESS_MODE_REPEAT,
+																					.mipLodBias = 0.0F,
+																					.anisotropyEnable = VK_FALSE,
+																					.maxAnisotropy = 1.0F,
+																					.compareEnable = VK_FALSE,
+																					.compareOp = VK_COMPARE_OP_ALWAYS,
+																					.minLod = 0.0F,
+																					.maxLod = VK_LOD_CLAMP_NONE,
+																					.borderColor = VK_BORDER_COLOR_INT_OPAQUE_BLACK,
+																					.unnormalizedCoordinates = VK_FALSE};
+
+		if(vkCreateSampler(m_logicalDevice->getHandle(), &samplerInfo, nullptr, &m_defaultSampler) != VK_SUCCESS) {
+			VN_LOG_CRITICAL("Failed to create default sampler.");
+			throw std::runtime_error("Failed to create default sampler.");
+		}
+	}
+
+	auto BindlessDescriptors::createFreeList(const uint32_t &count, const char *name) -> FreeList {
+		FreeList freeList{.indices = {}, .name = name};
+		freeList.indices.reserve(count);
+		for(uint32_t index = count; index > 0; --index) {
+			freeList.indices.push_back(index - 1);
+		}
+		return freeList;
+	}
+
+	auto BindlessDescriptors::takeIndex(FreeList &freeList) -> uint32_t {
+		if(freeList.indices.empty()) {
+			VN_LOG_CRITICAL(std::format("Bindless descriptor set has no room for more {}.", freeList.name));
+			throw std::runtime_error("Bindless descriptor set is full.");
+		}
+		const uint32_t index = freeList.indices.back();
+		freeList.indices.pop_back();
+		return index;
+	}
+
+	void BindlessDescriptors::write(const BindlessBinding &binding, const uint32_t &index, const VkDescriptorType &type,
+																	const VkDescriptorImageInfo *imageInfo, const VkDescriptorBufferInfo *bufferInfo) {
+		const VkWriteDescriptorSet descriptorWrite{.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+																							 .pNext = nullptr,
+																							 .dstSet = m_descriptorSet,
+																							 .dstBinding = binding,
+																							 .dstArrayElement = index,
+																							 .descriptorCount = 1,
+																							 .descriptorType = type,
+																							 .pImageInfo = imageInfo,
+																							 .pBufferInfo = bufferInfo,
+																							 .pTexelBufferView = nullptr};
+		vkUpdateDescriptorSets(m_logicalDevice->getHandle(), 1, &descriptorWrite, 0, nullptr);
+	}
+
+}  // namespace venus
@@ -0,0 +1,112 @@
+#ifndef VENUS_BINDLESS_DESCRIPTORS_HPP
+#define VENUS_BINDLESS_DESCRIPTORS_HPP
+
+// THIRD PARTY
+#include "volk.h"
+
+// STDLIB
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace venus {
+	class LogicalDevice;
+
+	// Bindings of the bindless set, declared the same way by shaders/bindless.glsl.
+	enum BindlessBinding : uint8_t {
+		BINDLESS_BINDING_SAMPLED_IMAGES = 0,
+		BINDLESS_BINDING_SAMPLERS = 1,
+		BINDLESS_BINDING_STORAGE_BUFFERS = 2
+	};
+
+	/**
+   * @brief The one descriptor set every shader reaches its images, samplers and storage buffers through.
+   *
+   * @details Each kind of resource has a large array in the set. Adding a resource writes its descriptor into a free
+   *          element and returns the element's index, which shaders take from push constants or from buffers reached
+   *          through them. The set is bound once per command buffer, nothing is bound per draw.
+   *
+   *          Bindings are update after bind and partially bound. Elements may be written while command buffers using
+   *          the set are pending, as long as those command buffers do not use the elements, and unwritten elements are
+   *          fine as long as they are not used. An element must therefore only be removed once the frames that may use
+   *          it have completed, retire the removal to the DeletionQueue.
+   *
+   *          Every pipeline is created with the one layout 'getPipelineLayout()' returns: the set and a push constant
+   *          range of PUSH_CONSTANT_SIZE bytes visible to all stages. Switching pipelines therefore keeps both the set
+   *          and the pushed constants bound, and constants are always pushed with PUSH_CONSTANT_STAGES.
+   *
+   *          Element 0 of the samplers is a linear, repeating sampler that always exists.
+   *
+   *          Adding and removing are safe from any thread. This object cannot be copied. This object cannot be moved.
+   */
+	class BindlessDescriptors {
+	public:
+		// the smallest maxPushConstantsSize the specification allows.
+		static constexpr uint32_t PUSH_CONSTANT_SIZE = 128;
+		static constexpr VkShaderStageFlags PUSH_CONSTANT_STAGES =
+			VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT | VK_SHADER_STAGE_COMPUTE_BIT;
+		static constexpr uint32_t DEFAULT_SAMPLER = 0;
+		static constexpr uint32_t INVALID_INDEX = UINT32_MAX;
+
+		explicit BindlessDescriptors(const std::shared_ptr<LogicalDevice> &logicalDevicePtr);
+		~BindlessDescriptors();
+
+		BindlessDescriptors(const BindlessDescriptors &) = delete;
+		auto operator=(const BindlessDescriptors &) -> BindlessDescriptors & = delete;
+
+		BindlessDescriptors(const BindlessDescriptors &&) = delete;
+		auto operator=(const BindlessDescriptors &&) -> BindlessDescriptors & = delete;
+
+		// Any thread. 'imageView' must be in VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL whenever a shader samples it.
+		// Throws once the array is full.
+		[[nodiscard]] auto addSampledImage(VkImageView imageView) -> uint32_t;
+		[[nodiscard]] auto addSampler(VkSampler sampler) -> uint32_t;
+		[[nodiscard]] auto addStorageBuffer(VkBuffer buffer, const VkDeviceSize &offset, const VkDeviceSize &range)
+			-> uint32_t;
+
+		// Any thread, once no pending command buffer uses the element. The index is handed out again afterwards.
+		void removeSampledImage(const uint32_t &index);
+		void removeSampler(const uint32_t &index);
+		void removeStorageBuffer(const uint32_t &index);
+
+		// Records binding the set at 'bindPoint', once per command buffer and bind point is enough.
+		void bind(VkCommandBuffer commandBuffer, const VkPipelineBindPoint &bindPoint) const;
+
+		[[nodiscard]] auto getSetLayout() const -> VkDescriptorSetLayout { return m_setLayout; }
+		[[nodiscard]] auto getPipelineLayout() const -> VkPipelineLayout { return m_pipelineLayout; }
+
+	private:
+		std::shared_ptr<LogicalDevice> m_logicalDevice;
+		VkDescriptorSetLayout m_setLayout = VK_NULL_HANDLE;
+		VkDescriptorPool m_descriptorPool = VK_NULL_HANDLE;
+		VkDescriptorSet m_descriptorSet = VK_NULL_HANDLE;
+		VkPipelineLayout m_pipelineLayout = VK_NULL_HANDLE;
+		VkSampler m_defaultSampler = VK_NULL_HANDLE;
+
+		// free elements of one binding, handed out lowest first.
+		struct FreeList {
+			std::vector<uint32_t> indices;
+			const char *name;
+		};
+
+		// guards the free lists and the descriptor writes, elements of one set must not be written concurrently.
+		std::mutex m_mutex;
+		FreeList m_freeSampledImages;
+		FreeList m_freeSamplers;
+		FreeList m_freeStorageBuffers;
+
+		void createSetLayout();
+		void createSet();
+		void createPipelineLayout();
+		void createDefaultSampler();
+		[[nodiscard]] static auto createFreeList(const uint32_t &count, const char *name) -> FreeList;
+		// the mutex must be held.
+		[[nodiscard]] static auto takeIndex(FreeList &freeList) -> uint32_t;
+		void write(const BindlessBinding &binding, const uint32_t &index, const VkDescriptorType &type,
+							 const VkDescriptorImageInfo *imageInfo, const VkDescriptorBufferInfo *bufferInfo);
+	};
+
+}  // namespace venus
+
+#endif  // VENUS_BINDLESS_DESCRIPTORS_HPP
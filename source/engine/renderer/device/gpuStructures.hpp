@@ -20,6 +20,10 @@ namespace venus {
 	struct QueueFamilyIndices {
 		std::optional<uint32_t> graphicsFamilyIndex;
 		std::optional<uint32_t> presentFamilyIndex;
+		// only set for a compute family without graphics, see LogicalDevice for the queues used without one.
+		std::optional<uint32_t> computeFamilyIndex;
+		// only set for a family with copies alone, see LogicalDevice for the queues used without one.
+		std::optional<uint32_t> transferFamilyIndex;
 		bool supportsMinimum() { return graphicsFamilyIndex.has_value() && presentFamilyIndex.has_value(); }
 	};
 	// NOLINTEND
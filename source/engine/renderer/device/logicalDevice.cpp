@@ -1,14 +1,70 @@
 #include "logicalDevice.hpp"
 #include "VN_logger.hpp"
+#include "deviceAllocator.hpp"
 #include "physicalDevice.hpp"
 #include "renderConfig.hpp"
+#include "timelineSemaphore.hpp"
 
 // STDLIB
+#include <algorithm>
+#include <array>
 #include <cassert>
-#include <set>
+#include <format>
+#include <map>
 #include <stdexcept>
 
 namespace venus {
+	namespace {  // ANONYMOUS NAMESPACE BEGIN
+		// graphics, present, compute and transfer, a family is asked for at most one queue per role.
+		constexpr uint32_t QUEUE_ROLE_COUNT = 4;
+		constexpr std::array QUEUE_PRIORITIES{1.0F, 1.0F, 1.0F, 1.0F};
+		static_assert(QUEUE_PRIORITIES.size() >= QUEUE_ROLE_COUNT, "every queue a family may be asked for needs one.");
+
+		struct QueueSlot {
+			uint32_t familyIndex;
+			uint32_t queueIndex;
+		};
+
+		// one slot per role, keep QUEUE_ROLE_COUNT in step.
+		struct QueueTopology {
+			QueueSlot graphics;
+			QueueSlot present;
+			QueueSlot compute;
+			QueueSlot transfer;
+			std::map<uint32_t, uint32_t> queueCounts;  // queues to create per family.
+		};
+
+		// every role gets a queue of its own family when the device has one. Without a compute family compute work shares
+		// the graphics queue. Without a transfer family copies take a second queue of the compute family, the compute
+		// queue itself when that family only has one, and the graphics queue without a compute family.
+		auto planQueueTopology(const QueueFamilyIndices &indices, const std::vector<VkQueueFamilyProperties> &families)
+			-> QueueTopology {
+			QueueTopology topology{};
+			const auto requestQueue = [&](const uint32_t &familyIndex) -> QueueSlot {
+				uint32_t &queueCount = topology.queueCounts[familyIndex];
+				const uint32_t queueIndex = std::min(queueCount, families[familyIndex].queueCount - 1);
+				assert(queueIndex < QUEUE_PRIORITIES.size());
+				queueCount = std::max(queueCount, queueIndex + 1);
+				return {.familyIndex = familyIndex, .queueIndex = queueIndex};
+			};
+
+			topology.graphics = requestQueue(indices.graphicsFamilyIndex.value());  // NOLINT
+			topology.present = indices.presentFamilyIndex == indices.graphicsFamilyIndex ?
+													 topology.graphics :
+													 requestQueue(indices.presentFamilyIndex.value());  // NOLINT
+			topology.compute = indices.computeFamilyIndex.has_value() ? requestQueue(indices.computeFamilyIndex.value()) :
+																																	topology.graphics;
+			if(indices.transferFamilyIndex.has_value()) {
+				topology.transfer = requestQueue(indices.transferFamilyIndex.value());
+			} else if(indices.computeFamilyIndex.has_value()) {
+				topology.transfer = requestQueue(indices.computeFamilyIndex.value());
+			} else {
+				topology.transfer = topology.graphics;
+			}
+			return topology;
+		}
+	}  // namespace
+	// ANONYMOUS NAMESPACE END
 
 	LogicalDevice::LogicalDevice(const VkSurfaceKHR &surfaceRef): m_surface(surfaceRef) {
 		assert(m_surface != nullptr);
@@ -16,34 +72,63 @@ namespace venus {
 		m_physicalDevice = std::make_unique<PhysicalDevice>(surfaceRef);
 
 		const auto indices = m_physicalDevice->getQueueFamilyIndices();
-		const std::set<std::optional<uint32_t>> uniqueQueueFamilies = {indices.graphicsFamilyIndex,
-																																	 indices.presentFamilyIndex};
+		const QueueTopology topology = planQueueTopology(indices, m_physicalDevice->getQueueFamilyProperties());
 
-		const float QUEUE_PRIORITY = 1.0;
 		std::vector<VkDeviceQueueCreateInfo> queueCreateInfos;
-		for(std::optional<uint32_t> family : uniqueQueueFamilies) {
-			if(!(family == std::nullopt)) {
-				const VkDeviceQueueCreateInfo queueInfo{.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO,
-																								.pNext = nullptr,
-																								.flags = 0,
-																								.queueFamilyIndex = family.value(),
-																								.queueCount = 1,
-																								.pQueuePriorities = &QUEUE_PRIORITY};
-				queueCreateInfos.push_back(queueInfo);
-			}
+		for(const auto &[familyIndex, queueCount] : topology.queueCounts) {
+			const VkDeviceQueueCreateInfo queueInfo{.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO,
+																							.pNext = nullptr,
+																							.flags = 0,
+																							.queueFamilyIndex = familyIndex,
+																							.queueCount = queueCount,
+																							.pQueuePriorities = QUEUE_PRIORITIES.data()};
+			queueCreateInfos.push_back(queueInfo);
 		}
 
 		// TODO: MOVE TO PHYSICAL DEVICE CLASS
-		VkPhysicalDeviceSynchronization2Features syncFeatures2 = {};
-		syncFeatures2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SYNCHRONIZATION_2_FEATURES;
-		syncFeatures2.synchronization2 = VK_TRUE;
+		VkPhysicalDevicePresentWaitFeaturesKHR presentWaitFeatures = {};
+		presentWaitFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_WAIT_FEATURES_KHR;
+		presentWaitFeatures.presentWait = VK_TRUE;
+
+		VkPhysicalDevicePresentIdFeaturesKHR presentIdFeatures = {};
+		presentIdFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_ID_FEATURES_KHR;
+		presentIdFeatures.pNext = &presentWaitFeatures;
+		presentIdFeatures.presentId = VK_TRUE;
+
+		// timeline semaphores track frame completion, submission and barriers go through synchronization2 and passes use
+		// dynamic rendering. All are core 1.2/1.3 features but must still be enabled.
+		VkPhysicalDeviceVulkan13Features vulkan13Features = {};
+		vulkan13Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_3_FEATURES;
+
+		VkPhysicalDeviceVulkan12Features vulkan12Features = {};
+		vulkan12Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+		vulkan12Features.pNext = &vulkan13Features;
+
+		// optional features are only chained when the physical device supports them.
+		if(m_physicalDevice->supportsPresentWait()) {
+			vulkan13Features.pNext = &presentIdFeatures;
+		}
 
 		VkPhysicalDeviceFeatures2 features2 = {};
 		features2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
-		features2.pNext = &syncFeatures2;
+		features2.pNext = &vulkan12Features;
 
 		vkGetPhysicalDeviceFeatures2(m_physicalDevice->getHandle(), &features2);
 
+		// the physical device was only chosen because it supports these, see 'areRequiredFeaturesSupported()'.
+		assert(vulkan12Features.timelineSemaphore == VK_TRUE && vulkan13Features.synchronization2 == VK_TRUE &&
+					 vulkan13Features.dynamicRendering == VK_TRUE);
+		assert(vulkan12Features.bufferDeviceAddress == VK_TRUE && vulkan12Features.drawIndirectCount == VK_TRUE &&
+					 features2.features.multiDrawIndirect == VK_TRUE && features2.features.drawIndirectFirstInstance == VK_TRUE);
+
+		assert(vulkan12Features.runtimeDescriptorArray == VK_TRUE &&
+					 vulkan12Features.descriptorBindingPartiallyBound == VK_TRUE &&
+					 vulkan12Features.descriptorBindingSampledImageUpdateAfterBind == VK_TRUE &&
+					 vulkan12Features.descriptorBindingStorageBufferUpdateAfterBind == VK_TRUE &&
+					 vulkan12Features.descriptorBindingUpdateUnusedWhilePending == VK_TRUE &&
+					 vulkan12Features.shaderSampledImageArrayNonUniformIndexing == VK_TRUE &&
+					 vulkan12Features.shaderStorageBufferArrayNonUniformIndexing == VK_TRUE);
+
 		const VkDeviceCreateInfo createInfo{
 			.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO,
 			.pNext = &features2,
@@ -52,8 +137,8 @@ namespace venus {
 			.pQueueCreateInfos = queueCreateInfos.data(),
 			.enabledLayerCount = 0,          // DEPRECATED DO NOT USE
 			.ppEnabledLayerNames = nullptr,  // DEPRECATED DO NOT USE
-			.enabledExtensionCount = static_cast<uint32_t>(REQUIRED_EXTENSIONS.size()),
-			.ppEnabledExtensionNames = REQUIRED_EXTENSIONS.data(),
+			.enabledExtensionCount = static_cast<uint32_t>(m_physicalDevice->getEnabledExtensions().size()),
+			.ppEnabledExtensionNames = m_physicalDevice->getEnabledExtensions().data(),
 			.pEnabledFeatures = nullptr  // TODO: Move this to physical device class.
 		};
 
@@ -64,29 +149,42 @@ namespace venus {
 
 		volkLoadDevice(m_logicalDevice);
 
-		if(indices.graphicsFamilyIndex.has_value()) {
-			vkGetDeviceQueue(m_logicalDevice, indices.graphicsFamilyIndex.value(), 0, &m_graphicsQueue);
-		}
-
-		if(indices.presentFamilyIndex.has_value()) {
-			vkGetDeviceQueue(m_logicalDevice, indices.presentFamilyIndex.value(), 0, &m_presentQueue);
-		}
+		vkGetDeviceQueue(m_logicalDevice, topology.graphics.familyIndex, topology.graphics.queueIndex, &m_graphicsQueue);
+		vkGetDeviceQueue(m_logicalDevice, topology.present.familyIndex, topology.present.queueIndex, &m_presentQueue);
+		vkGetDeviceQueue(m_logicalDevice, topology.compute.familyIndex, topology.compute.queueIndex, &m_computeQueue);
+		vkGetDeviceQueue(m_logicalDevice, topology.transfer.familyIndex, topology.transfer.queueIndex, &m_transferQueue);
+		m_computeFamilyIndex = topology.compute.familyIndex;
+		m_transferFamilyIndex = topology.transfer.familyIndex;
+		m_hasAsyncCompute = indices.computeFamilyIndex.has_value();
 
-		if(m_graphicsQueue == VK_NULL_HANDLE || m_presentQueue == VK_NULL_HANDLE) {
+		if(m_graphicsQueue == VK_NULL_HANDLE || m_presentQueue == VK_NULL_HANDLE || m_computeQueue == VK_NULL_HANDLE ||
+			 m_transferQueue == VK_NULL_HANDLE) {
 			VN_LOG_CRITICAL("Failed to successfully get device queues.");
 			throw std::runtime_error("Failed to successfully get device queues.");
 		}
 
 		createCommandPool();
 		createCommandBuffer();
-
+		m_graphicsTimeline = std::make_unique<TimelineSemaphore>(m_logicalDevice);
+		m_deviceAllocator = std::make_unique<DeviceAllocator>(m_physicalDevice->getHandle(), m_logicalDevice,
+																													m_physicalDevice->getProperties());
+
+		VN_LOG_INFO(std::format("Queues: graphics {}.{}, present {}.{}, compute {}.{}, transfer {}.{} (family.queue).",
+														topology.graphics.familyIndex, topology.graphics.queueIndex, topology.present.familyIndex,
+														topology.present.queueIndex, topology.compute.familyIndex, topology.compute.queueIndex,
+														topology.transfer.familyIndex, topology.transfer.queueIndex));
 		VN_LOG_INFO("Logical Device construction was successful.");
 	}
 
 	LogicalDevice::~LogicalDevice() {
 		assert(m_logicalDevice != VK_NULL_HANDLE);
 
-		vkDestroyCommandPool(m_logicalDevice, m_graphicsPool, nullptr);
+		m_deviceAllocator.reset();
+		m_graphicsTimeline.reset();
+
+		for(auto &commandPool : m_graphicsPools) {
+			vkDestroyCommandPool(m_logicalDevice, commandPool, nullptr);
+		}
 
 		vkDestroyDevice(m_logicalDevice, nullptr);
 		m_logicalDevice = VK_NULL_HANDLE;
@@ -100,6 +198,30 @@ namespace venus {
 	auto LogicalDevice::swapchainSupportDetails() const -> SwapchainSupportDetails {
 		return m_physicalDevice->getSwapchainSupportDetails();
 	}
+	auto LogicalDevice::currentSurfaceCapabilities() const -> VkSurfaceCapabilitiesKHR {
+		VkSurfaceCapabilitiesKHR capabilities{};
+		if(vkGetPhysicalDeviceSurfaceCapabilitiesKHR(m_physicalDevice->getHandle(), m_surface, &capabilities) !=
+			 VK_SUCCESS) {
+			VN_LOG_CRITICAL("Failed to query surface capabilities.");
+			throw std::runtime_error("Failed to query surface capabilities.");
+		}
+		return capabilities;
+	}
+	auto LogicalDevice::supportsPresentWait() const -> bool { return m_physicalDevice->supportsPresentWait(); }
+	auto LogicalDevice::physicalDeviceProperties() const -> const VkPhysicalDeviceProperties & {
+		return m_physicalDevice->getProperties();
+	}
+	auto LogicalDevice::driverUUID() const -> const std::array<uint8_t, VK_UUID_SIZE> & {
+		return m_physicalDevice->getDriverUUID();
+	}
+	auto LogicalDevice::queueFamilyProperties(const uint32_t &familyIndex) const -> const VkQueueFamilyProperties & {
+		return m_physicalDevice->getQueueFamilyProperties()[familyIndex];
+	}
+	auto LogicalDevice::formatProperties(const VkFormat &format) const -> VkFormatProperties {
+		VkFormatProperties properties{};
+		vkGetPhysicalDeviceFormatProperties(m_physicalDevice->getHandle(), format, &properties);
+		return properties;
+	}
 
 	void LogicalDevice::createCommandPool() {
 		auto indices = m_physicalDevice->getQueueFamilyIndices();
@@ -110,34 +232,46 @@ namespace venus {
 
 		const VkCommandPoolCreateInfo createInfo{.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO,
 																						 .pNext = nullptr,
-																						 .flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT,
+																						 .flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT,
 																						 .queueFamilyIndex = INDEX};
 
-		if(vkCreateCommandPool(m_logicalDevice, &createInfo, nullptr, &m_graphicsPool) != VK_SUCCESS) {
-			VN_LOG_CRITICAL("Failed to create graphics pool.");
-			throw std::runtime_error("Failed to create graphics pool.");
+		m_graphicsPools.resize(MAX_FRAMES_IN_FLIGHT, VK_NULL_HANDLE);
+		for(auto &commandPool : m_graphicsPools) {
+			if(vkCreateCommandPool(m_logicalDevice, &createInfo, nullptr, &commandPool) != VK_SUCCESS) {
+				VN_LOG_CRITICAL("Failed to create graphics pool.");
+				throw std::runtime_error("Failed to create graphics pool.");
+			}
 		}
 	}
 
 	void LogicalDevice::createCommandBuffer() {
 		m_commandBuffers.resize(MAX_FRAMES_IN_FLIGHT);
 
-		const VkCommandBufferAllocateInfo allocInfo{.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
-																								.pNext = nullptr,
-																								.commandPool = m_graphicsPool,
-																								.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY,
-																								.commandBufferCount = static_cast<uint32_t>(m_commandBuffers.size())};
+		for(size_t i = 0; i < m_commandBuffers.size(); ++i) {
+			const VkCommandBufferAllocateInfo allocInfo{.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
+																									.pNext = nullptr,
+																									.commandPool = m_graphicsPools[i],
+																									.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY,
+																									.commandBufferCount = 1};
+
+			if(vkAllocateCommandBuffers(m_logicalDevice, &allocInfo, &m_commandBuffers[i]) != VK_SUCCESS) {
+				VN_LOG_CRITICAL("Failed to allocate command buffer.");
+				throw std::runtime_error("Failed to allocate command buffer.");
+			}
+		}
+	}
 
-		if(vkAllocateCommandBuffers(m_logicalDevice, &allocInfo, m_commandBuffers.data()) != VK_SUCCESS) {
-			VN_LOG_CRITICAL("Failed to allocate command buffer.");
-			throw std::runtime_error("Failed to allocate command buffer.");
+	void LogicalDevice::resetCommandPool(const uint32_t &frameIndex) {
+		if(vkResetCommandPool(m_logicalDevice, m_graphicsPools[frameIndex], 0) != VK_SUCCESS) {
+			VN_LOG_CRITICAL("Failed to reset graphics pool.");
+			throw std::runtime_error("Failed to reset graphics pool.");
 		}
 	}
 
 	void LogicalDevice::start_RecordCommandBuffer(const uint32_t &bufferIndex) {
 		const VkCommandBufferBeginInfo beginInfo{.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
 																						 .pNext = nullptr,
-																						 .flags = 0,
+																						 .flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT,
 																						 .pInheritanceInfo = nullptr};
 
 		if(vkBeginCommandBuffer(m_commandBuffers[bufferIndex], &beginInfo) != VK_SUCCESS) {
@@ -8,10 +8,15 @@
 #include "volk.h"
 
 // STDLIB
+#include <array>
+#include <cstdint>
 #include <memory>
+#include <vector>
 
 namespace venus {
+	class DeviceAllocator;
 	class PhysicalDevice;
+	class TimelineSemaphore;
 	class LogicalDevice {
 	public:
 		explicit LogicalDevice(const VkSurfaceKHR &surfaceRef);
@@ -27,11 +32,36 @@ namespace venus {
 
 		[[nodiscard]] auto queueFamilyIndices() const -> QueueFamilyIndices;
 		[[nodiscard]] auto swapchainSupportDetails() const -> SwapchainSupportDetails;
-
-		[[nodiscard]] auto getCommandBuffers() const { return m_commandBuffers; }
+		// Queries the surface again, the capabilities cached at device selection go stale whenever the window resizes.
+		[[nodiscard]] auto currentSurfaceCapabilities() const -> VkSurfaceCapabilitiesKHR;
+		[[nodiscard]] auto supportsPresentWait() const -> bool;
+		[[nodiscard]] auto physicalDeviceProperties() const -> const VkPhysicalDeviceProperties &;
+		[[nodiscard]] auto driverUUID() const -> const std::array<uint8_t, VK_UUID_SIZE> &;
+		[[nodiscard]] auto queueFamilyProperties(const uint32_t &familyIndex) const -> const VkQueueFamilyProperties &;
+		[[nodiscard]] auto formatProperties(const VkFormat &format) const -> VkFormatProperties;
+
+		[[nodiscard]] auto getCommandBuffer(const uint32_t &bufferIndex) const -> VkCommandBuffer {
+			return m_commandBuffers[bufferIndex];
+		}
+		// Roles without a family of their own share the queue of a more general family, the same VkQueue may be returned
+		// for several roles. Queues are externally synchronized, only the render thread submits to them.
 		[[nodiscard]] auto getGraphicsQueue() const { return m_graphicsQueue; }
 		[[nodiscard]] auto getPresentQueue() const { return m_presentQueue; }
+		[[nodiscard]] auto getComputeQueue() const { return m_computeQueue; }
+		[[nodiscard]] auto getTransferQueue() const { return m_transferQueue; }
+		[[nodiscard]] auto getComputeFamilyIndex() const -> uint32_t { return m_computeFamilyIndex; }
+		[[nodiscard]] auto getTransferFamilyIndex() const -> uint32_t { return m_transferFamilyIndex; }
+		// True when compute work can overlap rendering on a queue of its own.
+		[[nodiscard]] auto hasAsyncCompute() const -> bool { return m_hasAsyncCompute; }
+
+		// Signaled by every graphics queue submission, see TimelineSemaphore.
+		[[nodiscard]] auto getGraphicsTimeline() const -> TimelineSemaphore & { return *m_graphicsTimeline; }
 
+		// Sub-allocates memory for every buffer and image created on this device, see DeviceAllocator.
+		[[nodiscard]] auto getDeviceAllocator() const -> DeviceAllocator & { return *m_deviceAllocator; }
+
+		// Resets the frame's command pool wholesale, every buffer allocated from it returns to the initial state.
+		void resetCommandPool(const uint32_t &frameIndex);
 		void start_RecordCommandBuffer(const uint32_t &bufferIndex);
 		void stop_RecordCommandBuffer(const uint32_t &bufferIndex);
 
@@ -42,8 +72,16 @@ namespace venus {
 
 		VkQueue m_graphicsQueue = VK_NULL_HANDLE;
 		VkQueue m_presentQueue = VK_NULL_HANDLE;
-
-		VkCommandPool m_graphicsPool = VK_NULL_HANDLE;
+		VkQueue m_computeQueue = VK_NULL_HANDLE;
+		VkQueue m_transferQueue = VK_NULL_HANDLE;
+		uint32_t m_computeFamilyIndex = 0;
+		uint32_t m_transferFamilyIndex = 0;
+		bool m_hasAsyncCompute = false;
+		std::unique_ptr<TimelineSemaphore> m_graphicsTimeline;
+		std::unique_ptr<DeviceAllocator> m_deviceAllocator;
+
+		// one transient pool per frame in flight so a frame's buffers are reset together once its timeline value is reached.
+		std::vector<VkCommandPool> m_graphicsPools;
 		void createCommandPool();
 
 		std::vector<VkCommandBuffer> m_commandBuffers;
@@ -1,11 +1,16 @@
 #include "physicalDevice.hpp"
 #include "VN_logger.hpp"
+#include "renderConfig.hpp"
 
 // STDLIB
+#include <algorithm>
 #include <cassert>
+#include <format>
 #include <map>
+#include <optional>
 #include <set>
 #include <stdexcept>
+#include <string_view>
 #include <vector>
 
 namespace venus {
@@ -30,6 +35,133 @@ namespace venus {
 			return extensions_required.empty();
 		}
 
+		auto isDeviceExtensionAvailable(VkPhysicalDevice device, const std::string_view &extensionName) -> bool {
+			assert(device != nullptr);
+
+			uint32_t extensionCount = 0;
+			vkEnumerateDeviceExtensionProperties(device, nullptr, &extensionCount, nullptr);
+			std::vector<VkExtensionProperties> availableExtensions(extensionCount);
+			vkEnumerateDeviceExtensionProperties(device, nullptr, &extensionCount, availableExtensions.data());
+
+			return std::ranges::any_of(availableExtensions, [&extensionName](const VkExtensionProperties &extension) {
+				return extensionName == static_cast<const char *>(extension.extensionName);
+			});
+		}
+
+		// present-wait requires both present-id and present-wait, each as an extension and as an enabled feature.
+		auto queryPresentWaitSupport(VkPhysicalDevice device) -> bool {
+			assert(device != nullptr);
+
+			if(!isDeviceExtensionAvailable(device, VK_KHR_PRESENT_ID_EXTENSION_NAME) ||
+				 !isDeviceExtensionAvailable(device, VK_KHR_PRESENT_WAIT_EXTENSION_NAME)) {
+				return false;
+			}
+
+			VkPhysicalDevicePresentWaitFeaturesKHR presentWaitFeatures{
+				.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_WAIT_FEATURES_KHR, .pNext = nullptr, .presentWait = VK_FALSE};
+			VkPhysicalDevicePresentIdFeaturesKHR presentIdFeatures{.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_ID_FEATURES_KHR,
+																														 .pNext = &presentWaitFeatures,
+																														 .presentId = VK_FALSE};
+			VkPhysicalDeviceFeatures2 features2{
+				.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2, .pNext = &presentIdFeatures, .features = {}};
+			vkGetPhysicalDeviceFeatures2(device, &features2);
+
+			return presentIdFeatures.presentId == VK_TRUE && presentWaitFeatures.presentWait == VK_TRUE;
+		}
+
+		// the renderer is built on these, the logical device enables every feature the device reports.
+		auto areRequiredFeaturesSupported(VkPhysicalDevice device) -> bool {
+			assert(device != nullptr);
+
+			VN_LOG_DEBUG("Checking if graphics device supports required features.");
+
+			VkPhysicalDeviceProperties properties;
+			vkGetPhysicalDeviceProperties(device, &properties);
+			if(properties.apiVersion < VK_API_VERSION_1_3) {
+				VN_LOG_WARN("This device does not support Vulkan 1.3.");
+				return false;
+			}
+
+			VkPhysicalDeviceVulkan13Features vulkan13Features = {};
+			vulkan13Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_3_FEATURES;
+
+			VkPhysicalDeviceVulkan12Features vulkan12Features = {};
+			vulkan12Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+			vulkan12Features.pNext = &vulkan13Features;
+
+			VkPhysicalDeviceFeatures2 features2 = {};
+			features2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+			features2.pNext = &vulkan12Features;
+
+			vkGetPhysicalDeviceFeatures2(device, &features2);
+
+			// timeline semaphores track frame completion, submission and barriers go through synchronization2 and passes
+			// use dynamic rendering.
+			if(vulkan12Features.timelineSemaphore != VK_TRUE || vulkan13Features.synchronization2 != VK_TRUE ||
+				 vulkan13Features.dynamicRendering != VK_TRUE) {
+				VN_LOG_WARN("This device does not support timeline semaphores, synchronization2 and dynamic rendering.");
+				return false;
+			}
+
+			// draws are culled and compacted on the gpu, which reaches the frame's buffers through their device addresses
+			// and hands the survivors to indirect draws with a gpu written count.
+			if(vulkan12Features.bufferDeviceAddress != VK_TRUE || vulkan12Features.drawIndirectCount != VK_TRUE ||
+				 features2.features.multiDrawIndirect != VK_TRUE || features2.features.drawIndirectFirstInstance != VK_TRUE) {
+				VN_LOG_WARN("This device does not support buffer device addresses and indirect draws with a count.");
+				return false;
+			}
+
+			// every resource a shader samples sits in one bindless set, written while frames using it are still in flight
+			// and indexed per draw, see BindlessDescriptors.
+			if(vulkan12Features.runtimeDescriptorArray != VK_TRUE ||
+				 vulkan12Features.descriptorBindingPartiallyBound != VK_TRUE ||
+				 vulkan12Features.descriptorBindingSampledImageUpdateAfterBind != VK_TRUE ||
+				 vulkan12Features.descriptorBindingStorageBufferUpdateAfterBind != VK_TRUE ||
+				 vulkan12Features.descriptorBindingUpdateUnusedWhilePending != VK_TRUE ||
+				 vulkan12Features.shaderSampledImageArrayNonUniformIndexing != VK_TRUE ||
+				 vulkan12Features.shaderStorageBufferArrayNonUniformIndexing != VK_TRUE) {
+				VN_LOG_WARN("This device does not support update after bind descriptor indexing.");
+				return false;
+			}
+
+			return true;
+		}
+
+		// the bindless set is sized up front and visible to every stage, its arrays must fit the update after bind
+		// limits of the whole set and of a single stage.
+		auto areBindlessLimitsSupported(VkPhysicalDevice device) -> bool {
+			assert(device != nullptr);
+
+			VkPhysicalDeviceVulkan12Properties vulkan12Properties = {};
+			vulkan12Properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_PROPERTIES;
+
+			VkPhysicalDeviceProperties2 properties2 = {};
+			properties2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+			properties2.pNext = &vulkan12Properties;
+
+			vkGetPhysicalDeviceProperties2(device, &properties2);
+
+			const VkPhysicalDeviceVulkan12Properties &limits = vulkan12Properties;
+			const bool setLimitsSupported =
+				limits.maxDescriptorSetUpdateAfterBindSampledImages >= MAX_BINDLESS_SAMPLED_IMAGES &&
+				limits.maxDescriptorSetUpdateAfterBindSamplers >= MAX_BINDLESS_SAMPLERS &&
+				limits.maxDescriptorSetUpdateAfterBindStorageBuffers >= MAX_BINDLESS_STORAGE_BUFFERS;
+			const bool stageLimitsSupported =
+				limits.maxPerStageDescriptorUpdateAfterBindSampledImages >= MAX_BINDLESS_SAMPLED_IMAGES &&
+				limits.maxPerStageDescriptorUpdateAfterBindSamplers >= MAX_BINDLESS_SAMPLERS &&
+				limits.maxPerStageDescriptorUpdateAfterBindStorageBuffers >= MAX_BINDLESS_STORAGE_BUFFERS &&
+				limits.maxPerStageUpdateAfterBindResources >=
+					MAX_BINDLESS_SAMPLED_IMAGES + MAX_BINDLESS_SAMPLERS + MAX_BINDLESS_STORAGE_BUFFERS;
+
+			if(!setLimitsSupported || !stageLimitsSupported) {
+				VN_LOG_WARN(std::format("This device's update after bind limits are below the bindless set's {} sampled "
+																"images, {} samplers and {} storage buffers.",
+																MAX_BINDLESS_SAMPLED_IMAGES, MAX_BINDLESS_SAMPLERS, MAX_BINDLESS_STORAGE_BUFFERS));
+				return false;
+			}
+			return true;
+		}
+
 		auto querySwapchainSupport(VkPhysicalDevice device, VkSurfaceKHR surface) -> SwapchainSupportDetails {
 			assert(device != nullptr);
 			assert(surface != nullptr);
@@ -77,44 +209,76 @@ namespace venus {
 			std::vector<VkQueueFamilyProperties> familyProperties(queueFamilyCount);
 			vkGetPhysicalDeviceQueueFamilyProperties(device, &queueFamilyCount, familyProperties.data());
 
-			uint32_t INDEX_NUMBER = 0;
-			for(const auto &family : familyProperties) {
-				// TODO: Update this to properly determine which queue families we want to use.
-				if(indices.supportsMinimum()) {
-					break;
+			// graphics and present come from one family whenever a family supports both, the swapchain images then
+			// never need to be shared between families.
+			std::optional<uint32_t> firstGraphicsFamily;
+			std::optional<uint32_t> firstPresentFamily;
+			for(uint32_t familyIndex = 0; familyIndex < queueFamilyCount; ++familyIndex) {
+				const VkQueueFamilyProperties &family = familyProperties[familyIndex];
+				if(family.queueCount == 0) {
+					continue;
 				}
 
 				const bool familySupportsGraphics = static_cast<bool>(family.queueFlags & VK_QUEUE_GRAPHICS_BIT);
-				if(family.queueCount > 0 && familySupportsGraphics) {
-					indices.graphicsFamilyIndex = INDEX_NUMBER;
+				VkBool32 presentationIsSupported = 0U;  // SET TO FALSE
+				vkGetPhysicalDeviceSurfaceSupportKHR(device, familyIndex, surface, &presentationIsSupported);
+
+				if(familySupportsGraphics && presentationIsSupported != 0U) {
+					indices.graphicsFamilyIndex = familyIndex;
+					indices.presentFamilyIndex = familyIndex;
+					break;
+				}
+				if(familySupportsGraphics && !firstGraphicsFamily.has_value()) {
+					firstGraphicsFamily = familyIndex;
 				}
+				if(presentationIsSupported != 0U && !firstPresentFamily.has_value()) {
+					firstPresentFamily = familyIndex;
+				}
+			}
+			if(!indices.graphicsFamilyIndex.has_value()) {
+				indices.graphicsFamilyIndex = firstGraphicsFamily;
+				indices.presentFamilyIndex = firstPresentFamily;
+			}
 
-				VkBool32 presentationIsSupported = 0U;  // SET TO FALSE
-				vkGetPhysicalDeviceSurfaceSupportKHR(device, INDEX_NUMBER, surface, &presentationIsSupported);
-				if(family.queueCount > 0 && (presentationIsSupported != 0U)) {
-					indices.presentFamilyIndex = INDEX_NUMBER;
+			// a compute family without graphics runs alongside rendering, a family with neither is the copy engine.
+			for(uint32_t familyIndex = 0; familyIndex < queueFamilyCount; ++familyIndex) {
+				const VkQueueFamilyProperties &family = familyProperties[familyIndex];
+				if(family.queueCount == 0 || (family.queueFlags & VK_QUEUE_GRAPHICS_BIT) != 0) {
+					continue;
 				}
 
-				++INDEX_NUMBER;
+				const bool familySupportsCompute = static_cast<bool>(family.queueFlags & VK_QUEUE_COMPUTE_BIT);
+				if(familySupportsCompute && !indices.computeFamilyIndex.has_value()) {
+					indices.computeFamilyIndex = familyIndex;
+				} else if(!familySupportsCompute && (family.queueFlags & VK_QUEUE_TRANSFER_BIT) != 0 &&
+									!indices.transferFamilyIndex.has_value()) {
+					indices.transferFamilyIndex = familyIndex;
+				}
 			}
 
 			return indices;
 		}
 
 		auto reportDeviceScore(VkPhysicalDevice device) -> uint32_t {
+			// every device meeting the minimum requirements is usable, including integrated gpus
+			// and software rasterizers such as lavapipe which headless runs depend on.
+			constexpr uint32_t SUITABLE_DEVICE_BASE_SCORE = 1;
+			constexpr uint32_t INTEGRATED_GPU_BONUS_SCORE = 1000;
 			constexpr uint32_t DISCRETE_GPU_BONUS_SCORE = 10000;
 
 			VN_LOG_DEBUG("Scoring graphics device suitability");
 
-			uint32_t TOTAL_SCORE = 0;
+			uint32_t TOTAL_SCORE = SUITABLE_DEVICE_BASE_SCORE;
 			VkPhysicalDeviceProperties properties;
 
 			vkGetPhysicalDeviceProperties(device, &properties);
 			if(properties.deviceType == VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU) {
-				TOTAL_SCORE = DISCRETE_GPU_BONUS_SCORE;
+				TOTAL_SCORE += DISCRETE_GPU_BONUS_SCORE;
+			} else if(properties.deviceType == VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU) {
+				TOTAL_SCORE += INTEGRATED_GPU_BONUS_SCORE;
 			}
 
-			// TODO: actually score the devices, currently just giving 10k points to discrete gpus
+			// TODO: actually score the devices, currently only the device type is considered.
 
 			return TOTAL_SCORE;
 		}
@@ -128,6 +292,9 @@ namespace venus {
 				VN_LOG_WARN("This device does not support required extensions.");
 				return false;
 			}
+			if(!areRequiredFeaturesSupported(device) || !areBindlessLimitsSupported(device)) {
+				return false;
+			}
 			QueueFamilyIndices indices = findQueueFamilyIndices(device, surface);
 			if(!indices.supportsMinimum()) {
 				VN_LOG_WARN("This device does not support minimum required queue families.");
@@ -162,7 +329,7 @@ namespace venus {
 			}
 		}
 
-		if(sortedDevices.rbegin()->first > 0) {
+		if(!sortedDevices.empty() && sortedDevices.rbegin()->first > 0) {
 			m_gpuDevice = sortedDevices.rbegin()->second;
 		} else {
 			VN_LOG_CRITICAL("Failed to successfully choose a graphics device.");
@@ -177,6 +344,32 @@ namespace venus {
 		m_gpuDevice_queueFamilyIndices = findQueueFamilyIndices(m_gpuDevice, surfaceRef);
 		m_gpuDevice_swapchainSupportDetails = querySwapchainSupport(m_gpuDevice, surfaceRef);
 
+		VkPhysicalDeviceVulkan11Properties vulkan11Properties = {};
+		vulkan11Properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_1_PROPERTIES;
+
+		VkPhysicalDeviceProperties2 properties2 = {};
+		properties2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+		properties2.pNext = &vulkan11Properties;
+
+		vkGetPhysicalDeviceProperties2(m_gpuDevice, &properties2);
+		m_gpuDevice_properties = properties2.properties;
+		std::ranges::copy(vulkan11Properties.driverUUID, m_gpuDevice_driverUUID.begin());
+
+		uint32_t queueFamilyCount = 0;
+		vkGetPhysicalDeviceQueueFamilyProperties(m_gpuDevice, &queueFamilyCount, nullptr);
+		m_gpuDevice_queueFamilyProperties.resize(queueFamilyCount);
+		vkGetPhysicalDeviceQueueFamilyProperties(m_gpuDevice, &queueFamilyCount, m_gpuDevice_queueFamilyProperties.data());
+
+		VN_LOG_INFO(std::format("Using graphics device: {}", static_cast<const char *>(m_gpuDevice_properties.deviceName)));
+
+		m_gpuDevice_enabledExtensions = REQUIRED_EXTENSIONS;
+		m_gpuDevice_supportsPresentWait = queryPresentWaitSupport(m_gpuDevice);
+		if(m_gpuDevice_supportsPresentWait) {
+			m_gpuDevice_enabledExtensions.push_back(VK_KHR_PRESENT_ID_EXTENSION_NAME);
+			m_gpuDevice_enabledExtensions.push_back(VK_KHR_PRESENT_WAIT_EXTENSION_NAME);
+			VN_LOG_INFO("Graphics device supports present-wait frame pacing.");
+		}
+
 		VN_LOG_INFO("Venus PhysicalDevice has been created.");
 	}
 
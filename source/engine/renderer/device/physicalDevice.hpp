@@ -7,6 +7,10 @@
 // THIRD PARTY
 #include "volk.h"
 
+// STDLIB
+#include <array>
+#include <cstdint>
+
 namespace venus {
 
 	const std::vector<const char *> REQUIRED_EXTENSIONS = {VK_KHR_SWAPCHAIN_EXTENSION_NAME,
@@ -27,10 +31,31 @@ namespace venus {
 		[[nodiscard]] auto getSwapchainSupportDetails() const -> SwapchainSupportDetails {
 			return m_gpuDevice_swapchainSupportDetails;
 		}
+		[[nodiscard]] auto getProperties() const -> const VkPhysicalDeviceProperties & { return m_gpuDevice_properties; }
+		// Identifies the driver build, data such as pipeline caches is only valid for the driver that produced it.
+		[[nodiscard]] auto getDriverUUID() const -> const std::array<uint8_t, VK_UUID_SIZE> & {
+			return m_gpuDevice_driverUUID;
+		}
+		[[nodiscard]] auto getQueueFamilyProperties() const -> const std::vector<VkQueueFamilyProperties> & {
+			return m_gpuDevice_queueFamilyProperties;
+		}
+
+		// Required extensions plus every supported optional extension, this is what the logical device enables.
+		[[nodiscard]] auto getEnabledExtensions() const -> const std::vector<const char *> & {
+			return m_gpuDevice_enabledExtensions;
+		}
+		[[nodiscard]] auto supportsPresentWait() const -> bool { return m_gpuDevice_supportsPresentWait; }
 
 	private:
 		VkPhysicalDevice m_gpuDevice = VK_NULL_HANDLE;
 
+		VkPhysicalDeviceProperties m_gpuDevice_properties{};
+		std::array<uint8_t, VK_UUID_SIZE> m_gpuDevice_driverUUID{};
+		std::vector<VkQueueFamilyProperties> m_gpuDevice_queueFamilyProperties;
+
+		std::vector<const char *> m_gpuDevice_enabledExtensions;
+		bool m_gpuDevice_supportsPresentWait = false;
+
 		QueueFamilyIndices m_gpuDevice_queueFamilyIndices{};
 		SwapchainSupportDetails m_gpuDevice_swapchainSupportDetails{};
 	};
@@ -0,0 +1,480 @@
+#include "renderGraph.hpp"
+#include "VN_logger.hpp"
+#include "deletionQueue.hpp"
+#include "logicalDevice.hpp"
+
+// STDLIB
+#include <algorithm>
+#include <format>
+#include <optional>
+#include <stdexcept>
+
+namespace venus {
+	namespace {  // ANONYMOUS NAMESPACE BEGIN
+		// only writes have to be made available by a barrier, reads just need its execution dependency.
+		constexpr VkAccessFlags2 WRITE_ACCESS_MASK =
+			VK_ACCESS_2_SHADER_WRITE_BIT | VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT | VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT |
+			VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT | VK_ACCESS_2_TRANSFER_WRITE_BIT | VK_ACCESS_2_HOST_WRITE_BIT |
+			VK_ACCESS_2_MEMORY_WRITE_BIT;
+
+		// what the planner knows about an image between two of its uses.
+		struct ImageState {
+			VkImageLayout layout;
+			VkPipelineStageFlags2 writeStages;  // of the last write or layout transition, every later use waits for them.
+			VkAccessFlags2 writeAccesses;  // not made available yet.
+			VkPipelineStageFlags2 readStages;  // since the last write, the next write or transition waits for them too.
+			VkPipelineStageFlags2 visibleStages;  // uses the last write was made visible to.
+			VkAccessFlags2 visibleAccesses;
+		};
+
+		// the barrier a use needs after what happened to the image so far, nothing when it is already ordered. The image
+		// and subresource range are left to the caller.
+		auto planAccess(ImageState &state, const ResourceAccess &access, const bool &write)
+			-> std::optional<VkImageMemoryBarrier2> {
+			const bool transition = state.layout != access.layout;
+			VkPipelineStageFlags2 srcStageMask = VK_PIPELINE_STAGE_2_NONE;
+			if(transition || write) {
+				srcStageMask = state.writeStages | state.readStages;
+			} else if((access.stageMask & ~state.visibleStages) != 0 || (access.accessMask & ~state.visibleAccesses) != 0) {
+				srcStageMask = state.writeStages;
+			}
+
+			std::optional<VkImageMemoryBarrier2> barrier;
+			if(transition || srcStageMask != VK_PIPELINE_STAGE_2_NONE) {
+				barrier = VkImageMemoryBarrier2{.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2,
+																				.pNext = nullptr,
+																				.srcStageMask = srcStageMask,
+																				.srcAccessMask = state.writeAccesses,
+																				.dstStageMask = access.stageMask,
+																				.dstAccessMask = access.accessMask,
+																				.oldLayout = state.layout,
+																				.newLayout = access.layout,
+																				.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+																				.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+																				.image = VK_NULL_HANDLE,
+																				.subresourceRange = {}};
+			}
+
+			if(write) {
+				state = {.layout = access.layout,
+								 .writeStages = access.stageMask,
+								 .writeAccesses = access.accessMask & WRITE_ACCESS_MASK,
+								 .readStages = VK_PIPELINE_STAGE_2_NONE,
+								 .visibleStages = VK_PIPELINE_STAGE_2_NONE,
+								 .visibleAccesses = VK_ACCESS_2_NONE};
+			} else if(transition) {
+				// the transition itself is a write that completes before the stages it was waited on in.
+				state = {.layout = access.layout,
+								 .writeStages = access.stageMask,
+								 .writeAccesses = VK_ACCESS_2_NONE,
+								 .readStages = access.stageMask,
+								 .visibleStages = access.stageMask,
+								 .visibleAccesses = access.accessMask};
+			} else {
+				state.readStages |= access.stageMask;
+				if(barrier.has_value()) {
+					state.visibleStages |= access.stageMask;
+					state.visibleAccesses |= access.accessMask;
+				}
+			}
+			return barrier;
+		}
+	}  // namespace
+	// ANONYMOUS NAMESPACE END
+
+	RenderGraph::RenderGraph(const std::shared_ptr<LogicalDevice> &logicalDevicePtr): m_logicalDevice(logicalDevicePtr) {
+		VN_LOG_INFO("Render graph has been created.");
+	}
+
+	RenderGraph::~RenderGraph() {
+		// the owner waited for the gpu, transient images still in use were retired by an earlier compile.
+		const VkDevice device = m_logicalDevice->getHandle();
+		for(const Resource &resource : m_resources) {
+			if(!resource.imported) {
+				vkDestroyImageView(device, resource.view, nullptr);
+				vkDestroyImage(device, resource.image, nullptr);
+			}
+		}
+		for(const MemorySlot &slot : m_memorySlots) {
+			m_logicalDevice->getDeviceAllocator().free(slot.allocation);
+		}
+
+		VN_LOG_INFO("Render graph has been destroyed.");
+	}
+
+	auto RenderGraph::importImage(const char *name, const VkImageAspectFlags &aspectMask,
+																const ResourceAccess &initialAccess, const ResourceAccess &finalAccess)
+		-> RenderResource {
+		m_resources.push_back({.name = name,
+													 .imported = true,
+													 .description = {.format = VK_FORMAT_UNDEFINED, .usage = 0, .aspectMask = aspectMask},
+													 .initialAccess = initialAccess,
+													 .finalAccess = finalAccess});
+		return {.index = static_cast<uint32_t>(m_resources.size() - 1)};
+	}
+
+	auto RenderGraph::createImage(const char *name, const TransientImageDescription &description) -> RenderResource {
+		m_resources.push_back({.name = name,
+													 .imported = false,
+													 .description = description,
+													 .initialAccess = {},
+													 .finalAccess = {}});
+		return {.index = static_cast<uint32_t>(m_resources.size() - 1)};
+	}
+
+	auto RenderGraph::addPass(const char *name, RenderPassRecorder recorder, void *userData) -> uint32_t {
+		m_passes.push_back({.name = name, .recorder = recorder, .userData = userData, .accesses = {}});
+		return static_cast<uint32_t>(m_passes.size() - 1);
+	}
+
+	void RenderGraph::read(const uint32_t &pass, const RenderResource &resource, const ResourceAccess &access) {
+		m_passes[pass].accesses.push_back({.resource = resource.index, .access = access, .write = false});
+	}
+
+	void RenderGraph::write(const uint32_t &pass, const RenderResource &resource, const ResourceAccess &access) {
+		m_passes[pass].accesses.push_back({.resource = resource.index, .access = access, .write = true});
+	}
+
+	void RenderGraph::compile(const VkExtent2D &extent, DeletionQueue &deletionQueue, const uint64_t &lastUseValue) {
+		retireTransientImages(deletionQueue, lastUseValue);
+		m_extent = extent;
+
+		cullPasses();
+		computeLifetimes();
+		createTransientImages();
+		planBarriers();
+
+		VN_LOG_INFO(std::format("Render graph compiled for {}x{}, {} of {} passes kept with {} image barriers.",
+														extent.width, extent.height, m_executionOrder.size(), m_passes.size(), m_barriers.size()));
+	}
+
+	void RenderGraph::setImportedImage(const RenderResource &resource, VkImage image, VkImageView view) {
+		Resource &imported = m_resources[resource.index];
+		imported.image = image;
+		imported.view = view;
+	}
+
+	void RenderGraph::execute(VkCommandBuffer commandBuffer) {
+		for(const uint32_t passIndex : m_executionOrder) {
+			const Pass &pass = m_passes[passIndex];
+			recordBarriers(commandBuffer, pass.firstBarrier, pass.barrierCount);
+			pass.recorder(commandBuffer, *this, pass.userData);
+		}
+		recordBarriers(commandBuffer, m_finalBarrierFirst, m_finalBarrierCount);
+	}
+
+	void RenderGraph::cullPasses() {
+		// walked backwards, an image is needed while a kept pass after this one reads it. Outputs are always needed.
+		std::vector<bool> needed(m_resources.size());
+		for(size_t index = 0; index < m_resources.size(); ++index) {
+			needed[index] = m_resources[index].imported;
+		}
+
+		for(auto pass = m_passes.rbegin(); pass != m_passes.rend(); ++pass) {
+			pass->culled = std::ranges::none_of(
+				pass->accesses, [&needed](const PassAccess &access) { return access.write && needed[access.resource]; });
+			if(pass->culled) {
+				continue;
+			}
+			// a write replaces the contents, earlier writers are only needed again when this pass reads the image too.
+			for(const PassAccess &access : pass->accesses) {
+				if(access.write && !m_resources[access.resource].imported) {
+					needed[access.resource] = false;
+				}
+			}
+			for(const PassAccess &access : pass->accesses) {
+				if(!access.write) {
+					needed[access.resource] = true;
+				}
+			}
+		}
+
+		m_executionOrder.clear();
+		for(uint32_t passIndex = 0; passIndex < m_passes.size(); ++passIndex) {
+			if(!m_passes[passIndex].culled) {
+				m_executionOrder.push_back(passIndex);
+			} else {
+				VN_LOG_INFO(std::format("Render pass '{}' contributes to no output and was culled.", m_passes[passIndex].name));
+			}
+		}
+	}
+
+	void RenderGraph::computeLifetimes() {
+		for(Resource &resource : m_resources) {
+			resource.firstUse = UINT32_MAX;
+			resource.lastUse = 0;
+			resource.usedStages = VK_PIPELINE_STAGE_2_NONE;
+			resource.writtenAccesses = VK_ACCESS_2_NONE;
+		}
+
+		for(uint32_t order = 0; order < m_executionOrder.size(); ++order) {
+			for(const PassAccess &access : m_passes[m_executionOrder[order]].accesses) {
+				Resource &resource = m_resources[access.resource];
+				resource.firstUse = std::min(resource.firstUse, order);
+				resource.lastUse = order;
+				resource.usedStages |= access.access.stageMask;
+				if(access.write) {
+					resource.writtenAccesses |= access.access.accessMask & WRITE_ACCESS_MASK;
+				}
+			}
+		}
+	}
+
+	void RenderGraph::createTransientImages() {
+		const VkDevice device = m_logicalDevice->getHandle();
+		std::vector<VkMemoryRequirements> requirements(m_resources.size());
+		std::vector<uint32_t> transients;
+		for(uint32_t index = 0; index < m_resources.size(); ++index) {
+			Resource &resource = m_resources[index];
+			if(resource.imported || resource.firstUse == UINT32_MAX) {
+				continue;
+			}
+
+			const VkImageCreateInfo imageInfo{.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
+																				.pNext = nullptr,
+																				.flags = 0,
+																				.imageType = VK_IMAGE_TYPE_2D,
+																				.format = resource.description.format,
+																				.extent = {.width = m_extent.width, .height = m_extent.height, .depth = 1},
+																				.mipLevels = 1,
+																				.arrayLayers = 1,
+																				.samples = VK_SAMPLE_COUNT_1_BIT,
+																				.tiling = VK_IMAGE_TILING_OPTIMAL,
+																				.usage = resource.description.usage,
+																				.sharingMode = VK_SHARING_MODE_EXCLUSIVE,
+																				.queueFamilyIndexCount = 0,
+																				.pQueueFamilyIndices = nullptr,
+																				.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED};
+			if(vkCreateImage(device, &imageInfo, nullptr, &resource.image) != VK_SUCCESS) {
+				VN_LOG_CRITICAL(std::format("Failed to create transient image '{}'.", resource.name));
+				throw std::runtime_error("Failed to create transient image.");
+			}
+			vkGetImageMemoryRequirements(device, resource.image, &requirements[index]);
+			transients.push_back(index);
+		}
+
+		// largest first, smaller images then fill the slots of larger ones they do not overlap instead of taking new ones.
+		std::ranges::sort(transients, [&requirements](const uint32_t &first, const uint32_t &second) {
+			return requirements[first].size > requirements[second].size;
+		});
+		for(const uint32_t index : transients) {
+			const Resource &resource = m_resources[index];
+			const auto slot = std::ranges::find_if(m_memorySlots, [this, &resource, &requirements,
+																														 &index](const MemorySlot &candidate) {
+				if((candidate.requirements.memoryTypeBits & requirements[index].memoryTypeBits) == 0) {
+					return false;
+				}
+				return std::ranges::none_of(candidate.resources, [this, &resource](const uint32_t &other) {
+					const Resource &occupant = m_resources[other];
+					return resource.firstUse <= occupant.lastUse && occupant.firstUse <= resource.lastUse;
+				});
+			});
+			if(slot == m_memorySlots.end()) {
+				m_memorySlots.push_back({.requirements = requirements[index], .resources = {index}, .allocation = {}});
+				continue;
+			}
+			slot->requirements.size = std::max(slot->requirements.size, requirements[index].size);
+			slot->requirements.alignment = std::max(slot->requirements.alignment, requirements[index].alignment);
+			slot->requirements.memoryTypeBits &= requirements[index].memoryTypeBits;
+			slot->resources.push_back(index);
+		}
+
+		DeviceAllocator &allocator = m_logicalDevice->getDeviceAllocator();
+		VkDeviceSize aliasedSize = 0;
+		VkDeviceSize separateSize = 0;
+		for(MemorySlot &slot : m_memorySlots) {
+			std::ranges::sort(slot.resources, {}, [this](const uint32_t &index) { return m_resources[index].firstUse; });
+			slot.allocation = allocator.allocate(slot.requirements,
+																					 {.usage = MEMORY_USAGE_GPU_ONLY, .tiling = RESOURCE_TILING_OPTIMAL});
+			aliasedSize += slot.requirements.size;
+
+			for(const uint32_t index : slot.resources) {
+				Resource &resource = m_resources[index];
+				separateSize += requirements[index].size;
+				if(vkBindImageMemory(device, resource.image, slot.allocation.memory, slot.allocation.offset) != VK_SUCCESS) {
+					VN_LOG_CRITICAL(std::format("Failed to bind memory of transient image '{}'.", resource.name));
+					throw std::runtime_error("Failed to bind transient image memory.");
+				}
+
+				const VkImageViewCreateInfo viewInfo{.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO,
+																						 .pNext = nullptr,
+																						 .flags = 0,
+																						 .image = resource.image,
+																						 .viewType = VK_IMAGE_VIEW_TYPE_2D,
+																						 .format = resource.description.format,
+																						 .components = {.r = VK_COMPONENT_SWIZZLE_IDENTITY,
+																														.g = VK_COMPONENT_SWIZZLE_IDENTITY,
+																														.b = VK_COMPONENT_SWIZZLE_IDENTITY,
+																														.a = VK_COMPONENT_SWIZZLE_IDENTITY},
+																						 .subresourceRange = {.aspectMask = resource.description.aspectMask,
+																																	.baseMipLevel = 0,
+																																	.levelCount = 1,
+																																	.baseArrayLayer = 0,
+																																	.layerCount = 1}};
+				if(vkCreateImageView(device, &viewInfo, nullptr, &resource.view) != VK_SUCCESS) {
+					VN_LOG_CRITICAL(std::format("Failed to create view of transient image '{}'.", resource.name));
+					throw std::runtime_error("Failed to create transient image view.");
+				}
+			}
+		}
+
+		VN_LOG_INFO(std::format("Render graph placed {} transient images in {} KiB, {} KiB without aliasing.",
+														transients.size(), aliasedSize / 1024, separateSize / 1024));
+	}
+
+	void RenderGraph::planBarriers() {
+		m_barriers.clear();
+		m_barrierResources.clear();
+
+		std::vector<ImageState> states(m_resources.size());
+		for(uint32_t index = 0; index < m_resources.size(); ++index) {
+			const Resource &resource = m_resources[index];
+			if(resource.imported) {
+				states[index] = {.layout = resource.initialAccess.layout,
+												 .writeStages = resource.initialAccess.stageMask,
+												 .writeAccesses = resource.initialAccess.accessMask & WRITE_ACCESS_MASK,
+												 .readStages = VK_PIPELINE_STAGE_2_NONE,
+												 .visibleStages = VK_PIPELINE_STAGE_2_NONE,
+												 .visibleAccesses = VK_ACCESS_2_NONE};
+			}
+		}
+		// a transient's contents are discarded on first use, but its memory was last used by the image before it in the
+		// slot, or by the slot's last image in the previous frame on the same queue.
+		for(const MemorySlot &slot : m_memorySlots) {
+			for(size_t position = 0; position < slot.resources.size(); ++position) {
+				const Resource &previous = m_resources[slot.resources[(position + slot.resources.size() - 1) %
+																															 slot.resources.size()]];
+				states[slot.resources[position]] = {.layout = VK_IMAGE_LAYOUT_UNDEFINED,
+																						.writeStages = previous.usedStages,
+																						.writeAccesses = previous.writtenAccesses,
+																						.readStages = VK_PIPELINE_STAGE_2_NONE,
+																						.visibleStages = VK_PIPELINE_STAGE_2_NONE,
+																						.visibleAccesses = VK_ACCESS_2_NONE};
+			}
+		}
+
+		const auto addBarrier = [this](const uint32_t &index, VkImageMemoryBarrier2 barrier) {
+			barrier.subresourceRange = {.aspectMask = m_resources[index].description.aspectMask,
+																	.baseMipLevel = 0,
+																	.levelCount = VK_REMAINING_MIP_LEVELS,
+																	.baseArrayLayer = 0,
+																	.layerCount = VK_REMAINING_ARRAY_LAYERS};
+			m_barriers.push_back(barrier);
+			m_barrierResources.push_back(index);
+		};
+
+		std::vector<PassAccess> uses;
+		for(const uint32_t passIndex : m_executionOrder) {
+			Pass &pass = m_passes[passIndex];
+			pass.firstBarrier = static_cast<uint32_t>(m_barriers.size());
+
+			// an image read and written by one pass is one use, in a single layout.
+			uses.clear();
+			for(const PassAccess &access : pass.accesses) {
+				const auto use = std::ranges::find_if(
+					uses, [&access](const PassAccess &existing) { return existing.resource == access.resource; });
+				if(use == uses.end()) {
+					uses.push_back(access);
+					continue;
+				}
+				if(use->access.layout != access.access.layout) {
+					VN_LOG_CRITICAL(std::format("Render pass '{}' uses image '{}' in two layouts.", pass.name,
+																			m_resources[access.resource].name));
+					throw std::runtime_error("Render pass uses an image in two layouts.");
+				}
+				use->access.stageMask |= access.access.stageMask;
+				use->access.accessMask |= access.access.accessMask;
+				use->write = use->write || access.write;
+			}
+
+			for(const PassAccess &use : uses) {
+				const std::optional<VkImageMemoryBarrier2> barrier = planAccess(states[use.resource], use.access, use.write);
+				if(barrier.has_value()) {
+					addBarrier(use.resource, barrier.value());
+				}
+			}
+			pass.barrierCount = static_cast<uint32_t>(m_barriers.size()) - pass.firstBarrier;
+		}
+
+		// imported images are handed over in the use they were imported with, written or not.
+		m_finalBarrierFirst = static_cast<uint32_t>(m_barriers.size());
+		for(uint32_t index = 0; index < m_resources.size(); ++index) {
+			const Resource &resource = m_resources[index];
+			const ImageState &state = states[index];
+			if(!resource.imported ||
+				 (state.layout == resource.finalAccess.layout && state.writeAccesses == VK_ACCESS_2_NONE)) {
+				continue;
+			}
+			addBarrier(index, {.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2,
+												 .pNext = nullptr,
+												 .srcStageMask = state.writeStages | state.readStages,
+												 .srcAccessMask = state.writeAccesses,
+												 .dstStageMask = resource.finalAccess.stageMask,
+												 .dstAccessMask = resource.finalAccess.accessMask,
+												 .oldLayout = state.layout,
+												 .newLayout = resource.finalAccess.layout,
+												 .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+												 .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+												 .image = VK_NULL_HANDLE,
+												 .subresourceRange = {}});
+		}
+		m_finalBarrierCount = static_cast<uint32_t>(m_barriers.size()) - m_finalBarrierFirst;
+	}
+
+	void RenderGraph::retireTransientImages(DeletionQueue &deletionQueue, const uint64_t &lastUseValue) {
+		if(m_memorySlots.empty()) {
+			return;
+		}
+
+		std::vector<VkImage> images;
+		std::vector<VkImageView> views;
+		for(Resource &resource : m_resources) {
+			if(!resource.imported && resource.image != VK_NULL_HANDLE) {
+				images.push_back(resource.image);
+				views.push_back(resource.view);
+				resource.image = VK_NULL_HANDLE;
+				resource.view = VK_NULL_HANDLE;
+			}
+		}
+		std::vector<DeviceAllocation> allocations;
+		for(const MemorySlot &slot : m_memorySlots) {
+			allocations.push_back(slot.allocation);
+		}
+		m_memorySlots.clear();
+
+		deletionQueue.retire(lastUseValue, [logicalDevice = m_logicalDevice, images, views, allocations]() {
+			const VkDevice device = logicalDevice->getHandle();
+			for(const VkImageView view : views) {
+				vkDestroyImageView(device, view, nullptr);
+			}
+			for(const VkImage image : images) {
+				vkDestroyImage(device, image, nullptr);
+			}
+			for(const DeviceAllocation &allocation : allocations) {
+				logicalDevice->getDeviceAllocator().free(allocation);
+			}
+		});
+	}
+
+	void RenderGraph::recordBarriers(VkCommandBuffer commandBuffer, const uint32_t &firstBarrier,
+																	 const uint32_t &barrierCount) {
+		if(barrierCount == 0) {
+			return;
+		}
+
+		for(uint32_t barrier = firstBarrier; barrier < firstBarrier + barrierCount; ++barrier) {
+			m_barriers[barrier].image = m_resources[m_barrierResources[barrier]].image;
+		}
+		const VkDependencyInfo dependencyInfo{.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO,
+																					.pNext = nullptr,
+																					.dependencyFlags = 0,
+																					.memoryBarrierCount = 0,
+																					.pMemoryBarriers = nullptr,
+																					.bufferMemoryBarrierCount = 0,
+																					.pBufferMemoryBarriers = nullptr,
+																					.imageMemoryBarrierCount = barrierCount,
+																					.pImageMemoryBarriers = &m_barriers[firstBarrier]};
+		vkCmdPipelineBarrier2(commandBuffer, &dependencyInfo);
+	}
+
+}  // namespace venus
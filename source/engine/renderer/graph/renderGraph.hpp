@@ -0,0 +1,170 @@
+#ifndef VENUS_RENDER_GRAPH_HPP
+#define VENUS_RENDER_GRAPH_HPP
+
+// PROJECT
+#include "deviceAllocator.hpp"
+
+// THIRD PARTY
+#include "volk.h"
+
+// STDLIB
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace venus {
+	class LogicalDevice;
+	class DeletionQueue;
+	class RenderGraph;
+
+	// How a pass touches an image, the synchronization2 scope of the access and the layout it needs the image in.
+	struct ResourceAccess {
+		VkPipelineStageFlags2 stageMask;
+		VkAccessFlags2 accessMask;
+		VkImageLayout layout;
+	};
+
+	struct RenderResource {
+		uint32_t index = UINT32_MAX;
+
+		[[nodiscard]] auto isValid() const -> bool { return index != UINT32_MAX; }
+	};
+
+	// An image the graph creates, sized to the extent the graph was compiled for.
+	struct TransientImageDescription {
+		VkFormat format;
+		VkImageUsageFlags usage;
+		VkImageAspectFlags aspectMask;
+	};
+
+	// Records one pass, image handles and views of its resources come from the graph.
+	using RenderPassRecorder = void (*)(VkCommandBuffer commandBuffer, const RenderGraph &graph, void *userData);
+
+	/**
+   * @brief Orders the passes of a frame's graphics command buffer and derives the barriers between them.
+   *
+   * @details Passes are added in execution order and declare the images they read and write, each with the stages,
+   *          accesses and layout of the use. Nothing is synchronized by hand: 'compile()' walks the passes once and
+   *          plans every image barrier the accesses need, layout transitions included, batched into at most one
+   *          vkCmdPipelineBarrier2 in front of each pass and one after the last. Reads that follow each other in the
+   *          same layout are not separated by barriers.
+   *
+   *          Imported images, like the swapchain image, live outside the graph and are its outputs. A pass whose writes
+   *          reach no output, directly or through the passes reading them, is culled. Transient images are created by
+   *          the graph for the passes using them. Transients whose lifetimes do not overlap share memory, the first use
+   *          of each discards the previous contents, so they must be written before they are read every frame.
+   *
+   *          Only images are tracked. Buffer hazards stay with the code owning the buffers, see DrawCuller.
+   *
+   *          Built once and compiled again whenever the extent changes, 'execute()' then records the frame without
+   *          allocating. Render thread only.
+   *
+   *          This object cannot be copied. This object cannot be moved.
+   */
+	class RenderGraph {
+	public:
+		explicit RenderGraph(const std::shared_ptr<LogicalDevice> &logicalDevicePtr);
+		~RenderGraph();
+
+		RenderGraph(const RenderGraph &) = delete;
+		auto operator=(const RenderGraph &) -> RenderGraph & = delete;
+
+		RenderGraph(const RenderGraph &&) = delete;
+		auto operator=(const RenderGraph &&) -> RenderGraph & = delete;
+
+		// 'initialAccess' is the image's use before the frame, its layout and what the first barrier waits for.
+		// 'finalAccess' is the use the image is handed over to after the last pass.
+		[[nodiscard]] auto importImage(const char *name, const VkImageAspectFlags &aspectMask,
+																	 const ResourceAccess &initialAccess, const ResourceAccess &finalAccess)
+			-> RenderResource;
+		[[nodiscard]] auto createImage(const char *name, const TransientImageDescription &description) -> RenderResource;
+
+		// Passes execute in the order they were added. 'name' and 'userData' must outlive the graph.
+		[[nodiscard]] auto addPass(const char *name, RenderPassRecorder recorder, void *userData) -> uint32_t;
+		void read(const uint32_t &pass, const RenderResource &resource, const ResourceAccess &access);
+		void write(const uint32_t &pass, const RenderResource &resource, const ResourceAccess &access);
+
+		// Culls passes, creates the transient images for 'extent' and plans the barriers. Transient images of an earlier
+		// compile are retired with 'lastUseValue'. Throws when a pass uses one image in two layouts.
+		void compile(const VkExtent2D &extent, DeletionQueue &deletionQueue, const uint64_t &lastUseValue);
+
+		// Imported images may change every frame, set them before 'execute()'.
+		void setImportedImage(const RenderResource &resource, VkImage image, VkImageView view);
+
+		// Records the passes that were not culled with their barriers, never allocates.
+		void execute(VkCommandBuffer commandBuffer);
+
+		[[nodiscard]] auto getImage(const RenderResource &resource) const -> VkImage {
+			return m_resources[resource.index].image;
+		}
+		[[nodiscard]] auto getImageView(const RenderResource &resource) const -> VkImageView {
+			return m_resources[resource.index].view;
+		}
+		[[nodiscard]] auto getExtent() const -> VkExtent2D { return m_extent; }
+
+	private:
+		std::shared_ptr<LogicalDevice> m_logicalDevice;
+		VkExtent2D m_extent{};
+
+		struct Resource {
+			const char *name;
+			bool imported;
+			TransientImageDescription description;  // only the aspect mask for imported images.
+			ResourceAccess initialAccess;
+			ResourceAccess finalAccess;
+			VkImage image = VK_NULL_HANDLE;
+			VkImageView view = VK_NULL_HANDLE;
+
+			// planned by 'compile()', in execution order of the passes that were kept.
+			uint32_t firstUse = UINT32_MAX;
+			uint32_t lastUse = 0;
+			VkPipelineStageFlags2 usedStages = VK_PIPELINE_STAGE_2_NONE;
+			VkAccessFlags2 writtenAccesses = VK_ACCESS_2_NONE;
+		};
+		std::vector<Resource> m_resources;
+
+		struct PassAccess {
+			uint32_t resource;
+			ResourceAccess access;
+			bool write;
+		};
+
+		struct Pass {
+			const char *name;
+			RenderPassRecorder recorder;
+			void *userData;
+			std::vector<PassAccess> accesses;
+
+			// planned by 'compile()', the pass's range of 'm_barriers'.
+			bool culled = false;
+			uint32_t firstBarrier = 0;
+			uint32_t barrierCount = 0;
+		};
+		std::vector<Pass> m_passes;
+		std::vector<uint32_t> m_executionOrder;  // passes that were kept.
+
+		// image handles are filled in by 'execute()', imported images change between frames.
+		std::vector<VkImageMemoryBarrier2> m_barriers;
+		std::vector<uint32_t> m_barrierResources;
+		uint32_t m_finalBarrierFirst = 0;
+		uint32_t m_finalBarrierCount = 0;
+
+		// transient images sharing one allocation, none of their lifetimes overlap.
+		struct MemorySlot {
+			VkMemoryRequirements requirements;
+			std::vector<uint32_t> resources;  // in order of first use.
+			DeviceAllocation allocation;
+		};
+		std::vector<MemorySlot> m_memorySlots;
+
+		void cullPasses();
+		void computeLifetimes();
+		void createTransientImages();
+		void planBarriers();
+		void retireTransientImages(DeletionQueue &deletionQueue, const uint64_t &lastUseValue);
+		void recordBarriers(VkCommandBuffer commandBuffer, const uint32_t &firstBarrier, const uint32_t &barrierCount);
+	};
+
+}  // namespace venus
+
+#endif  // VENUS_RENDER_GRAPH_HPP
@@ -0,0 +1,401 @@
+#include "deviceAllocator.hpp"
+#include "VN_logger.hpp"
+#include "renderConfig.hpp"
+
+// STDLIB
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <format>
+#include <limits>
+#include <stdexcept>
+
+namespace venus {
+
+	class DeviceMemoryBlock {
+	public:
+		DeviceMemoryBlock(VkDeviceMemory memory, void *mappedData, const VkDeviceSize &size, const uint32_t &poolIndex):
+			memory(memory), mappedData(mappedData), poolIndex(poolIndex), ranges(size) {}
+
+		VkDeviceMemory memory;
+		void *mappedData;
+		uint32_t poolIndex;
+		TlsfAllocator ranges;
+	};
+
+	namespace {  // ANONYMOUS NAMESPACE BEGIN
+		struct MemoryTypeRequest {
+			VkMemoryPropertyFlags required;
+			VkMemoryPropertyFlags preferred;
+			VkMemoryPropertyFlags avoided;
+		};
+
+		auto requestFor(const MemoryUsage &usage) -> MemoryTypeRequest {
+			constexpr VkMemoryPropertyFlags HOST_ACCESS =
+				VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+			switch(usage) {
+				case MEMORY_USAGE_GPU_ONLY:
+					return {.required = 0,
+									.preferred = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+									.avoided = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT};
+				case MEMORY_USAGE_UPLOAD:
+					// staging memory is written once and read once by a copy, keep it out of the small device local heaps.
+					return {.required = HOST_ACCESS,
+									.preferred = 0,
+									.avoided = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT | VK_MEMORY_PROPERTY_HOST_CACHED_BIT};
+				case MEMORY_USAGE_DYNAMIC:
+					return {.required = HOST_ACCESS, .preferred = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, .avoided = 0};
+				case MEMORY_USAGE_READBACK:
+					// coherent so gpu writes are visible to the mapping without invalidating, every device has such a type.
+					return {.required = HOST_ACCESS, .preferred = VK_MEMORY_PROPERTY_HOST_CACHED_BIT, .avoided = 0};
+			}
+			return {.required = 0, .preferred = 0, .avoided = 0};
+		}
+
+		auto bitCount(const VkMemoryPropertyFlags &flags) -> int { return std::popcount(flags); }
+	}  // namespace
+	// ANONYMOUS NAMESPACE END
+
+	DeviceAllocator::DeviceAllocator(VkPhysicalDevice physicalDevice, VkDevice device,
+																	 const VkPhysicalDeviceProperties &properties):
+		m_device(device), m_maxMemoryAllocationCount(properties.limits.maxMemoryAllocationCount) {
+		vkGetPhysicalDeviceMemoryProperties(physicalDevice, &m_memoryProperties);
+
+		for(uint32_t typeIndex = 0; typeIndex < m_memoryProperties.memoryTypeCount; ++typeIndex) {
+			const VkDeviceSize heapSize = m_memoryProperties.memoryHeaps[m_memoryProperties.memoryTypes[typeIndex].heapIndex].size;
+			// small heaps, such as the 256 MiB device local and host visible window, would fill up with a few blocks.
+			const VkDeviceSize blockSize =
+				std::min<VkDeviceSize>(DEVICE_MEMORY_BLOCK_SIZE, (heapSize / 8) & ~(TlsfAllocator::GRANULARITY - 1));
+			m_pools[typeIndex * 2 + RESOURCE_TILING_LINEAR].preferredBlockSize = blockSize;
+			m_pools[typeIndex * 2 + RESOURCE_TILING_OPTIMAL].preferredBlockSize = blockSize;
+		}
+
+		VN_LOG_INFO(std::format("Device allocator created over {} memory types and {} heaps.",
+														m_memoryProperties.memoryTypeCount, m_memoryProperties.memoryHeapCount));
+	}
+
+	DeviceAllocator::~DeviceAllocator() {
+		uint32_t leakedCount = m_dedicatedAllocationCount.load(std::memory_order_relaxed);
+		for(Pool &pool : m_pools) {
+			for(const std::unique_ptr<DeviceMemoryBlock> &block : pool.blocks) {
+				leakedCount += block->ranges.getAllocationCount();
+				freeDeviceMemory(block->memory);
+			}
+			pool.blocks.clear();
+		}
+
+		if(leakedCount != 0) {
+			VN_LOG_WARN(std::format("Device allocator destroyed with {} allocations still alive.", leakedCount));
+		}
+		VN_LOG_INFO("Device allocator has been destroyed.");
+	}
+
+	auto DeviceAllocator::allocate(const VkMemoryRequirements &requirements, const DeviceAllocationDetails &details,
+																 const bool &dedicated) -> DeviceAllocation {
+		// without a resource there is nothing to dedicate the memory to, it only gets a device memory object of its own.
+		return allocateInternal(requirements, details, dedicated, nullptr);
+	}
+
+	void DeviceAllocator::free(const DeviceAllocation &allocation) {
+		if(!allocation.isValid()) {
+			return;
+		}
+
+		if(allocation.block == nullptr) {
+			freeDeviceMemory(allocation.memory);
+			m_dedicatedAllocationCount.fetch_sub(1, std::memory_order_relaxed);
+			m_dedicatedBytes.fetch_sub(allocation.size, std::memory_order_relaxed);
+			return;
+		}
+
+		Pool &pool = m_pools[allocation.block->poolIndex];
+		const std::scoped_lock lock(pool.mutex);
+		allocation.block->ranges.free(allocation.node);
+	}
+
+	auto DeviceAllocator::allocateForBuffer(VkBuffer buffer, const DeviceAllocationDetails &details)
+		-> DeviceAllocation {
+		const VkBufferMemoryRequirementsInfo2 requirementsInfo{
+			.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_REQUIREMENTS_INFO_2, .pNext = nullptr, .buffer = buffer};
+		VkMemoryDedicatedRequirements dedicatedRequirements{.sType = VK_STRUCTURE_TYPE_MEMORY_DEDICATED_REQUIREMENTS,
+																												.pNext = nullptr,
+																												.prefersDedicatedAllocation = VK_FALSE,
+																												.requiresDedicatedAllocation = VK_FALSE};
+		VkMemoryRequirements2 requirements{
+			.sType = VK_STRUCTURE_TYPE_MEMORY_REQUIREMENTS_2, .pNext = &dedicatedRequirements, .memoryRequirements = {}};
+		vkGetBufferMemoryRequirements2(m_device, &requirementsInfo, &requirements);
+
+		const VkMemoryDedicatedAllocateInfo dedicatedInfo{.sType = VK_STRUCTURE_TYPE_MEMORY_DEDICATED_ALLOCATE_INFO,
+																											.pNext = nullptr,
+																											.image = VK_NULL_HANDLE,
+																											.buffer = buffer};
+		const bool dedicated = dedicatedRequirements.prefersDedicatedAllocation == VK_TRUE ||
+													 dedicatedRequirements.requiresDedicatedAllocation == VK_TRUE;
+		const DeviceAllocation allocation =
+			allocateInternal(requirements.memoryRequirements, details, dedicated, dedicated ? &dedicatedInfo : nullptr);
+
+		if(vkBindBufferMemory(m_device, buffer, allocation.memory, allocation.offset) != VK_SUCCESS) {
+			free(allocation);
+			VN_LOG_CRITICAL("Failed to bind buffer memory.");
+			throw std::runtime_error("Failed to bind buffer memory.");
+		}
+		return allocation;
+	}
+
+	auto DeviceAllocator::allocateForImage(VkImage image, const DeviceAllocationDetails &details) -> DeviceAllocation {
+		const VkImageMemoryRequirementsInfo2 requirementsInfo{
+			.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_REQUIREMENTS_INFO_2, .pNext = nullptr, .image = image};
+		VkMemoryDedicatedRequirements dedicatedRequirements{.sType = VK_STRUCTURE_TYPE_MEMORY_DEDICATED_REQUIREMENTS,
+																												.pNext = nullptr,
+																												.prefersDedicatedAllocation = VK_FALSE,
+																												.requiresDedicatedAllocation = VK_FALSE};
+		VkMemoryRequirements2 requirements{
+			.sType = VK_STRUCTURE_TYPE_MEMORY_REQUIREMENTS_2, .pNext = &dedicatedRequirements, .memoryRequirements = {}};
+		vkGetImageMemoryRequirements2(m_device, &requirementsInfo, &requirements);
+
+		// render targets are usually reported as preferring their own memory, some drivers compress them only then.
+		const VkMemoryDedicatedAllocateInfo dedicatedInfo{.sType = VK_STRUCTURE_TYPE_MEMORY_DEDICATED_ALLOCATE_INFO,
+																											.pNext = nullptr,
+																											.image = image,
+																											.buffer = VK_NULL_HANDLE};
+		const bool dedicated = dedicatedRequirements.prefersDedicatedAllocation == VK_TRUE ||
+													 dedicatedRequirements.requiresDedicatedAllocation == VK_TRUE;
+		const DeviceAllocation allocation =
+			allocateInternal(requirements.memoryRequirements, details, dedicated, dedicated ? &dedicatedInfo : nullptr);
+
+		if(vkBindImageMemory(m_device, image, allocation.memory, allocation.offset) != VK_SUCCESS) {
+			free(allocation);
+			VN_LOG_CRITICAL("Failed to bind image memory.");
+			throw std::runtime_error("Failed to bind image memory.");
+		}
+		return allocation;
+	}
+
+	auto DeviceAllocator::planDefragmentation(const uint32_t &maxMoves) -> std::vector<DefragmentationMove> {
+		std::vector<DefragmentationMove> moves;
+		for(Pool &pool : m_pools) {
+			if(moves.size() >= maxMoves) {
+				break;
+			}
+
+			const std::scoped_lock lock(pool.mutex);
+			if(pool.blocks.size() < 2) {
+				continue;
+			}
+
+			// the least used block that is not already empty empties with the fewest bytes copied.
+			DeviceMemoryBlock *source = nullptr;
+			for(const std::unique_ptr<DeviceMemoryBlock> &block : pool.blocks) {
+				if(!block->ranges.isEmpty() &&
+					 (source == nullptr || block->ranges.getUsedBytes() < source->ranges.getUsedBytes())) {
+					source = block.get();
+				}
+			}
+			if(source == nullptr) {
+				continue;
+			}
+
+			source->ranges.forEachAllocation([&](const TlsfAllocator::Allocation &range, const uint64_t &alignment,
+																					 void *userData) {
+				if(moves.size() >= maxMoves) {
+					return;
+				}
+				const VkMemoryRequirements requirements{.size = range.size, .alignment = alignment, .memoryTypeBits = 0};
+				const DeviceAllocation destination = allocateFromBlocks(pool, requirements, userData, source);
+				if(!destination.isValid()) {
+					return;
+				}
+
+				void *sourceData =
+					source->mappedData != nullptr ? static_cast<std::byte *>(source->mappedData) + range.offset : nullptr;
+				moves.push_back({.source = {.memory = source->memory,
+																		.offset = range.offset,
+																		.size = range.size,
+																		.mappedData = sourceData,
+																		.block = source,
+																		.node = range.node},
+												 .destination = destination,
+												 .userData = userData});
+			});
+		}
+		return moves;
+	}
+
+	auto DeviceAllocator::releaseEmptyBlocks() -> uint32_t {
+		uint32_t releasedCount = 0;
+		for(Pool &pool : m_pools) {
+			const std::scoped_lock lock(pool.mutex);
+			bool keptOne = false;
+			std::erase_if(pool.blocks, [&](const std::unique_ptr<DeviceMemoryBlock> &block) {
+				if(!block->ranges.isEmpty()) {
+					return false;
+				}
+				if(!keptOne) {
+					keptOne = true;
+					return false;
+				}
+				freeDeviceMemory(block->memory);
+				++releasedCount;
+				return true;
+			});
+		}
+
+		if(releasedCount != 0) {
+			VN_LOG_INFO(std::format("Released {} empty device memory blocks.", releasedCount));
+		}
+		return releasedCount;
+	}
+
+	auto DeviceAllocator::getStatistics() -> DeviceMemoryStatistics {
+		const uint32_t dedicatedCount = m_dedicatedAllocationCount.load(std::memory_order_relaxed);
+		const uint64_t dedicatedBytes = m_dedicatedBytes.load(std::memory_order_relaxed);
+		DeviceMemoryStatistics statistics{.blockCount = 0,
+																			.dedicatedAllocationCount = dedicatedCount,
+																			.allocationCount = dedicatedCount,
+																			.deviceMemoryObjectCount =
+																				m_deviceMemoryObjectCount.load(std::memory_order_relaxed),
+																			.reservedBytes = dedicatedBytes,
+																			.usedBytes = dedicatedBytes};
+		for(Pool &pool : m_pools) {
+			const std::scoped_lock lock(pool.mutex);
+			for(const std::unique_ptr<DeviceMemoryBlock> &block : pool.blocks) {
+				++statistics.blockCount;
+				statistics.allocationCount += block->ranges.getAllocationCount();
+				statistics.reservedBytes += block->ranges.getSize();
+				statistics.usedBytes += block->ranges.getUsedBytes();
+			}
+		}
+		return statistics;
+	}
+
+	auto DeviceAllocator::findMemoryType(const uint32_t &memoryTypeBits, const MemoryUsage &usage) const -> uint32_t {
+		const MemoryTypeRequest request = requestFor(usage);
+		uint32_t bestType = UINT32_MAX;
+		int bestScore = std::numeric_limits<int>::min();
+		for(uint32_t typeIndex = 0; typeIndex < m_memoryProperties.memoryTypeCount; ++typeIndex) {
+			const VkMemoryPropertyFlags flags = m_memoryProperties.memoryTypes[typeIndex].propertyFlags;
+			if((memoryTypeBits & (1U << typeIndex)) == 0 || (flags & request.required) != request.required) {
+				continue;
+			}
+			// lazily allocated memory only backs transient attachments, protected memory needs a protected queue.
+			if((flags & (VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT | VK_MEMORY_PROPERTY_PROTECTED_BIT)) != 0) {
+				continue;
+			}
+
+			// types are listed from fastest to slowest, ties keep the earlier one.
+			const int score = bitCount(flags & request.preferred) - bitCount(flags & request.avoided);
+			if(score > bestScore) {
+				bestScore = score;
+				bestType = typeIndex;
+			}
+		}
+		return bestType;
+	}
+
+	auto DeviceAllocator::allocateInternal(const VkMemoryRequirements &requirements,
+																				 const DeviceAllocationDetails &details, const bool &dedicated,
+																				 const VkMemoryDedicatedAllocateInfo *dedicatedInfo) -> DeviceAllocation {
+		const uint32_t memoryTypeIndex = findMemoryType(requirements.memoryTypeBits, details.usage);
+		if(memoryTypeIndex == UINT32_MAX) {
+			VN_LOG_CRITICAL(std::format("No memory type fits usage {} and type bits {:#x}.",
+																	static_cast<uint32_t>(details.usage), requirements.memoryTypeBits));
+			throw std::runtime_error("No memory type fits the allocation.");
+		}
+
+		const uint32_t poolIndex = memoryTypeIndex * 2 + details.tiling;
+		Pool &pool = m_pools[poolIndex];
+		if(dedicated || requirements.size > pool.preferredBlockSize / 2) {
+			void *mappedData = nullptr;
+			VkDeviceMemory memory = allocateDeviceMemory(requirements.size, memoryTypeIndex, dedicatedInfo, &mappedData);
+			m_dedicatedAllocationCount.fetch_add(1, std::memory_order_relaxed);
+			m_dedicatedBytes.fetch_add(requirements.size, std::memory_order_relaxed);
+			return {.memory = memory,
+							.offset = 0,
+							.size = requirements.size,
+							.mappedData = mappedData,
+							.block = nullptr,
+							.node = TlsfAllocator::NULL_NODE};
+		}
+
+		const std::scoped_lock lock(pool.mutex);
+		DeviceAllocation allocation = allocateFromBlocks(pool, requirements, details.userData, nullptr);
+		if(allocation.isValid()) {
+			return allocation;
+		}
+
+		void *mappedData = nullptr;
+		VkDeviceMemory memory = allocateDeviceMemory(pool.preferredBlockSize, memoryTypeIndex, nullptr, &mappedData);
+		pool.blocks.push_back(std::make_unique<DeviceMemoryBlock>(memory, mappedData, pool.preferredBlockSize, poolIndex));
+		VN_LOG_INFO(std::format("Allocated a {} MiB device memory block from memory type {}.",
+														pool.preferredBlockSize / (1024 * 1024), memoryTypeIndex));
+
+		// the request is at most half a block, a fresh block always fits it.
+		return allocateFromBlocks(pool, requirements, details.userData, nullptr);
+	}
+
+	auto DeviceAllocator::allocateDeviceMemory(const VkDeviceSize &size, const uint32_t &memoryTypeIndex,
+																						 const void *pNext, void **mappedData) -> VkDeviceMemory {
+		if(m_deviceMemoryObjectCount.fetch_add(1, std::memory_order_relaxed) >= m_maxMemoryAllocationCount) {
+			m_deviceMemoryObjectCount.fetch_sub(1, std::memory_order_relaxed);
+			VN_LOG_CRITICAL(std::format("Device memory allocation limit of {} reached.", m_maxMemoryAllocationCount));
+			throw std::runtime_error("Device memory allocation limit reached.");
+		}
+
+		// any buffer in the memory may be read through its device address, shaders reach per-frame data that way.
+		const VkMemoryAllocateFlagsInfo flagsInfo{.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_FLAGS_INFO,
+																							.pNext = pNext,
+																							.flags = VK_MEMORY_ALLOCATE_DEVICE_ADDRESS_BIT,
+																							.deviceMask = 0};
+		const VkMemoryAllocateInfo allocateInfo{.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
+																						.pNext = &flagsInfo,
+																						.allocationSize = size,
+																						.memoryTypeIndex = memoryTypeIndex};
+		VkDeviceMemory memory = VK_NULL_HANDLE;
+		if(vkAllocateMemory(m_device, &allocateInfo, nullptr, &memory) != VK_SUCCESS) {
+			m_deviceMemoryObjectCount.fetch_sub(1, std::memory_order_relaxed);
+			VN_LOG_CRITICAL(std::format("Failed to allocate {} bytes of device memory from memory type {}.", size,
+																	memoryTypeIndex));
+			throw std::runtime_error("Failed to allocate device memory.");
+		}
+
+		*mappedData = nullptr;
+		if((m_memoryProperties.memoryTypes[memoryTypeIndex].propertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) != 0 &&
+			 vkMapMemory(m_device, memory, 0, VK_WHOLE_SIZE, 0, mappedData) != VK_SUCCESS) {
+			freeDeviceMemory(memory);
+			VN_LOG_CRITICAL("Failed to map host visible device memory.");
+			throw std::runtime_error("Failed to map host visible device memory.");
+		}
+		return memory;
+	}
+
+	void DeviceAllocator::freeDeviceMemory(VkDeviceMemory memory) {
+		// freeing memory implicitly unmaps it.
+		vkFreeMemory(m_device, memory, nullptr);
+		m_deviceMemoryObjectCount.fetch_sub(1, std::memory_order_relaxed);
+	}
+
+	auto DeviceAllocator::allocateFromBlocks(Pool &pool, const VkMemoryRequirements &requirements, void *userData,
+																					 const DeviceMemoryBlock *excludedBlock) -> DeviceAllocation {
+		for(const std::unique_ptr<DeviceMemoryBlock> &block : pool.blocks) {
+			if(block.get() == excludedBlock) {
+				continue;
+			}
+			const std::optional<TlsfAllocator::Allocation> range =
+				block->ranges.allocate(requirements.size, requirements.alignment, userData);
+			if(!range.has_value()) {
+				continue;
+			}
+
+			void *mappedData =
+				block->mappedData != nullptr ? static_cast<std::byte *>(block->mappedData) + range->offset : nullptr;
+			return {.memory = block->memory,
+							.offset = range->offset,
+							.size = range->size,
+							.mappedData = mappedData,
+							.block = block.get(),
+							.node = range->node};
+		}
+		return {};
+	}
+
+}  // namespace venus
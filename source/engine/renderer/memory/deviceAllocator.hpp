@@ -0,0 +1,158 @@
+#ifndef VENUS_DEVICE_ALLOCATOR_HPP
+#define VENUS_DEVICE_ALLOCATOR_HPP
+
+// PROJECT
+#include "tlsfAllocator.hpp"
+
+// THIRD PARTY
+#include "volk.h"
+
+// STDLIB
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace venus {
+
+	// What the cpu does with the memory, decides the memory type an allocation is placed in.
+	enum MemoryUsage : uint8_t {
+		MEMORY_USAGE_GPU_ONLY = 0,  // device local, never mapped.
+		MEMORY_USAGE_UPLOAD = 1,  // host visible and coherent, preferably system memory, for staging data to the gpu.
+		MEMORY_USAGE_DYNAMIC = 2,  // host visible and coherent, preferably device local, rewritten by the cpu every frame.
+		MEMORY_USAGE_READBACK = 3  // host visible and coherent, preferably cached, for reading results back.
+	};
+
+	// Buffers and linear images must not share a page with optimal images (bufferImageGranularity), so they get pools
+	// of their own.
+	enum ResourceTiling : uint8_t { RESOURCE_TILING_LINEAR = 0, RESOURCE_TILING_OPTIMAL = 1 };
+
+	struct DeviceAllocationDetails {
+		MemoryUsage usage;
+		ResourceTiling tiling;
+		void *userData = nullptr;  // handed back by defragmentation so the owner can find the resource to move.
+	};
+
+	class DeviceMemoryBlock;
+	struct DeviceAllocation {
+		VkDeviceMemory memory = VK_NULL_HANDLE;
+		VkDeviceSize offset = 0;
+		VkDeviceSize size = 0;
+		void *mappedData = nullptr;  // already offset, null unless the memory is host visible.
+
+		DeviceMemoryBlock *block = nullptr;  // null for dedicated allocations.
+		uint32_t node = TlsfAllocator::NULL_NODE;
+
+		[[nodiscard]] auto isValid() const -> bool { return memory != VK_NULL_HANDLE; }
+	};
+
+	struct DeviceMemoryStatistics {
+		uint32_t blockCount;
+		uint32_t dedicatedAllocationCount;
+		uint32_t allocationCount;  // sub-allocations and dedicated allocations.
+		uint32_t deviceMemoryObjectCount;  // counted against maxMemoryAllocationCount.
+		uint64_t reservedBytes;  // all device memory the allocator holds.
+		uint64_t usedBytes;
+	};
+
+	// One allocation to move out of a sparsely used block, see 'DeviceAllocator::planDefragmentation()'.
+	struct DefragmentationMove {
+		DeviceAllocation source;
+		DeviceAllocation destination;
+		void *userData;
+	};
+
+	/**
+   * @brief Sub-allocates device memory for buffers and images.
+   *
+   * @details Memory is allocated from the driver in large blocks and handed out in pieces by a TlsfAllocator per block,
+   *          so thousands of resources only cost a handful of vkAllocateMemory calls and stay far from
+   *          maxMemoryAllocationCount. Requests larger than half a block, and resources the driver prefers to own
+   *          their memory, get a dedicated allocation instead.
+   *
+   *          Memory types are picked from the device's memory properties by MemoryUsage. There is one pool of blocks per
+   *          memory type and ResourceTiling, each pool has its own lock held only for the constant time TLSF operation,
+   *          allocating and freeing are thread safe. Host visible blocks are mapped once when created and stay mapped.
+   *
+   *          Emptied blocks are kept for reuse so a resource churning across a block boundary does not allocate from
+   *          the driver every time, 'releaseEmptyBlocks()' returns them. Defragmentation is driven by the owners of
+   *          the resources, the allocator only plans which allocations to move, see 'planDefragmentation()'.
+   *
+   *          Freed memory may still be in use by the gpu, retire frees through the DeletionQueue.
+   *
+   *          This object cannot be copied. This object cannot be moved.
+   */
+	class DeviceAllocator {
+	public:
+		explicit DeviceAllocator(VkPhysicalDevice physicalDevice, VkDevice device,
+														 const VkPhysicalDeviceProperties &properties);
+		~DeviceAllocator();
+
+		DeviceAllocator(const DeviceAllocator &) = delete;
+		auto operator=(const DeviceAllocator &) -> DeviceAllocator & = delete;
+
+		DeviceAllocator(const DeviceAllocator &&) = delete;
+		auto operator=(const DeviceAllocator &&) -> DeviceAllocator & = delete;
+
+		// Throws when no memory type fits or the device is out of memory. A 'dedicated' allocation gets a device memory
+		// object of its own, the allocateFor functions also tell the driver which resource it is for.
+		[[nodiscard]] auto allocate(const VkMemoryRequirements &requirements, const DeviceAllocationDetails &details,
+																const bool &dedicated = false) -> DeviceAllocation;
+		void free(const DeviceAllocation &allocation);
+
+		// Allocate memory for the resource, honouring the driver's dedicated allocation preference, and bind it.
+		[[nodiscard]] auto allocateForBuffer(VkBuffer buffer, const DeviceAllocationDetails &details) -> DeviceAllocation;
+		[[nodiscard]] auto allocateForImage(VkImage image, const DeviceAllocationDetails &details) -> DeviceAllocation;
+
+		/**
+     * @brief Plans moving allocations out of the least used block of every pool with more than one block.
+     *
+     * @details Destinations are already allocated in the pool's other blocks. For each move the owner found through
+     *          'userData' copies its data, recreates and binds its resource at the destination and then frees the
+     *          source once the gpu is done with it. The emptied block is returned by 'releaseEmptyBlocks()'.
+     *          At most 'maxMoves' moves are planned, fewer when the other blocks run out of room.
+     */
+		[[nodiscard]] auto planDefragmentation(const uint32_t &maxMoves) -> std::vector<DefragmentationMove>;
+
+		// Frees every empty block except one per pool, returns how many were freed.
+		auto releaseEmptyBlocks() -> uint32_t;
+
+		[[nodiscard]] auto getStatistics() -> DeviceMemoryStatistics;
+
+	private:
+		VkDevice m_device = VK_NULL_HANDLE;
+		VkPhysicalDeviceMemoryProperties m_memoryProperties{};
+		uint32_t m_maxMemoryAllocationCount = 0;
+
+		struct Pool {
+			std::mutex mutex;
+			std::vector<std::unique_ptr<DeviceMemoryBlock>> blocks;
+			VkDeviceSize preferredBlockSize = 0;
+		};
+		std::array<Pool, VK_MAX_MEMORY_TYPES * 2> m_pools;
+
+		std::atomic<uint32_t> m_deviceMemoryObjectCount = 0;
+		std::atomic<uint32_t> m_dedicatedAllocationCount = 0;
+		std::atomic<uint64_t> m_dedicatedBytes = 0;
+
+		[[nodiscard]] auto findMemoryType(const uint32_t &memoryTypeBits, const MemoryUsage &usage) const -> uint32_t;
+		// 'dedicatedInfo' is chained to the allocation when set, only dedicated allocations may name their resource.
+		[[nodiscard]] auto allocateInternal(const VkMemoryRequirements &requirements, const DeviceAllocationDetails &details,
+																				const bool &dedicated, const VkMemoryDedicatedAllocateInfo *dedicatedInfo)
+			-> DeviceAllocation;
+
+		// vkAllocateMemory plus a persistent mapping for host visible types, counted against maxMemoryAllocationCount.
+		[[nodiscard]] auto allocateDeviceMemory(const VkDeviceSize &size, const uint32_t &memoryTypeIndex,
+																						const void *pNext, void **mappedData) -> VkDeviceMemory;
+		void freeDeviceMemory(VkDeviceMemory memory);
+
+		// the pool's lock must be held, returns an invalid allocation when no existing block has room.
+		[[nodiscard]] static auto allocateFromBlocks(Pool &pool, const VkMemoryRequirements &requirements, void *userData,
+																								 const DeviceMemoryBlock *excludedBlock) -> DeviceAllocation;
+	};
+
+}  // namespace venus
+
+#endif  // VENUS_DEVICE_ALLOCATOR_HPP
@@ -0,0 +1,99 @@
+#include "frameDataRing.hpp"
+#include "VN_logger.hpp"
+#include "logicalDevice.hpp"
+
+// STDLIB
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <format>
+#include <stdexcept>
+
+namespace venus {
+	namespace {  // ANONYMOUS NAMESPACE BEGIN
+		// shaders read the data through buffer references aligned to a vec4.
+		constexpr VkDeviceSize MIN_SHADER_ALIGNMENT = 16;
+
+		constexpr auto alignUp(const VkDeviceSize &value, const VkDeviceSize &alignment) -> VkDeviceSize {
+			return (value + alignment - 1) & ~(alignment - 1);
+		}
+	}  // namespace
+	// ANONYMOUS NAMESPACE END
+
+	FrameDataRing::FrameDataRing(const std::shared_ptr<LogicalDevice> &logicalDevicePtr,
+															 std::span<const uint32_t> sharingFamilies):
+		m_logicalDevice(logicalDevicePtr) {
+		m_minAlignment = std::max<VkDeviceSize>(
+			m_logicalDevice->physicalDeviceProperties().limits.minUniformBufferOffsetAlignment, MIN_SHADER_ALIGNMENT);
+
+		const bool concurrent = sharingFamilies.size() > 1;
+		const VkBufferCreateInfo bufferInfo{.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+																				.pNext = nullptr,
+																				.flags = 0,
+																				.size = FRAME_DATA_RING_SIZE * MAX_FRAMES_IN_FLIGHT,
+																				.usage = VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT |
+																								 VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
+																				.sharingMode = concurrent ? VK_SHARING_MODE_CONCURRENT : VK_SHARING_MODE_EXCLUSIVE,
+																				.queueFamilyIndexCount = concurrent ? static_cast<uint32_t>(sharingFamilies.size()) : 0,
+																				.pQueueFamilyIndices = concurrent ? sharingFamilies.data() : nullptr};
+
+		if(vkCreateBuffer(m_logicalDevice->getHandle(), &bufferInfo, nullptr, &m_buffer) != VK_SUCCESS) {
+			VN_LOG_CRITICAL("Failed to create frame data ring.");
+			throw std::runtime_error("Failed to create frame data ring.");
+		}
+
+		m_allocation = m_logicalDevice->getDeviceAllocator().allocateForBuffer(
+			m_buffer, {.usage = MEMORY_USAGE_DYNAMIC, .tiling = RESOURCE_TILING_LINEAR});
+		m_mappedData = static_cast<std::byte *>(m_allocation.mappedData);
+
+		const VkBufferDeviceAddressInfo addressInfo{
+			.sType = VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO, .pNext = nullptr, .buffer = m_buffer};
+		m_bufferAddress = vkGetBufferDeviceAddress(m_logicalDevice->getHandle(), &addressInfo);
+
+		VN_LOG_INFO(std::format("Frame data ring created with {} KiB per frame, aligned to {} bytes.",
+														FRAME_DATA_RING_SIZE / 1024, m_minAlignment));
+	}
+
+	FrameDataRing::~FrameDataRing() {
+		vkDestroyBuffer(m_logicalDevice->getHandle(), m_buffer, nullptr);
+		m_logicalDevice->getDeviceAllocator().free(m_allocation);
+
+		VN_LOG_INFO("Frame data ring has been destroyed.");
+	}
+
+	void FrameDataRing::beginFrame(const uint32_t &frameIndex) {
+		m_frameBase = static_cast<VkDeviceSize>(frameIndex) * FRAME_DATA_RING_SIZE;
+		m_frameHead.store(0, std::memory_order_relaxed);
+	}
+
+	auto FrameDataRing::allocate(const VkDeviceSize &size, const VkDeviceSize &alignment)
+		-> std::optional<FrameAllocation> {
+		assert((alignment & (alignment - 1)) == 0);
+		const VkDeviceSize rangeAlignment = std::max(alignment, m_minAlignment);
+
+		VkDeviceSize head = m_frameHead.load(std::memory_order_relaxed);
+		VkDeviceSize offset = 0;
+		do {
+			offset = alignUp(head, rangeAlignment);
+			if(offset + size > FRAME_DATA_RING_SIZE) {
+				return std::nullopt;
+			}
+		} while(!m_frameHead.compare_exchange_weak(head, offset + size, std::memory_order_relaxed));
+
+		const VkDeviceSize bufferOffset = m_frameBase + offset;
+		return FrameAllocation{.mappedData = m_mappedData + bufferOffset,
+													 .offset = bufferOffset,
+													 .address = m_bufferAddress + bufferOffset,
+													 .size = size};
+	}
+
+	auto FrameDataRing::write(std::span<const std::byte> data, const VkDeviceSize &alignment)
+		-> std::optional<FrameAllocation> {
+		const std::optional<FrameAllocation> allocation = allocate(data.size(), alignment);
+		if(allocation.has_value()) {
+			std::memcpy(allocation->mappedData, data.data(), data.size());
+		}
+		return allocation;
+	}
+
+}  // namespace venus
@@ -0,0 +1,95 @@
+#ifndef VENUS_FRAME_DATA_RING_HPP
+#define VENUS_FRAME_DATA_RING_HPP
+
+// PROJECT
+#include "deviceAllocator.hpp"
+#include "renderConfig.hpp"
+
+// THIRD PARTY
+#include "volk.h"
+
+// STDLIB
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+
+namespace venus {
+	class LogicalDevice;
+
+	// A range of the frame's data, valid until the same frame slot comes around again.
+	struct FrameAllocation {
+		void *mappedData = nullptr;
+		VkDeviceSize offset = 0;  // from the start of 'FrameDataRing::getBuffer()', usable as a dynamic offset.
+		VkDeviceAddress address = 0;
+		VkDeviceSize size = 0;
+	};
+
+	/**
+   * @brief Linear allocator for data the gpu reads during one frame only, camera matrices, per-draw data and the like.
+   *
+   * @details One persistently mapped, host coherent buffer holds a region of FRAME_DATA_RING_SIZE bytes per frame in
+   *          flight. 'beginFrame()' rewinds the frame's region, allocating bumps a pointer through it, so writing
+   *          constants costs a pointer bump and one memcpy, and no Vulkan object is created while frames run.
+   *          Being coherent, the writes need no flush and are visible to any submission made after them.
+   *
+   *          Allocations start on minUniformBufferOffsetAlignment or a larger requested power of two, so an offset can
+   *          be passed as the dynamic offset of a uniform buffer descriptor. Shaders in this renderer take the device
+   *          address instead, through their push constants.
+   *
+   *          The buffer is shared by the families in 'sharingFamilies', see ComputeQueue::getSharingFamilies().
+   *
+   *          Allocating is lock free and safe from any thread between 'beginFrame()' calls.
+   *
+   *          This object cannot be copied. This object cannot be moved.
+   */
+	class FrameDataRing {
+	public:
+		explicit FrameDataRing(const std::shared_ptr<LogicalDevice> &logicalDevicePtr,
+													 std::span<const uint32_t> sharingFamilies);
+		~FrameDataRing();
+
+		FrameDataRing(const FrameDataRing &) = delete;
+		auto operator=(const FrameDataRing &) -> FrameDataRing & = delete;
+
+		FrameDataRing(const FrameDataRing &&) = delete;
+		auto operator=(const FrameDataRing &&) -> FrameDataRing & = delete;
+
+		// Render thread only, once the graphics timeline reached the value the frame slot was last submitted with and
+		// before anything is allocated for the frame. Everything allocated the last time the slot was used is dropped.
+		void beginFrame(const uint32_t &frameIndex);
+
+		// Any thread. Nothing when the frame's region has no room left, 'alignment' must be a power of two.
+		[[nodiscard]] auto allocate(const VkDeviceSize &size, const VkDeviceSize &alignment = 0)
+			-> std::optional<FrameAllocation>;
+
+		// Any thread, allocates and copies 'data' in.
+		[[nodiscard]] auto write(std::span<const std::byte> data, const VkDeviceSize &alignment = 0)
+			-> std::optional<FrameAllocation>;
+
+		template<typename T>
+		[[nodiscard]] auto write(const T &value) -> std::optional<FrameAllocation> {
+			return write(std::as_bytes(std::span(&value, 1)), alignof(T));
+		}
+
+		[[nodiscard]] auto getBuffer() const -> VkBuffer { return m_buffer; }
+
+	private:
+		std::shared_ptr<LogicalDevice> m_logicalDevice;
+		VkBuffer m_buffer = VK_NULL_HANDLE;
+		DeviceAllocation m_allocation;
+		std::byte *m_mappedData = nullptr;
+		VkDeviceAddress m_bufferAddress = 0;
+		VkDeviceSize m_minAlignment = 0;
+
+		// start of the current frame's region, only changed by 'beginFrame()'.
+		VkDeviceSize m_frameBase = 0;
+		// bytes of the current frame's region handed out so far.
+		std::atomic<VkDeviceSize> m_frameHead = 0;
+	};
+
+}  // namespace venus
+
+#endif  // VENUS_FRAME_DATA_RING_HPP
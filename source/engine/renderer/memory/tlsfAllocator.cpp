@@ -0,0 +1,244 @@
+#include "tlsfAllocator.hpp"
+
+// STDLIB
+#include <algorithm>
+#include <bit>
+
+namespace venus {
+	namespace {  // ANONYMOUS NAMESPACE BEGIN
+		constexpr uint32_t GRANULARITY_SHIFT = std::countr_zero(TlsfAllocator::GRANULARITY);
+
+		struct ListIndex {
+			uint32_t firstLevel;
+			uint32_t secondLevel;
+		};
+
+		auto alignUp(const uint64_t &value, const uint64_t &alignment) -> uint64_t {
+			return (value + alignment - 1) & ~(alignment - 1);
+		}
+
+		// index of the highest set bit, 'value' must not be zero.
+		auto highestBit(const uint64_t &value) -> uint32_t { return 63U - static_cast<uint32_t>(std::countl_zero(value)); }
+
+		// the list a free range of 'size' belongs to.
+		template<uint32_t SECOND_LEVEL_BITS>
+		auto listFor(const uint64_t &size) -> ListIndex {
+			constexpr uint64_t LINEAR_LIMIT = TlsfAllocator::GRANULARITY << SECOND_LEVEL_BITS;
+			if(size < LINEAR_LIMIT) {
+				return {.firstLevel = 0, .secondLevel = static_cast<uint32_t>(size >> GRANULARITY_SHIFT)};
+			}
+			const uint32_t topBit = highestBit(size);
+			return {.firstLevel = topBit - (GRANULARITY_SHIFT + SECOND_LEVEL_BITS) + 1,
+							.secondLevel = static_cast<uint32_t>((size >> (topBit - SECOND_LEVEL_BITS)) ^ (1ULL << SECOND_LEVEL_BITS))};
+		}
+
+		// the first list whose every range is at least 'size', found by rounding up to the next list boundary.
+		template<uint32_t SECOND_LEVEL_BITS>
+		auto searchListFor(const uint64_t &size) -> ListIndex {
+			constexpr uint64_t LINEAR_LIMIT = TlsfAllocator::GRANULARITY << SECOND_LEVEL_BITS;
+			if(size < LINEAR_LIMIT) {
+				return listFor<SECOND_LEVEL_BITS>(size);
+			}
+			const uint64_t listSpan = 1ULL << (highestBit(size) - SECOND_LEVEL_BITS);
+			return listFor<SECOND_LEVEL_BITS>(size + listSpan - 1);
+		}
+	}  // namespace
+	// ANONYMOUS NAMESPACE END
+
+	TlsfAllocator::TlsfAllocator(const uint64_t &size): m_size(size & ~(GRANULARITY - 1)) {
+		for(auto &heads : m_freeHeads) {
+			heads.fill(NULL_NODE);
+		}
+		if(m_size == 0) {
+			return;
+		}
+
+		m_firstNode = createNode();
+		m_nodes[m_firstNode] = {.offset = 0,
+														.size = m_size,
+														.alignment = GRANULARITY,
+														.userData = nullptr,
+														.previousPhysical = NULL_NODE,
+														.nextPhysical = NULL_NODE,
+														.previousFree = NULL_NODE,
+														.nextFree = NULL_NODE,
+														.isFree = true};
+		insertFree(m_firstNode);
+	}
+
+	auto TlsfAllocator::allocate(const uint64_t &size, const uint64_t &alignment, void *userData)
+		-> std::optional<Allocation> {
+		const uint64_t allocationSize = alignUp(std::max<uint64_t>(size, 1), GRANULARITY);
+		const uint64_t rangeAlignment = std::max(alignment, GRANULARITY);
+		// a larger alignment may need up to 'alignment - GRANULARITY' bytes in front of the aligned offset.
+		const uint64_t searchSize = allocationSize + (rangeAlignment - GRANULARITY);
+		if(searchSize > m_size) {
+			return std::nullopt;
+		}
+
+		const uint32_t node = findFree(searchSize);
+		if(node == NULL_NODE) {
+			return std::nullopt;
+		}
+		removeFree(node);
+
+		const uint64_t padding = alignUp(m_nodes[node].offset, rangeAlignment) - m_nodes[node].offset;
+		if(padding > 0) {
+			// the node was free so its neighbours are not, the split off head needs no merging.
+			const uint32_t head = createNode();
+			Node &current = m_nodes[node];
+			m_nodes[head] = {.offset = current.offset,
+											 .size = padding,
+											 .alignment = GRANULARITY,
+											 .userData = nullptr,
+											 .previousPhysical = current.previousPhysical,
+											 .nextPhysical = node,
+											 .previousFree = NULL_NODE,
+											 .nextFree = NULL_NODE,
+											 .isFree = true};
+			if(current.previousPhysical != NULL_NODE) {
+				m_nodes[current.previousPhysical].nextPhysical = head;
+			} else {
+				m_firstNode = head;
+			}
+			current.previousPhysical = head;
+			current.offset += padding;
+			current.size -= padding;
+			insertFree(head);
+		}
+
+		if(m_nodes[node].size > allocationSize) {
+			const uint32_t tail = createNode();
+			Node &current = m_nodes[node];
+			m_nodes[tail] = {.offset = current.offset + allocationSize,
+											 .size = current.size - allocationSize,
+											 .alignment = GRANULARITY,
+											 .userData = nullptr,
+											 .previousPhysical = node,
+											 .nextPhysical = current.nextPhysical,
+											 .previousFree = NULL_NODE,
+											 .nextFree = NULL_NODE,
+											 .isFree = true};
+			if(current.nextPhysical != NULL_NODE) {
+				m_nodes[current.nextPhysical].previousPhysical = tail;
+			}
+			current.nextPhysical = tail;
+			current.size = allocationSize;
+			insertFree(tail);
+		}
+
+		Node &allocated = m_nodes[node];
+		allocated.isFree = false;
+		allocated.alignment = rangeAlignment;
+		allocated.userData = userData;
+		m_usedBytes += allocated.size;
+		++m_allocationCount;
+		return Allocation{.offset = allocated.offset, .size = allocated.size, .node = node};
+	}
+
+	void TlsfAllocator::free(const uint32_t &node) {
+		uint32_t merged = node;
+		m_usedBytes -= m_nodes[merged].size;
+		--m_allocationCount;
+		m_nodes[merged].isFree = true;
+		m_nodes[merged].userData = nullptr;
+
+		const uint32_t previous = m_nodes[merged].previousPhysical;
+		if(previous != NULL_NODE && m_nodes[previous].isFree) {
+			removeFree(previous);
+			m_nodes[previous].size += m_nodes[merged].size;
+			m_nodes[previous].nextPhysical = m_nodes[merged].nextPhysical;
+			if(m_nodes[merged].nextPhysical != NULL_NODE) {
+				m_nodes[m_nodes[merged].nextPhysical].previousPhysical = previous;
+			}
+			releaseNode(merged);
+			merged = previous;
+		}
+
+		const uint32_t next = m_nodes[merged].nextPhysical;
+		if(next != NULL_NODE && m_nodes[next].isFree) {
+			removeFree(next);
+			m_nodes[merged].size += m_nodes[next].size;
+			m_nodes[merged].nextPhysical = m_nodes[next].nextPhysical;
+			if(m_nodes[next].nextPhysical != NULL_NODE) {
+				m_nodes[m_nodes[next].nextPhysical].previousPhysical = merged;
+			}
+			releaseNode(next);
+		}
+
+		insertFree(merged);
+	}
+
+	auto TlsfAllocator::createNode() -> uint32_t {
+		if(!m_unusedNodes.empty()) {
+			const uint32_t node = m_unusedNodes.back();
+			m_unusedNodes.pop_back();
+			return node;
+		}
+		m_nodes.emplace_back();
+		return static_cast<uint32_t>(m_nodes.size() - 1);
+	}
+
+	void TlsfAllocator::releaseNode(const uint32_t &node) { m_unusedNodes.push_back(node); }
+
+	void TlsfAllocator::insertFree(const uint32_t &node) {
+		const ListIndex list = listFor<SECOND_LEVEL_BITS>(m_nodes[node].size);
+		uint32_t &head = m_freeHeads[list.firstLevel][list.secondLevel];
+
+		m_nodes[node].previousFree = NULL_NODE;
+		m_nodes[node].nextFree = head;
+		if(head != NULL_NODE) {
+			m_nodes[head].previousFree = node;
+		}
+		head = node;
+
+		m_firstLevelBitmap |= 1ULL << list.firstLevel;
+		m_secondLevelBitmaps[list.firstLevel] |= 1U << list.secondLevel;
+	}
+
+	void TlsfAllocator::removeFree(const uint32_t &node) {
+		const Node &current = m_nodes[node];
+		if(current.previousFree != NULL_NODE) {
+			m_nodes[current.previousFree].nextFree = current.nextFree;
+		}
+		if(current.nextFree != NULL_NODE) {
+			m_nodes[current.nextFree].previousFree = current.previousFree;
+		}
+
+		const ListIndex list = listFor<SECOND_LEVEL_BITS>(current.size);
+		uint32_t &head = m_freeHeads[list.firstLevel][list.secondLevel];
+		if(head == node) {
+			head = current.nextFree;
+			if(head == NULL_NODE) {
+				m_secondLevelBitmaps[list.firstLevel] &= ~(1U << list.secondLevel);
+				if(m_secondLevelBitmaps[list.firstLevel] == 0) {
+					m_firstLevelBitmap &= ~(1ULL << list.firstLevel);
+				}
+			}
+		}
+	}
+
+	auto TlsfAllocator::findFree(const uint64_t &size) const -> uint32_t {
+		ListIndex list = searchListFor<SECOND_LEVEL_BITS>(size);
+		if(list.firstLevel >= FIRST_LEVEL_COUNT) {
+			return NULL_NODE;
+		}
+
+		uint32_t secondLevelMap = m_secondLevelBitmaps[list.firstLevel] & (~0U << list.secondLevel);
+		if(secondLevelMap == 0) {
+			const uint64_t firstLevelMap =
+				list.firstLevel + 1 < 64 ? m_firstLevelBitmap & (~0ULL << (list.firstLevel + 1)) : 0;
+			if(firstLevelMap == 0) {
+				// rounding up skips the list 'size' itself falls in, its head may still fit, as after freeing everything.
+				const ListIndex exactList = listFor<SECOND_LEVEL_BITS>(size);
+				const uint32_t head = m_freeHeads[exactList.firstLevel][exactList.secondLevel];
+				return head != NULL_NODE && m_nodes[head].size >= size ? head : NULL_NODE;
+			}
+			list.firstLevel = static_cast<uint32_t>(std::countr_zero(firstLevelMap));
+			secondLevelMap = m_secondLevelBitmaps[list.firstLevel];
+		}
+		list.secondLevel = static_cast<uint32_t>(std::countr_zero(secondLevelMap));
+		return m_freeHeads[list.firstLevel][list.secondLevel];
+	}
+
+}  // namespace venus
@@ -0,0 +1,115 @@
+#ifndef VENUS_TLSF_ALLOCATOR_HPP
+#define VENUS_TLSF_ALLOCATOR_HPP
+
+// STDLIB
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace venus {
+
+	/**
+   * @brief Two level segregated fit allocator over an abstract range of bytes.
+   *
+   * @details Manages offsets into [0, size) without touching any memory itself, the DeviceAllocator places one over every
+   *          VkDeviceMemory block. Free ranges are kept in lists segregated by a first level power of two and a second
+   *          level linear subdivision of it, two bitmaps find a list whose every range fits in constant time.
+   *          Allocating splits the range found, freeing merges it with free physical neighbours, both are O(1).
+   *
+   *          Offsets and sizes are multiples of GRANULARITY, so alignments up to it cost nothing. Larger power of two
+   *          alignments search for a range with room to spare and split the unaligned head off as a free range.
+   *
+   *          Ranges are described by nodes recycled through an internal free list, the node array only grows while the
+   *          number of live ranges reaches a new high.
+   *
+   *          Not thread safe. This object cannot be copied. This object cannot be moved.
+   */
+	class TlsfAllocator {
+	public:
+		static constexpr uint64_t GRANULARITY = 256;
+		static constexpr uint32_t NULL_NODE = UINT32_MAX;
+
+		struct Allocation {
+			uint64_t offset;
+			uint64_t size;  // may exceed the requested size, it is rounded up to GRANULARITY.
+			uint32_t node;
+		};
+
+		// 'size' is rounded down to GRANULARITY.
+		explicit TlsfAllocator(const uint64_t &size);
+		~TlsfAllocator() = default;
+
+		TlsfAllocator(const TlsfAllocator &) = delete;
+		auto operator=(const TlsfAllocator &) -> TlsfAllocator & = delete;
+
+		TlsfAllocator(const TlsfAllocator &&) = delete;
+		auto operator=(const TlsfAllocator &&) -> TlsfAllocator & = delete;
+
+		// 'alignment' must be a power of two. Nothing when no free range fits.
+		[[nodiscard]] auto allocate(const uint64_t &size, const uint64_t &alignment, void *userData = nullptr)
+			-> std::optional<Allocation>;
+		void free(const uint32_t &node);
+
+		// Calls 'func(const Allocation &, uint64_t alignment, void *userData)' for every live allocation in offset order.
+		template<typename Func>
+		void forEachAllocation(const Func &func) const;
+
+		[[nodiscard]] auto getSize() const -> uint64_t { return m_size; }
+		[[nodiscard]] auto getUsedBytes() const -> uint64_t { return m_usedBytes; }
+		[[nodiscard]] auto getAllocationCount() const -> uint32_t { return m_allocationCount; }
+		[[nodiscard]] auto isEmpty() const -> bool { return m_allocationCount == 0; }
+
+	private:
+		static constexpr uint32_t SECOND_LEVEL_BITS = 5;
+		static constexpr uint32_t SECOND_LEVEL_COUNT = 1U << SECOND_LEVEL_BITS;
+		// level zero covers every size below GRANULARITY * SECOND_LEVEL_COUNT linearly, each further level one power of two.
+		static constexpr uint32_t FIRST_LEVEL_COUNT =
+			64 - static_cast<uint32_t>(std::countr_zero(GRANULARITY)) - SECOND_LEVEL_BITS + 1;
+
+		struct Node {
+			uint64_t offset;
+			uint64_t size;
+			uint64_t alignment;
+			void *userData;
+			uint32_t previousPhysical;
+			uint32_t nextPhysical;
+			uint32_t previousFree;
+			uint32_t nextFree;
+			bool isFree;
+		};
+
+		uint64_t m_size = 0;
+		uint64_t m_usedBytes = 0;
+		uint32_t m_allocationCount = 0;
+		uint32_t m_firstNode = NULL_NODE;
+
+		std::vector<Node> m_nodes;
+		std::vector<uint32_t> m_unusedNodes;
+
+		uint64_t m_firstLevelBitmap = 0;
+		std::array<uint32_t, FIRST_LEVEL_COUNT> m_secondLevelBitmaps{};
+		std::array<std::array<uint32_t, SECOND_LEVEL_COUNT>, FIRST_LEVEL_COUNT> m_freeHeads{};
+
+		[[nodiscard]] auto createNode() -> uint32_t;
+		void releaseNode(const uint32_t &node);
+		void insertFree(const uint32_t &node);
+		void removeFree(const uint32_t &node);
+		[[nodiscard]] auto findFree(const uint64_t &size) const -> uint32_t;
+	};
+
+	template<typename Func>
+	void TlsfAllocator::forEachAllocation(const Func &func) const {
+		for(uint32_t node = m_firstNode; node != NULL_NODE; node = m_nodes[node].nextPhysical) {
+			const Node &current = m_nodes[node];
+			if(!current.isFree) {
+				func(Allocation{.offset = current.offset, .size = current.size, .node = node}, current.alignment,
+						 current.userData);
+			}
+		}
+	}
+
+}  // namespace venus
+
+#endif  // VENUS_TLSF_ALLOCATOR_HPP
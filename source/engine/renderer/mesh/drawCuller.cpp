@@ -0,0 +1,176 @@
+#include "drawCuller.hpp"
+#include "VN_logger.hpp"
+#include "computePipeline.hpp"
+#include "deletionQueue.hpp"
+#include "logicalDevice.hpp"
+
+// STDLIB
+#include <exception>
+#include <format>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace venus {
+	namespace {  // ANONYMOUS NAMESPACE BEGIN
+		constexpr std::string_view CULL_SHADER = "cull.comp";
+		// local_size_x of shaders/cull.comp.
+		constexpr uint32_t CULL_GROUP_SIZE = 64;
+
+		// pushed before the dispatch, laid out as the push constant block of shaders/cull.comp.
+		struct CullConstants {
+			VkDeviceAddress instances;
+			VkDeviceAddress commands;
+			VkDeviceAddress counts;
+			uint32_t instanceCount;
+		};
+
+		// draws are batched by material, so there is never more than one batch per material.
+		constexpr VkDeviceSize COUNT_BUFFER_SIZE = MAX_MATERIALS * sizeof(uint32_t);
+
+		void recordMemoryBarrier(VkCommandBuffer commandBuffer, const VkPipelineStageFlags2 &srcStageMask,
+														 const VkAccessFlags2 &srcAccessMask, const VkPipelineStageFlags2 &dstStageMask,
+														 const VkAccessFlags2 &dstAccessMask) {
+			const VkMemoryBarrier2 barrier{.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2,
+																		 .pNext = nullptr,
+																		 .srcStageMask = srcStageMask,
+																		 .srcAccessMask = srcAccessMask,
+																		 .dstStageMask = dstStageMask,
+																		 .dstAccessMask = dstAccessMask};
+			const VkDependencyInfo dependencyInfo{.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO,
+																						.pNext = nullptr,
+																						.dependencyFlags = 0,
+																						.memoryBarrierCount = 1,
+																						.pMemoryBarriers = &barrier,
+																						.bufferMemoryBarrierCount = 0,
+																						.pBufferMemoryBarriers = nullptr,
+																						.imageMemoryBarrierCount = 0,
+																						.pImageMemoryBarriers = nullptr};
+			vkCmdPipelineBarrier2(commandBuffer, &dependencyInfo);
+		}
+	}  // namespace
+	// ANONYMOUS NAMESPACE END
+
+	DrawCuller::DrawCuller(const std::shared_ptr<LogicalDevice> &logicalDevicePtr, PipelineCache &pipelineCache,
+												 VkPipelineLayout pipelineLayout,
+												 const std::optional<std::filesystem::path> &shaderOverrideDirectory,
+												 std::span<const uint32_t> sharingFamilies):
+		m_logicalDevice(logicalDevicePtr), m_pipelineCache(pipelineCache), m_pipelineLayout(pipelineLayout),
+		m_shaderOverrideDirectory(shaderOverrideDirectory) {
+		m_cullPipeline = std::make_unique<ComputePipeline>(
+			m_logicalDevice, m_pipelineCache, m_pipelineLayout,
+			ComputePipelineDescription{.computeShader = std::string(CULL_SHADER)}, m_shaderOverrideDirectory);
+
+		for(FrameBuffers &frame : m_frames) {
+			frame.commands = createBuffer(MAX_DRAW_PACKETS * sizeof(VkDrawIndexedIndirectCommand),
+																		VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
+																		sharingFamilies, frame.commandAllocation);
+			frame.counts = createBuffer(COUNT_BUFFER_SIZE,
+																	VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT |
+																		VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
+																	sharingFamilies, frame.countAllocation);
+			frame.commandAddress = getBufferAddress(frame.commands);
+			frame.countAddress = getBufferAddress(frame.counts);
+		}
+
+		VN_LOG_INFO("Draw culler has been created.");
+	}
+
+	DrawCuller::~DrawCuller() {
+		const VkDevice device = m_logicalDevice->getHandle();
+		DeviceAllocator &allocator = m_logicalDevice->getDeviceAllocator();
+		for(const FrameBuffers &frame : m_frames) {
+			vkDestroyBuffer(device, frame.commands, nullptr);
+			vkDestroyBuffer(device, frame.counts, nullptr);
+			allocator.free(frame.commandAllocation);
+			allocator.free(frame.countAllocation);
+		}
+
+		VN_LOG_INFO("Draw culler has been destroyed.");
+	}
+
+	void DrawCuller::recordCulling(VkCommandBuffer commandBuffer, const uint32_t &frameIndex,
+																 const VkDeviceAddress &instances, const uint32_t &instanceCount) const {
+		const FrameBuffers &frame = m_frames[frameIndex];
+
+		// the frame slot's previous culling has completed before it is recorded again, only the clear needs ordering.
+		vkCmdFillBuffer(commandBuffer, frame.counts, 0, COUNT_BUFFER_SIZE, 0);
+		recordMemoryBarrier(commandBuffer, VK_PIPELINE_STAGE_2_ALL_TRANSFER_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT,
+												VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+												VK_ACCESS_2_SHADER_STORAGE_READ_BIT | VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT);
+
+		// the instances were written by the host before submission, which makes them visible without a barrier.
+		const CullConstants constants{.instances = instances,
+																	.commands = frame.commandAddress,
+																	.counts = frame.countAddress,
+																	.instanceCount = instanceCount};
+		m_cullPipeline->recordDispatch(commandBuffer, std::as_bytes(std::span(&constants, 1)),
+																	 ComputePipeline::groupCount(instanceCount, CULL_GROUP_SIZE));
+
+		recordMemoryBarrier(commandBuffer, VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+												VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT, VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT);
+	}
+
+	void DrawCuller::recordDraw(VkCommandBuffer commandBuffer, const uint32_t &frameIndex, const uint32_t &firstInstance,
+															const uint32_t &instanceCount, const uint32_t &batch) const {
+		const FrameBuffers &frame = m_frames[frameIndex];
+		vkCmdDrawIndexedIndirectCount(commandBuffer, frame.commands, firstInstance * sizeof(VkDrawIndexedIndirectCommand),
+																	frame.counts, batch * sizeof(uint32_t), instanceCount,
+																	sizeof(VkDrawIndexedIndirectCommand));
+	}
+
+	auto DrawCuller::rebuildUsing(std::string_view shaderName, DeletionQueue &deletionQueue,
+																const uint64_t &lastUseFrameValue) -> bool {
+		if(shaderName != CULL_SHADER) {
+			return false;
+		}
+
+		std::unique_ptr<ComputePipeline> pipeline;
+		try {
+			pipeline = std::make_unique<ComputePipeline>(
+				m_logicalDevice, m_pipelineCache, m_pipelineLayout,
+				ComputePipelineDescription{.computeShader = std::string(CULL_SHADER)}, m_shaderOverrideDirectory);
+		} catch(const std::exception &e) {
+			VN_LOG_ERROR(std::format("Failed to rebuild the culling pipeline: {}", e.what()));
+			return false;
+		}
+
+		// deletion entries must be copyable, the retired pipeline is destroyed when its entry is flushed.
+		std::swap(m_cullPipeline, pipeline);
+		auto retired = std::shared_ptr<ComputePipeline>(std::move(pipeline));
+		deletionQueue.retire(lastUseFrameValue, [retired]() mutable { retired.reset(); });
+		return true;
+	}
+
+	auto DrawCuller::createBuffer(const VkDeviceSize &size, const VkBufferUsageFlags &usage,
+																std::span<const uint32_t> sharingFamilies, DeviceAllocation &allocation)
+		-> VkBuffer {
+		// written by the culling pass and read by the main pass, shared when those run on different families.
+		const bool concurrent = sharingFamilies.size() > 1;
+		const VkBufferCreateInfo bufferInfo{.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+																				.pNext = nullptr,
+																				.flags = 0,
+																				.size = size,
+																				.usage = usage,
+																				.sharingMode = concurrent ? VK_SHARING_MODE_CONCURRENT : VK_SHARING_MODE_EXCLUSIVE,
+																				.queueFamilyIndexCount = concurrent ? static_cast<uint32_t>(sharingFamilies.size()) : 0,
+																				.pQueueFamilyIndices = concurrent ? sharingFamilies.data() : nullptr};
+
+		VkBuffer buffer = VK_NULL_HANDLE;
+		if(vkCreateBuffer(m_logicalDevice->getHandle(), &bufferInfo, nullptr, &buffer) != VK_SUCCESS) {
+			VN_LOG_CRITICAL("Failed to create draw culling buffer.");
+			throw std::runtime_error("Failed to create draw culling buffer.");
+		}
+
+		allocation = m_logicalDevice->getDeviceAllocator().allocateForBuffer(
+			buffer, {.usage = MEMORY_USAGE_GPU_ONLY, .tiling = RESOURCE_TILING_LINEAR});
+		return buffer;
+	}
+
+	auto DrawCuller::getBufferAddress(VkBuffer buffer) const -> VkDeviceAddress {
+		const VkBufferDeviceAddressInfo addressInfo{
+			.sType = VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO, .pNext = nullptr, .buffer = buffer};
+		return vkGetBufferDeviceAddress(m_logicalDevice->getHandle(), &addressInfo);
+	}
+
+}  // namespace venus
@@ -0,0 +1,119 @@
+#ifndef VENUS_DRAW_CULLER_HPP
+#define VENUS_DRAW_CULLER_HPP
+
+// PROJECT
+#include "deviceAllocator.hpp"
+#include "renderConfig.hpp"
+
+// THIRD PARTY
+#include "volk.h"
+
+// STDLIB
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string_view>
+
+namespace venus {
+	class LogicalDevice;
+	class PipelineCache;
+	class ComputePipeline;
+	class DeletionQueue;
+
+	// One draw of the frame as the culling pass and the mesh shaders read it, the std430 layout of
+	// shaders/drawInstance.glsl.
+	struct DrawInstance {
+		std::array<float, 16> transform;
+		std::array<float, 4> baseColor;
+		std::array<float, 3> boundsMin;
+		uint32_t firstIndex;
+		std::array<float, 3> boundsMax;
+		uint32_t indexCount;
+		int32_t vertexOffset;
+		uint32_t batch;  // counter the culling pass appends the draw to, below MAX_MATERIALS.
+		uint32_t firstCommand;  // first indirect command of the batch.
+		uint32_t baseColorTexture;  // sampled image of the bindless set, UINT32_MAX for none.
+	};
+	static_assert(sizeof(DrawInstance) == 128, "DrawInstance must match the std430 layout in drawInstance.glsl.");
+
+	/**
+   * @brief Culls the frame's draws on the gpu and turns the survivors into indirect draws.
+   *
+   * @details The cpu writes one DrawInstance per draw into the frame's FrameDataRing and records a fixed handful of
+   *          commands, however many draws there are. A compute pass tests every instance's bounds against the view
+   *          frustum and appends each survivor as a VkDrawIndexedIndirectCommand to its batch, counting them per batch.
+   *          The main pass then draws each batch with one vkCmdDrawIndexedIndirectCount that reads the gpu's count.
+   *
+   *          A batch is a run of consecutive instances sharing a pipeline. Its commands take the same range of the
+   *          command buffer as its instances, so compacted survivors never spill into the next batch.
+   *
+   *          Every frame in flight has its own command and count buffers, they are reused once the frame's timeline
+   *          value was reached.
+   *          Shaders reach the buffers through their device addresses passed in push constants, the descriptors they
+   *          need beyond that are indices into the bindless set stored in the instances.
+   *
+   *          This object cannot be copied. This object cannot be moved.
+   */
+	class DrawCuller {
+	public:
+		// 'pipelineLayout' is the bindless layout the culling pipeline is built with. 'sharingFamilies' are the families
+		// culling and drawing run on, see ComputeQueue::getSharingFamilies().
+		explicit DrawCuller(const std::shared_ptr<LogicalDevice> &logicalDevicePtr, PipelineCache &pipelineCache,
+												VkPipelineLayout pipelineLayout,
+												const std::optional<std::filesystem::path> &shaderOverrideDirectory,
+												std::span<const uint32_t> sharingFamilies);
+		~DrawCuller();
+
+		DrawCuller(const DrawCuller &) = delete;
+		auto operator=(const DrawCuller &) -> DrawCuller & = delete;
+
+		DrawCuller(const DrawCuller &&) = delete;
+		auto operator=(const DrawCuller &&) -> DrawCuller & = delete;
+
+		// Records culling the 'instanceCount' instances at 'instances', written by the host before submission, into the
+		// frame's compute command buffer, outside of any rendering instance, with the bindless set bound at the compute
+		// bind point. The barrier at the end makes the commands and counts visible to indirect draws recorded after it on
+		// the same queue, on the async compute queue the semaphore the graphics submission waits on does.
+		void recordCulling(VkCommandBuffer commandBuffer, const uint32_t &frameIndex, const VkDeviceAddress &instances,
+											 const uint32_t &instanceCount) const;
+
+		// Records drawing the survivors of one batch. The caller binds the pipeline, the bindless set, the mesh buffers
+		// and the push constants. Safe to call from several recording threads at once.
+		void recordDraw(VkCommandBuffer commandBuffer, const uint32_t &frameIndex, const uint32_t &firstInstance,
+										const uint32_t &instanceCount, const uint32_t &batch) const;
+
+		// Rebuilds the culling pipeline when 'shaderName' is its shader and returns whether it did. Render thread only,
+		// between frames, blocks while the driver compiles. Frames in flight may still use the replaced pipeline, it is
+		// retired to 'deletionQueue' until 'lastUseFrameValue' completes. A rebuild that fails keeps the old one.
+		auto rebuildUsing(std::string_view shaderName, DeletionQueue &deletionQueue, const uint64_t &lastUseFrameValue)
+			-> bool;
+
+	private:
+		std::shared_ptr<LogicalDevice> m_logicalDevice;
+		PipelineCache &m_pipelineCache;
+		VkPipelineLayout m_pipelineLayout = VK_NULL_HANDLE;
+		std::optional<std::filesystem::path> m_shaderOverrideDirectory;
+		std::unique_ptr<ComputePipeline> m_cullPipeline;
+
+		struct FrameBuffers {
+			VkBuffer commands = VK_NULL_HANDLE;  // gpu written, one VkDrawIndexedIndirectCommand per instance.
+			VkBuffer counts = VK_NULL_HANDLE;  // gpu written, one uint32_t per batch.
+			DeviceAllocation commandAllocation;
+			DeviceAllocation countAllocation;
+			VkDeviceAddress commandAddress = 0;
+			VkDeviceAddress countAddress = 0;
+		};
+		std::array<FrameBuffers, MAX_FRAMES_IN_FLIGHT> m_frames;
+
+		[[nodiscard]] auto createBuffer(const VkDeviceSize &size, const VkBufferUsageFlags &usage,
+																		std::span<const uint32_t> sharingFamilies, DeviceAllocation &allocation)
+			-> VkBuffer;
+		[[nodiscard]] auto getBufferAddress(VkBuffer buffer) const -> VkDeviceAddress;
+	};
+
+}  // namespace venus
+
+#endif  // VENUS_DRAW_CULLER_HPP
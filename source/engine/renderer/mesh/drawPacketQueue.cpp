@@ -0,0 +1,66 @@
+#include "drawPacketQueue.hpp"
+#include "renderConfig.hpp"
+
+// STDLIB
+#include <algorithm>
+#include <thread>
+
+namespace venus {
+
+	DrawPacketQueue::DrawPacketQueue() {
+		for(List &list : m_lists) {
+			list.packets.resize(MAX_DRAW_PACKETS);
+		}
+	}
+
+	auto DrawPacketQueue::submit(const DrawPacket &packet) -> bool {
+		while(true) {
+			List &list = m_lists[m_openList.load(std::memory_order_acquire)];
+			const uint32_t slot = list.claimed.fetch_add(1, std::memory_order_acq_rel);
+			if((slot & SEALED_BIT) != 0) {
+				// sealed after we looked it up, the next list is already open.
+				continue;
+			}
+			if(slot >= MAX_DRAW_PACKETS) {
+				return false;
+			}
+
+			list.packets[slot] = packet;
+			list.written.fetch_add(1, std::memory_order_release);
+			return true;
+		}
+	}
+
+	auto DrawPacketQueue::seal() -> uint32_t {
+		const uint32_t sealedIndex = m_openList.load(std::memory_order_relaxed);
+		const uint32_t nextIndex = (sealedIndex + 1) % LIST_COUNT;
+
+		// the next list is opened before this one is sealed, so submitters bouncing off the seal find it right away.
+		List &next = m_lists[nextIndex];
+		next.inUse.wait(true, std::memory_order_acquire);
+		next.written.store(0, std::memory_order_relaxed);
+		next.claimed.store(0, std::memory_order_release);
+		m_openList.store(nextIndex, std::memory_order_release);
+
+		List &sealed = m_lists[sealedIndex];
+		sealed.sealedCount = std::min(sealed.claimed.fetch_or(SEALED_BIT, std::memory_order_acq_rel),
+																	static_cast<uint32_t>(MAX_DRAW_PACKETS));
+		sealed.inUse.store(true, std::memory_order_release);
+		return sealedIndex;
+	}
+
+	auto DrawPacketQueue::acquire(const uint32_t &list) -> std::span<const DrawPacket> {
+		const List &acquired = m_lists[list];
+		// a submitter that claimed a slot before the seal is at most one packet copy away from finishing.
+		while(acquired.written.load(std::memory_order_acquire) < acquired.sealedCount) {
+			std::this_thread::yield();
+		}
+		return {acquired.packets.data(), acquired.sealedCount};
+	}
+
+	void DrawPacketQueue::release(const uint32_t &list) {
+		m_lists[list].inUse.store(false, std::memory_order_release);
+		m_lists[list].inUse.notify_one();
+	}
+
+}  // namespace venus
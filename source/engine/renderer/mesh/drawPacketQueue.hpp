@@ -0,0 +1,71 @@
+#ifndef VENUS_DRAW_PACKET_QUEUE_HPP
+#define VENUS_DRAW_PACKET_QUEUE_HPP
+
+// PROJECT
+#include "drawPacket.hpp"
+
+// STDLIB
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace venus {
+
+	/**
+   * @brief Lock-free collection of the draw packets submitted for each frame.
+   *
+   * @details Packets are appended to the open list from any thread, a slot is claimed with one atomic add and the
+   *          packet is written into it. Once per frame the main thread seals the open list and opens the next, the
+   *          sealed list travels to the renderer with the frame state. The renderer acquires it, which waits out
+   *          writers still copying into claimed slots, and releases it once the frame is recorded.
+   *
+   *          Lists have a fixed capacity allocated up front, a packet submitted to a full list is dropped. The ring of
+   *          lists covers the list being filled, one published frame and the frame being drawn, with one to spare.
+   *          Sealing waits for the next list to be released only when the renderer falls further behind than that.
+   *
+   *          This object cannot be copied. This object cannot be moved.
+   */
+	class DrawPacketQueue {
+	public:
+		DrawPacketQueue();
+		~DrawPacketQueue() = default;
+
+		DrawPacketQueue(const DrawPacketQueue &) = delete;
+		auto operator=(const DrawPacketQueue &) -> DrawPacketQueue & = delete;
+
+		DrawPacketQueue(const DrawPacketQueue &&) = delete;
+		auto operator=(const DrawPacketQueue &&) -> DrawPacketQueue & = delete;
+
+		// Any thread, never blocks. False when the open list is full and the packet was dropped.
+		auto submit(const DrawPacket &packet) -> bool;
+
+		// One producing thread only. Returns the sealed list, which must be acquired and released once.
+		[[nodiscard]] auto seal() -> uint32_t;
+
+		// Consumer only, the packets stay valid until the list is released.
+		[[nodiscard]] auto acquire(const uint32_t &list) -> std::span<const DrawPacket>;
+		void release(const uint32_t &list);
+
+	private:
+		static constexpr uint32_t LIST_COUNT = 4;
+		static constexpr uint32_t SEALED_BIT = 1U << 31;
+		static constexpr size_t CACHE_LINE_SIZE = 64;
+
+		struct List {
+			std::vector<DrawPacket> packets;
+			uint32_t sealedCount = 0;  // claimed slots at sealing, capped at the capacity.
+
+			// submitters hammer both counters, keeping them apart from the packets and each other avoids false sharing.
+			alignas(CACHE_LINE_SIZE) std::atomic<uint32_t> claimed = 0;  // carries SEALED_BIT once sealed.
+			alignas(CACHE_LINE_SIZE) std::atomic<uint32_t> written = 0;
+			std::atomic<bool> inUse = false;  // sealed and not released yet.
+		};
+		std::array<List, LIST_COUNT> m_lists;
+		std::atomic<uint32_t> m_openList = 0;
+	};
+
+}  // namespace venus
+
+#endif  // VENUS_DRAW_PACKET_QUEUE_HPP
@@ -0,0 +1,243 @@
+#include "meshRegistry.hpp"
+#include "VN_logger.hpp"
+#include "deletionQueue.hpp"
+#include "logicalDevice.hpp"
+
+// STDLIB
+#include <algorithm>
+#include <format>
+#include <stdexcept>
+
+namespace venus {
+	namespace {  // ANONYMOUS NAMESPACE BEGIN
+		// mesh space box around every vertex, the gpu culls draws by transforming it to clip space.
+		void computeBounds(std::span<const MeshVertex> vertices, GpuMesh &mesh) {
+			mesh.boundsMin = vertices.front().position;
+			mesh.boundsMax = vertices.front().position;
+			for(const MeshVertex &vertex : vertices) {
+				for(size_t axis = 0; axis < 3; ++axis) {
+					mesh.boundsMin[axis] = std::min(mesh.boundsMin[axis], vertex.position[axis]);
+					mesh.boundsMax[axis] = std::max(mesh.boundsMax[axis], vertex.position[axis]);
+				}
+			}
+		}
+
+		// well below the staging ring, a large mesh streams in over a few frames instead of waiting for an empty ring.
+		constexpr VkDeviceSize UPLOAD_CHUNK_SIZE = 4ULL * 1024 * 1024;
+
+		// chunks and destroyed meshes tracked before the lists reallocate.
+		constexpr size_t INITIAL_LIST_CAPACITY = 64;
+	}  // namespace
+	// ANONYMOUS NAMESPACE END
+
+	MeshRegistry::MeshRegistry(const std::shared_ptr<LogicalDevice> &logicalDevicePtr, UploadQueue &uploadQueue):
+		m_logicalDevice(logicalDevicePtr), m_uploadQueue(uploadQueue), m_vertexRanges(MESH_VERTEX_BUFFER_SIZE),
+		m_indexRanges(MESH_INDEX_BUFFER_SIZE) {
+		m_vertexBuffer = createSharedBuffer(MESH_VERTEX_BUFFER_SIZE,
+																				VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+																				m_vertexAllocation);
+		m_indexBuffer = createSharedBuffer(MESH_INDEX_BUFFER_SIZE,
+																			 VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+																			 m_indexAllocation);
+
+		// handed out lowest first.
+		m_freeSlots.reserve(MAX_MESHES);
+		for(uint32_t slot = MAX_MESHES; slot > 0; --slot) {
+			m_freeSlots.push_back(slot - 1);
+		}
+		m_pendingChunks.reserve(INITIAL_LIST_CAPACITY);
+		m_destroyedSlots.reserve(INITIAL_LIST_CAPACITY);
+
+		VN_LOG_INFO(std::format("Mesh registry created with {} MiB of vertex and {} MiB of index memory.",
+														MESH_VERTEX_BUFFER_SIZE / (1024 * 1024), MESH_INDEX_BUFFER_SIZE / (1024 * 1024)));
+	}
+
+	MeshRegistry::~MeshRegistry() {
+		const VkDevice device = m_logicalDevice->getHandle();
+		vkDestroyBuffer(device, m_vertexBuffer, nullptr);
+		vkDestroyBuffer(device, m_indexBuffer, nullptr);
+		m_logicalDevice->getDeviceAllocator().free(m_vertexAllocation);
+		m_logicalDevice->getDeviceAllocator().free(m_indexAllocation);
+
+		VN_LOG_INFO("Mesh registry has been destroyed.");
+	}
+
+	auto MeshRegistry::createMesh(const MeshData &meshData) -> MeshHandle {
+		if(meshData.vertices.empty() || meshData.indices.empty()) {
+			VN_LOG_CRITICAL("Cannot create a mesh without vertices or indices.");
+			throw std::runtime_error("Cannot create a mesh without vertices or indices.");
+		}
+
+		// outside the lock, it touches every vertex.
+		GpuMesh bounds{};
+		computeBounds(meshData.vertices, bounds);
+
+		const std::scoped_lock lock(m_mutex);
+		if(m_freeSlots.empty()) {
+			VN_LOG_CRITICAL(std::format("Cannot create more than {} meshes.", MAX_MESHES));
+			throw std::runtime_error("Cannot create more meshes.");
+		}
+
+		const std::span<const std::byte> vertexBytes = std::as_bytes(meshData.vertices);
+		const std::span<const std::byte> indexBytes = std::as_bytes(meshData.indices);
+		const auto vertexRange = m_vertexRanges.allocate(vertexBytes.size(), sizeof(MeshVertex), nullptr);
+		const auto indexRange = m_indexRanges.allocate(indexBytes.size(), sizeof(uint32_t), nullptr);
+		if(!vertexRange.has_value() || !indexRange.has_value()) {
+			if(vertexRange.has_value()) {
+				m_vertexRanges.free(vertexRange->node);
+			}
+			if(indexRange.has_value()) {
+				m_indexRanges.free(indexRange->node);
+			}
+			VN_LOG_CRITICAL(std::format("Mesh buffers have no room for {} vertices and {} indices.",
+																	meshData.vertices.size(), meshData.indices.size()));
+			throw std::runtime_error("Mesh buffers have no room for the mesh.");
+		}
+
+		const uint32_t slotIndex = m_freeSlots.back();
+		m_freeSlots.pop_back();
+
+		// ranges start on the allocator's granularity, a multiple of both the vertex and the index size.
+		MeshSlot &slot = m_slots[slotIndex];
+		slot.mesh = {.firstIndex = static_cast<uint32_t>(indexRange->offset / sizeof(uint32_t)),
+								 .indexCount = static_cast<uint32_t>(meshData.indices.size()),
+								 .vertexOffset = static_cast<int32_t>(vertexRange->offset / sizeof(MeshVertex)),
+								 .boundsMin = bounds.boundsMin,
+								 .boundsMax = bounds.boundsMax};
+		slot.vertexNode = vertexRange->node;
+		slot.indexNode = indexRange->node;
+		slot.pendingChunks = 0;
+		slot.lastTransferValue = 0;
+		slot.alive = true;
+
+		uploadChunks(slotIndex, m_vertexBuffer, vertexRange->offset, vertexBytes);
+		uploadChunks(slotIndex, m_indexBuffer, indexRange->offset, indexBytes);
+		if(slot.pendingChunks == 0) {
+			slot.readyTransferValue.store(slot.lastTransferValue, std::memory_order_release);
+		}
+		return {.index = slotIndex};
+	}
+
+	void MeshRegistry::destroyMesh(const MeshHandle &mesh) {
+		if(!mesh.isValid() || mesh.index >= MAX_MESHES) {
+			return;
+		}
+
+		const std::scoped_lock lock(m_mutex);
+		MeshSlot &slot = m_slots[mesh.index];
+		if(!slot.alive) {
+			VN_LOG_WARN(std::format("Mesh {} was destroyed twice.", mesh.index));
+			return;
+		}
+		slot.alive = false;
+		slot.readyTransferValue.store(HIDDEN, std::memory_order_release);
+		m_destroyedSlots.push_back(mesh.index);
+	}
+
+	void MeshRegistry::update(DeletionQueue &deletionQueue, const uint64_t &lastUseValue) {
+		// a mesh being created holds the lock for its copies into the staging ring, its work waits for the next frame.
+		const std::unique_lock lock(m_mutex, std::try_to_lock);
+		if(!lock.owns_lock()) {
+			return;
+		}
+
+		// oldest first, the ring frees in submission order so once one chunk does not fit the rest would not either.
+		size_t handledChunks = 0;
+		for(; handledChunks < m_pendingChunks.size(); ++handledChunks) {
+			const PendingChunk &chunk = m_pendingChunks[handledChunks];
+			MeshSlot &slot = m_slots[chunk.slot];
+			if(slot.alive) {
+				const std::optional<UploadTicket> ticket = m_uploadQueue.uploadBuffer(chunk.buffer, chunk.offset, chunk.data);
+				if(!ticket.has_value()) {
+					break;
+				}
+				slot.lastTransferValue = std::max(slot.lastTransferValue, ticket->transferValue);
+			}
+
+			--slot.pendingChunks;
+			if(slot.pendingChunks == 0 && slot.alive) {
+				slot.readyTransferValue.store(slot.lastTransferValue, std::memory_order_release);
+			}
+		}
+		m_pendingChunks.erase(m_pendingChunks.begin(), m_pendingChunks.begin() + static_cast<std::ptrdiff_t>(handledChunks));
+
+		// a destroyed mesh keeps its slot while chunks still name it.
+		std::erase_if(m_destroyedSlots, [this, &deletionQueue, &lastUseValue](const uint32_t &slotIndex) {
+			if(m_slots[slotIndex].pendingChunks != 0) {
+				return false;
+			}
+			deletionQueue.retire(lastUseValue, [this, slotIndex]() {
+				const std::scoped_lock retireLock(m_mutex);
+				releaseSlot(slotIndex);
+			});
+			return true;
+		});
+	}
+
+	auto MeshRegistry::findMesh(const MeshHandle &mesh) const -> const GpuMesh * {
+		if(!mesh.isValid() || mesh.index >= MAX_MESHES) {
+			return nullptr;
+		}
+
+		const MeshSlot &slot = m_slots[mesh.index];
+		const uint64_t readyTransferValue = slot.readyTransferValue.load(std::memory_order_acquire);
+		if(readyTransferValue == HIDDEN || !m_uploadQueue.isSubmitted({.transferValue = readyTransferValue})) {
+			return nullptr;
+		}
+		return &slot.mesh;
+	}
+
+	auto MeshRegistry::createSharedBuffer(const VkDeviceSize &size, const VkBufferUsageFlags &usage,
+																				DeviceAllocation &allocation) -> VkBuffer {
+		// filled on the transfer queue and read on the graphics queue, shared by both when they are different families.
+		const std::span<const uint32_t> sharingFamilies = m_uploadQueue.getSharingFamilies();
+		const bool concurrent = sharingFamilies.size() > 1;
+		const VkBufferCreateInfo bufferInfo{.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+																				.pNext = nullptr,
+																				.flags = 0,
+																				.size = size,
+																				.usage = usage,
+																				.sharingMode = concurrent ? VK_SHARING_MODE_CONCURRENT : VK_SHARING_MODE_EXCLUSIVE,
+																				.queueFamilyIndexCount = concurrent ? static_cast<uint32_t>(sharingFamilies.size()) : 0,
+																				.pQueueFamilyIndices = concurrent ? sharingFamilies.data() : nullptr};
+
+		VkBuffer buffer = VK_NULL_HANDLE;
+		if(vkCreateBuffer(m_logicalDevice->getHandle(), &bufferInfo, nullptr, &buffer) != VK_SUCCESS) {
+			VN_LOG_CRITICAL("Failed to create shared mesh buffer.");
+			throw std::runtime_error("Failed to create shared mesh buffer.");
+		}
+
+		allocation = m_logicalDevice->getDeviceAllocator().allocateForBuffer(
+			buffer, {.usage = MEMORY_USAGE_GPU_ONLY, .tiling = RESOURCE_TILING_LINEAR});
+		return buffer;
+	}
+
+	void MeshRegistry::uploadChunks(const uint32_t &slot, VkBuffer buffer, const VkDeviceSize &offset,
+																	std::span<const std::byte> data) {
+		MeshSlot &meshSlot = m_slots[slot];
+		for(VkDeviceSize chunkOffset = 0; chunkOffset < data.size(); chunkOffset += UPLOAD_CHUNK_SIZE) {
+			const std::span<const std::byte> chunk =
+				data.subspan(chunkOffset, std::min<VkDeviceSize>(UPLOAD_CHUNK_SIZE, data.size() - chunkOffset));
+			const std::optional<UploadTicket> ticket = m_uploadQueue.uploadBuffer(buffer, offset + chunkOffset, chunk);
+			if(ticket.has_value()) {
+				meshSlot.lastTransferValue = std::max(meshSlot.lastTransferValue, ticket->transferValue);
+				continue;
+			}
+
+			// the staging ring is full, 'update()' retries once earlier batches have freed it.
+			m_pendingChunks.push_back(
+				{.slot = slot, .buffer = buffer, .offset = offset + chunkOffset, .data = {chunk.begin(), chunk.end()}});
+			++meshSlot.pendingChunks;
+		}
+	}
+
+	void MeshRegistry::releaseSlot(const uint32_t &slot) {
+		MeshSlot &meshSlot = m_slots[slot];
+		m_vertexRanges.free(meshSlot.vertexNode);
+		m_indexRanges.free(meshSlot.indexNode);
+		meshSlot.vertexNode = TlsfAllocator::NULL_NODE;
+		meshSlot.indexNode = TlsfAllocator::NULL_NODE;
+		m_freeSlots.push_back(slot);
+	}
+
+}  // namespace venus
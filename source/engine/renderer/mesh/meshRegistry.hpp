@@ -0,0 +1,126 @@
+#ifndef VENUS_MESH_REGISTRY_HPP
+#define VENUS_MESH_REGISTRY_HPP
+
+// PROJECT
+#include "deviceAllocator.hpp"
+#include "drawPacket.hpp"
+#include "renderConfig.hpp"
+#include "tlsfAllocator.hpp"
+#include "uploadQueue.hpp"
+
+// THIRD PARTY
+#include "volk.h"
+
+// STDLIB
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <vector>
+
+namespace venus {
+	class LogicalDevice;
+	class DeletionQueue;
+
+	// Where a mesh lives in the shared buffers, in the units vkCmdDrawIndexed takes, and the box its positions fill.
+	struct GpuMesh {
+		uint32_t firstIndex;
+		uint32_t indexCount;
+		int32_t vertexOffset;
+		std::array<float, 3> boundsMin;
+		std::array<float, 3> boundsMax;
+	};
+
+	/**
+   * @brief Packs every mesh into one shared vertex buffer and one shared index buffer.
+   *
+   * @details Each mesh takes a range of both buffers, handed out by a TlsfAllocator per buffer, so drawing any number of
+   *          meshes binds the two buffers once and only changes the offsets passed to vkCmdDrawIndexed.
+   *
+   *          Meshes are created and destroyed from any thread. Their data goes through the UploadQueue in chunks, a
+   *          chunk that does not fit into the staging ring yet is kept and retried by 'update()' on later frames.
+   *          A mesh becomes drawable once its last chunk has been submitted, until then 'findMesh()' returns nothing.
+   *
+   *          A destroyed mesh disappears from 'findMesh()' right away, its ranges and handle are reused once the
+   *          graphics timeline passes the frames that may still draw it.
+   *
+   *          This object cannot be copied. This object cannot be moved.
+   */
+	class MeshRegistry {
+	public:
+		explicit MeshRegistry(const std::shared_ptr<LogicalDevice> &logicalDevicePtr, UploadQueue &uploadQueue);
+		~MeshRegistry();
+
+		MeshRegistry(const MeshRegistry &) = delete;
+		auto operator=(const MeshRegistry &) -> MeshRegistry & = delete;
+
+		MeshRegistry(const MeshRegistry &&) = delete;
+		auto operator=(const MeshRegistry &&) -> MeshRegistry & = delete;
+
+		// Any thread. Throws when the shared buffers or the mesh handles are exhausted.
+		[[nodiscard]] auto createMesh(const MeshData &meshData) -> MeshHandle;
+		void destroyMesh(const MeshHandle &mesh);
+
+		// Render thread only, before the frame's uploads are submitted. 'lastUseValue' is the graphics timeline value of
+		// the most recent submission, which is the last that may draw a mesh destroyed since the previous call.
+		void update(DeletionQueue &deletionQueue, const uint64_t &lastUseValue);
+
+		// Render thread only, never blocks. Null for invalid, destroyed and not yet uploaded meshes.
+		[[nodiscard]] auto findMesh(const MeshHandle &mesh) const -> const GpuMesh *;
+
+		[[nodiscard]] auto getVertexBuffer() const -> VkBuffer { return m_vertexBuffer; }
+		[[nodiscard]] auto getIndexBuffer() const -> VkBuffer { return m_indexBuffer; }
+
+	private:
+		std::shared_ptr<LogicalDevice> m_logicalDevice;
+		UploadQueue &m_uploadQueue;
+
+		VkBuffer m_vertexBuffer = VK_NULL_HANDLE;
+		VkBuffer m_indexBuffer = VK_NULL_HANDLE;
+		DeviceAllocation m_vertexAllocation;
+		DeviceAllocation m_indexAllocation;
+		[[nodiscard]] auto createSharedBuffer(const VkDeviceSize &size, const VkBufferUsageFlags &usage,
+																					DeviceAllocation &allocation) -> VkBuffer;
+
+		// the ticket is published last with a release store, UINT64_MAX keeps the mesh hidden from 'findMesh()'.
+		static constexpr uint64_t HIDDEN = UINT64_MAX;
+		struct MeshSlot {
+			GpuMesh mesh{};
+			std::atomic<uint64_t> readyTransferValue = HIDDEN;
+
+			// guarded by the mutex.
+			uint32_t vertexNode = TlsfAllocator::NULL_NODE;
+			uint32_t indexNode = TlsfAllocator::NULL_NODE;
+			uint32_t pendingChunks = 0;
+			uint64_t lastTransferValue = 0;
+			bool alive = false;
+		};
+		std::array<MeshSlot, MAX_MESHES> m_slots;
+
+		struct PendingChunk {
+			uint32_t slot;
+			VkBuffer buffer;
+			VkDeviceSize offset;
+			std::vector<std::byte> data;
+		};
+
+		// guards the range allocators, the slots' bookkeeping and the lists below.
+		std::mutex m_mutex;
+		TlsfAllocator m_vertexRanges;
+		TlsfAllocator m_indexRanges;
+		std::vector<uint32_t> m_freeSlots;
+		std::vector<PendingChunk> m_pendingChunks;
+		std::vector<uint32_t> m_destroyedSlots;
+
+		// the mutex must be held.
+		void uploadChunks(const uint32_t &slot, VkBuffer buffer, const VkDeviceSize &offset,
+											std::span<const std::byte> data);
+		void releaseSlot(const uint32_t &slot);
+	};
+
+}  // namespace venus
+
+#endif  // VENUS_MESH_REGISTRY_HPP
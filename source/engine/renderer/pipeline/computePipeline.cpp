@@ -0,0 +1,76 @@
+#include "computePipeline.hpp"
+#include "VN_logger.hpp"
+#include "bindlessDescriptors.hpp"
+#include "logicalDevice.hpp"
+#include "pipelineCache.hpp"
+#include "shaderModule.hpp"
+
+// STDLIB
+#include <cassert>
+#include <chrono>
+#include <stdexcept>
+
+namespace venus {
+
+	ComputePipeline::ComputePipeline(const std::shared_ptr<LogicalDevice> &logicalDevicePtr, PipelineCache &pipelineCache,
+																	 VkPipelineLayout pipelineLayout, const ComputePipelineDescription &description,
+																	 const std::optional<std::filesystem::path> &shaderOverrideDirectory):
+		m_pipelineLayout(pipelineLayout), m_logicalDevice(logicalDevicePtr) {
+		const VkDevice device = m_logicalDevice->getHandle();
+		const VkShaderModule computeModule = createShaderModule(device, description.computeShader, shaderOverrideDirectory);
+
+		VkPipelineCreationFeedback creationFeedback{};
+		VkPipelineCreationFeedbackCreateInfo feedbackInfo{.sType = VK_STRUCTURE_TYPE_PIPELINE_CREATION_FEEDBACK_CREATE_INFO,
+																											.pNext = nullptr,
+																											.pPipelineCreationFeedback = &creationFeedback,
+																											.pipelineStageCreationFeedbackCount = 0,
+																											.pPipelineStageCreationFeedbacks = nullptr};
+
+		const VkComputePipelineCreateInfo createInfo{.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO,
+																								 .pNext = &feedbackInfo,
+																								 .flags = 0,
+																								 .stage = {.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
+																													 .pNext = nullptr,
+																													 .flags = 0,
+																													 .stage = VK_SHADER_STAGE_COMPUTE_BIT,
+																													 .module = computeModule,
+																													 .pName = "main",
+																													 .pSpecializationInfo = nullptr},
+																								 .layout = m_pipelineLayout,
+																								 .basePipelineHandle = VK_NULL_HANDLE,
+																								 .basePipelineIndex = -1};
+
+		const auto CREATION_START = std::chrono::steady_clock::now();
+		if(vkCreateComputePipelines(device, pipelineCache.getHandle(), 1, &createInfo, nullptr, &m_computePipeline) !=
+			 VK_SUCCESS) {
+			vkDestroyShaderModule(device, computeModule, nullptr);
+			VN_LOG_CRITICAL("Failed to create compute pipeline.");
+			throw std::runtime_error("Failed to create compute pipeline.");
+		}
+		pipelineCache.recordCreation(creationFeedback, std::chrono::steady_clock::now() - CREATION_START);
+
+		vkDestroyShaderModule(device, computeModule, nullptr);
+
+		VN_LOG_INFO("ComputePipeline has been constructed.");
+	}
+
+	void ComputePipeline::recordDispatch(VkCommandBuffer commandBuffer, std::span<const std::byte> pushConstants,
+																			 const uint32_t &groupCountX, const uint32_t &groupCountY,
+																			 const uint32_t &groupCountZ) const {
+		vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_computePipeline);
+		if(!pushConstants.empty()) {
+			// a larger block than the layout's range is a programming error the validation layers would report anyway.
+			assert(pushConstants.size() <= BindlessDescriptors::PUSH_CONSTANT_SIZE);
+			vkCmdPushConstants(commandBuffer, m_pipelineLayout, BindlessDescriptors::PUSH_CONSTANT_STAGES, 0,
+												 static_cast<uint32_t>(pushConstants.size()), pushConstants.data());
+		}
+		vkCmdDispatch(commandBuffer, groupCountX, groupCountY, groupCountZ);
+	}
+
+	ComputePipeline::~ComputePipeline() {
+		vkDestroyPipeline(m_logicalDevice->getHandle(), m_computePipeline, nullptr);
+
+		VN_LOG_INFO("ComputePipeline has been destructed.");
+	}
+
+}  // namespace venus
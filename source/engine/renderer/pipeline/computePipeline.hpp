@@ -0,0 +1,74 @@
+#ifndef VENUS_COMPUTE_PIPELINE_HPP
+#define VENUS_COMPUTE_PIPELINE_HPP
+
+// THIRD PARTY
+#include "volk.h"
+
+// STDLIB
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+
+namespace venus {
+	class LogicalDevice;
+	class PipelineCache;
+
+	// Everything a compute pipeline is built from, the shader name is a file name in source/shaders such as "cull.comp".
+	struct ComputePipelineDescription {
+		std::string computeShader;
+	};
+
+	/**
+   * @brief A compute shader and the helper recording its dispatches.
+   *
+   * @details Built with the bindless layout every pipeline shares, shaders reach their buffers through device addresses
+   *          passed in the push constants or through the bindless set. Dispatches may be recorded into a graphics
+   *          command buffer or one submitted to the async compute queue, see ComputeQueue.
+   *
+   *          This object cannot be copied. This object cannot be moved.
+   */
+	class ComputePipeline {
+	public:
+		// 'pipelineLayout' is the bindless layout, it must outlive the pipeline. Shaders come from the binary unless a
+		// development override directory provides them, see createShaderModule. Blocks while the driver compiles.
+		explicit ComputePipeline(const std::shared_ptr<LogicalDevice> &logicalDevicePtr, PipelineCache &pipelineCache,
+														 VkPipelineLayout pipelineLayout, const ComputePipelineDescription &description,
+														 const std::optional<std::filesystem::path> &shaderOverrideDirectory);
+		~ComputePipeline();
+
+		ComputePipeline(const ComputePipeline &) = delete;
+		auto operator=(const ComputePipeline &) -> ComputePipeline & = delete;
+
+		ComputePipeline(const ComputePipeline &&) = delete;
+		auto operator=(const ComputePipeline &&) -> ComputePipeline & = delete;
+
+		// Binds the pipeline, pushes 'pushConstants' from offset zero when there are any and dispatches the groups.
+		// The bindless set must already be bound at the compute bind point. Safe to call from several recording threads
+		// at once.
+		void recordDispatch(VkCommandBuffer commandBuffer, std::span<const std::byte> pushConstants,
+												const uint32_t &groupCountX, const uint32_t &groupCountY = 1,
+												const uint32_t &groupCountZ = 1) const;
+
+		// Groups of 'groupSize' invocations needed to cover 'invocationCount', the last group may be partial.
+		[[nodiscard]] static constexpr auto groupCount(const uint32_t &invocationCount, const uint32_t &groupSize)
+			-> uint32_t {
+			return (invocationCount + groupSize - 1) / groupSize;
+		}
+
+		[[nodiscard]] auto getHandle() const { return m_computePipeline; }
+		[[nodiscard]] auto getLayout() const { return m_pipelineLayout; }
+
+	private:
+		VkPipeline m_computePipeline = VK_NULL_HANDLE;
+		VkPipelineLayout m_pipelineLayout = VK_NULL_HANDLE;  // not owned, see BindlessDescriptors.
+
+		std::shared_ptr<LogicalDevice> m_logicalDevice;
+	};
+
+}  // namespace venus
+
+#endif  // VENUS_COMPUTE_PIPELINE_HPP
@@ -1,71 +1,91 @@
 #include "graphicsPipeline.hpp"
 #include "VN_logger.hpp"
+#include "drawPacket.hpp"
 #include "logicalDevice.hpp"
-#include "swapchain.hpp"
+#include "pipelineCache.hpp"
+#include "shaderModule.hpp"
 
 // STDLIB
-#include <bit>
-#include <cassert>
-#include <fstream>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <span>
+#include <string_view>
 #include <vector>
 
 namespace venus {
 	namespace {  // ANONYMOUS NAMESPACE BEGIN
 
+		constexpr uint32_t SHADER_STAGE_COUNT = 2;
+
 		struct ShaderStageModules {
 			VkShaderModule vertex;
 			VkShaderModule fragment;
 		};
 
-		auto createShaderModule(const std::string &fileName) -> VkShaderModule {
-			std::ifstream file(fileName, std::ios::binary);
-
-			if(!file.is_open()) {
-				VN_LOG_CRITICAL("Failed to open shader file.");
-				throw std::runtime_error("Failed to open shader file.");
+		// Pipelines are compiled concurrently with each other, so the modules of one pipeline are simply created in turn.
+		// If any fails the ones already created are destroyed and the error rethrown.
+		auto createShaderModules(VkDevice device, const std::array<std::string_view, SHADER_STAGE_COUNT> &shaderNames,
+														 const std::optional<std::filesystem::path> &overrideDirectory)
+			-> std::array<VkShaderModule, SHADER_STAGE_COUNT> {
+			std::array<VkShaderModule, SHADER_STAGE_COUNT> modules{};
+			try {
+				for(uint32_t stage = 0; stage < SHADER_STAGE_COUNT; ++stage) {
+					modules[stage] = createShaderModule(device, shaderNames[stage], overrideDirectory);
+				}
+			} catch(...) {
+				for(const auto &shaderModule : modules) {
+					vkDestroyShaderModule(device, shaderModule, nullptr);
+				}
+				throw;
 			}
+			return modules;
+		}
 
-			std::vector<char> rawShaderBytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
-
-			assert(rawShaderBytes.size() % sizeof(uint32_t) == 0);
-
-			const size_t chunkCount = rawShaderBytes.size() / sizeof(uint32_t);
-			std::span<const char> rawByteSpan(rawShaderBytes);
-
-			std::vector<uint32_t> shaderByteCode;
-			shaderByteCode.reserve(chunkCount);
-
-			for(size_t i = 0; i < chunkCount; ++i) {
-				std::array<char, 4> chunk = {};
-				std::copy_n(rawByteSpan.subspan(i * 4, 4).begin(), 4, chunk.begin());
+		constexpr uint64_t FNV_OFFSET_BASIS = 14695981039346656037ULL;
+		constexpr uint64_t FNV_PRIME = 1099511628211ULL;
 
-				shaderByteCode.push_back(std::bit_cast<uint32_t>(chunk));
+		// fnv-1a, fields are hashed one by one so struct padding never leaks into the key.
+		template<typename T>
+		void hashValue(uint64_t &hash, const T &value) {
+			const auto bytes = std::as_bytes(std::span(&value, 1));
+			for(const std::byte &byte : bytes) {
+				hash ^= static_cast<uint64_t>(byte);
+				hash *= FNV_PRIME;
 			}
+		}
 
-			VkShaderModuleCreateInfo createInfo{.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO,
-																					.pNext = nullptr,
-																					.flags = 0,
-																					.codeSize = (shaderByteCode.size() * sizeof(uint32_t)),
-																					.pCode = shaderByteCode.data()};
-
-			VkShaderModule shaderModule = {};
-			if(vkCreateShaderModule(volkGetLoadedDevice(), &createInfo, nullptr, &shaderModule) != VK_SUCCESS) {
-				VN_LOG_CRITICAL("Failed to create shader module.");
-				throw std::runtime_error("Failed to create shader module.");
+		void hashString(uint64_t &hash, std::string_view text) {
+			for(const char character : text) {
+				hash ^= static_cast<uint8_t>(character);
+				hash *= FNV_PRIME;
 			}
+			// the length separates "ab" + "c" from "a" + "bc".
+			hashValue(hash, text.size());
+		}
 
-			VN_LOG_INFO("A shader module has been created.");
-			return shaderModule;
+		// One map entry per constant, each a 32-bit word at its index in 'constants'.
+		auto createSpecializationEntries(std::span<const SpecializationConstant> constants)
+			-> std::vector<VkSpecializationMapEntry> {
+			std::vector<VkSpecializationMapEntry> entries;
+			entries.reserve(constants.size());
+			for(size_t i = 0; i < constants.size(); ++i) {
+				entries.push_back({.constantID = constants[i].constantID,
+													 .offset = static_cast<uint32_t>(i * sizeof(SpecializationConstant::value)),
+													 .size = sizeof(SpecializationConstant::value)});
+			}
+			return entries;
 		}
 
-		auto createShaderStages(const ShaderStageModules &modules) -> std::vector<VkPipelineShaderStageCreateInfo> {
+		auto createShaderStages(const ShaderStageModules &modules, const VkSpecializationInfo *specializationInfo)
+			-> std::vector<VkPipelineShaderStageCreateInfo> {
 			VkPipelineShaderStageCreateInfo vertexStageInfo{.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
 																											.pNext = nullptr,
 																											.flags = 0,
 																											.stage = VK_SHADER_STAGE_VERTEX_BIT,
 																											.module = modules.vertex,
 																											.pName = "main",
-																											.pSpecializationInfo = nullptr};
+																											.pSpecializationInfo = specializationInfo};
 
 			VkPipelineShaderStageCreateInfo fragmentStageInfo{.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
 																												.pNext = nullptr,
@@ -73,20 +93,63 @@ namespace venus {
 																												.stage = VK_SHADER_STAGE_FRAGMENT_BIT,
 																												.module = modules.fragment,
 																												.pName = "main",
-																												.pSpecializationInfo = nullptr};
+																												.pSpecializationInfo = specializationInfo};
 
 			return {vertexStageInfo, fragmentStageInfo};
 		}
 
+		constexpr VkVertexInputBindingDescription MESH_VERTEX_BINDING{
+			.binding = 0, .stride = sizeof(MeshVertex), .inputRate = VK_VERTEX_INPUT_RATE_VERTEX};
+
+		constexpr std::array<VkVertexInputAttributeDescription, 3> MESH_VERTEX_ATTRIBUTES{
+			{{.location = 0, .binding = 0, .format = VK_FORMAT_R32G32B32_SFLOAT, .offset = offsetof(MeshVertex, position)},
+			 {.location = 1, .binding = 0, .format = VK_FORMAT_R32G32B32_SFLOAT, .offset = offsetof(MeshVertex, normal)},
+			 {.location = 2, .binding = 0, .format = VK_FORMAT_R32G32_SFLOAT, .offset = offsetof(MeshVertex, uv)}}};
+
 	}  // namespace
 	// ANONYMOUS NAMESPACE END
 
+	auto hashPipelineDescription(const GraphicsPipelineDescription &description) -> uint64_t {
+		uint64_t hash = FNV_OFFSET_BASIS;
+		hashString(hash, description.vertexShader);
+		hashString(hash, description.fragmentShader);
+		hashValue(hash, description.colorFormat);
+		hashValue(hash, description.depthFormat);
+		hashValue(hash, description.vertexInput);
+		hashValue(hash, description.topology);
+		hashValue(hash, description.cullMode);
+		hashValue(hash, description.blendEnable);
+		for(const SpecializationConstant &constant : description.specializationConstants) {
+			hashValue(hash, constant.constantID);
+			hashValue(hash, constant.value);
+		}
+		return hash;
+	}
+
 	GraphicsPipeline::GraphicsPipeline(const std::shared_ptr<LogicalDevice> &logicalDevicePtr,
-																		 const std::shared_ptr<Swapchain> &swapchainPtr):
-		m_logicalDevice(logicalDevicePtr), m_swapchain(swapchainPtr) {
-		VkShaderModule vertexModule = createShaderModule("shaders/triangle.vert.spv");
-		VkShaderModule fragmentModule = createShaderModule("shaders/triangle.frag.spv");
-		auto shaderStages = createShaderStages({.vertex = vertexModule, .fragment = fragmentModule});
+																		 PipelineCache &pipelineCache, VkPipelineLayout pipelineLayout,
+																		 const GraphicsPipelineDescription &description,
+																		 const std::optional<std::filesystem::path> &shaderOverrideDirectory):
+		m_pipelineLayout(pipelineLayout), m_colorFormat(description.colorFormat), m_logicalDevice(logicalDevicePtr) {
+		const auto [vertexModule, fragmentModule] =
+			createShaderModules(m_logicalDevice->getHandle(), {description.vertexShader, description.fragmentShader},
+													shaderOverrideDirectory);
+		// both stages share the constants, an id a module does not declare is ignored by that stage.
+		std::vector<uint32_t> specializationData;
+		specializationData.reserve(description.specializationConstants.size());
+		for(const SpecializationConstant &constant : description.specializationConstants) {
+			specializationData.push_back(constant.value);
+		}
+		const std::vector<VkSpecializationMapEntry> specializationEntries =
+			createSpecializationEntries(description.specializationConstants);
+		const VkSpecializationInfo specializationInfo{
+			.mapEntryCount = static_cast<uint32_t>(specializationEntries.size()),
+			.pMapEntries = specializationEntries.data(),
+			.dataSize = specializationData.size() * sizeof(uint32_t),
+			.pData = specializationData.data()};
+		auto shaderStages =
+			createShaderStages({.vertex = vertexModule, .fragment = fragmentModule},
+												 specializationEntries.empty() ? nullptr : &specializationInfo);
 
 		std::vector<VkDynamicState> dynamicStates = {VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR};
 		VkPipelineDynamicStateCreateInfo dynamicStateInfo{
@@ -97,20 +160,21 @@ namespace venus {
 			.pDynamicStates = dynamicStates.data(),
 		};
 
+		const bool meshInput = description.vertexInput == VERTEX_INPUT_LAYOUT_MESH;
 		VkPipelineVertexInputStateCreateInfo vertexInputInfo{
 			.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO,
 			.pNext = nullptr,
 			.flags = 0,
-			.vertexBindingDescriptionCount = 0,
-			.pVertexBindingDescriptions = nullptr,
-			.vertexAttributeDescriptionCount = 0,
-			.pVertexAttributeDescriptions = nullptr};
+			.vertexBindingDescriptionCount = meshInput ? 1U : 0U,
+			.pVertexBindingDescriptions = meshInput ? &MESH_VERTEX_BINDING : nullptr,
+			.vertexAttributeDescriptionCount = meshInput ? static_cast<uint32_t>(MESH_VERTEX_ATTRIBUTES.size()) : 0U,
+			.pVertexAttributeDescriptions = meshInput ? MESH_VERTEX_ATTRIBUTES.data() : nullptr};
 
 		VkPipelineInputAssemblyStateCreateInfo inputAssemblyInfo{
 			.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO,
 			.pNext = nullptr,
 			.flags = 0,
-			.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST,
+			.topology = description.topology,
 			.primitiveRestartEnable = VK_FALSE};
 
 		VkPipelineViewportStateCreateInfo viewportStateInfo{.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO,
@@ -128,7 +192,7 @@ namespace venus {
 			.depthClampEnable = VK_FALSE,
 			.rasterizerDiscardEnable = VK_FALSE,
 			.polygonMode = VK_POLYGON_MODE_FILL,
-			.cullMode = VK_CULL_MODE_BACK_BIT,
+			.cullMode = description.cullMode,
 			.frontFace = VK_FRONT_FACE_CLOCKWISE,
 			.depthBiasEnable = VK_FALSE,
 			.depthBiasConstantFactor = 0.0F,
@@ -148,7 +212,7 @@ namespace venus {
 			.alphaToOneEnable = VK_FALSE};
 
 		VkPipelineColorBlendAttachmentState colorblendAttachmentStateInfo{
-			.blendEnable = VK_TRUE,
+			.blendEnable = description.blendEnable ? VK_TRUE : VK_FALSE,
 			.srcColorBlendFactor = VK_BLEND_FACTOR_SRC_ALPHA,
 			.dstColorBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_DST_ALPHA,
 			.colorBlendOp = VK_BLEND_OP_ADD,
@@ -168,22 +232,40 @@ namespace venus {
 			.pAttachments = &colorblendAttachmentStateInfo,
 			.blendConstants = {0.0F, 0.0F, 0.0F, 0.0F}};
 
-		VkPipelineLayoutCreateInfo pipelineLayoutInfo{.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
-																									.pNext = nullptr,
-																									.flags = 0,
-																									.setLayoutCount = 0,
-																									.pSetLayouts = nullptr,
-																									.pushConstantRangeCount = 0,
-																									.pPushConstantRanges = nullptr};
-
-		if(vkCreatePipelineLayout(m_logicalDevice->getHandle(), &pipelineLayoutInfo, nullptr, &m_pipelineLayout) !=
-			 VK_SUCCESS) {
-			VN_LOG_CRITICAL("Failed to create pipeline layout.");
-			throw std::runtime_error("Failed to create pipeline layout.");
-		}
+		// blended draws are not sorted, they are tested against the depth of opaque ones but do not write it.
+		const bool depthEnable = description.depthFormat != VK_FORMAT_UNDEFINED;
+		VkPipelineDepthStencilStateCreateInfo depthStencilStateInfo{
+			.sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO,
+			.pNext = nullptr,
+			.flags = 0,
+			.depthTestEnable = VK_TRUE,
+			.depthWriteEnable = description.blendEnable ? VK_FALSE : VK_TRUE,
+			.depthCompareOp = VK_COMPARE_OP_LESS_OR_EQUAL,
+			.depthBoundsTestEnable = VK_FALSE,
+			.stencilTestEnable = VK_FALSE,
+			.front = {},
+			.back = {},
+			.minDepthBounds = 0.0F,
+			.maxDepthBounds = 1.0F};
+
+		// attachment formats replace the render pass, any rendering instance with matching formats can use the pipeline.
+		VkPipelineCreationFeedback creationFeedback{};
+		VkPipelineCreationFeedbackCreateInfo feedbackInfo{.sType = VK_STRUCTURE_TYPE_PIPELINE_CREATION_FEEDBACK_CREATE_INFO,
+																											.pNext = nullptr,
+																											.pPipelineCreationFeedback = &creationFeedback,
+																											.pipelineStageCreationFeedbackCount = 0,
+																											.pPipelineStageCreationFeedbacks = nullptr};
+
+		VkPipelineRenderingCreateInfo renderingInfo{.sType = VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO,
+																								.pNext = &feedbackInfo,
+																								.viewMask = 0,
+																								.colorAttachmentCount = 1,
+																								.pColorAttachmentFormats = &m_colorFormat,
+																								.depthAttachmentFormat = description.depthFormat,
+																								.stencilAttachmentFormat = VK_FORMAT_UNDEFINED};
 
 		VkGraphicsPipelineCreateInfo createInfo{.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO,
-																						.pNext = nullptr,
+																						.pNext = &renderingInfo,
 																						.flags = 0,
 																						.stageCount = 2,
 																						.pStages = shaderStages.data(),
@@ -193,20 +275,25 @@ namespace venus {
 																						.pViewportState = &viewportStateInfo,
 																						.pRasterizationState = &rasterStateInfo,
 																						.pMultisampleState = &multisampleStateInfo,
-																						.pDepthStencilState = nullptr,
+																						.pDepthStencilState = depthEnable ? &depthStencilStateInfo : nullptr,
 																						.pColorBlendState = &colorBlendStateInfo,
 																						.pDynamicState = &dynamicStateInfo,
 																						.layout = m_pipelineLayout,
-																						.renderPass = m_swapchain->getRenderPass(),
+																						.renderPass = VK_NULL_HANDLE,
 																						.subpass = 0,
 																						.basePipelineHandle = VK_NULL_HANDLE,
 																						.basePipelineIndex = -1};
 
-		if(vkCreateGraphicsPipelines(m_logicalDevice->getHandle(), VK_NULL_HANDLE, 1, &createInfo, nullptr,
+		const auto CREATION_START = std::chrono::steady_clock::now();
+		if(vkCreateGraphicsPipelines(m_logicalDevice->getHandle(), pipelineCache.getHandle(), 1, &createInfo, nullptr,
 																 &m_graphicsPipeline) != VK_SUCCESS) {
+			// a failed compile is not fatal to the compiler thread that ran it, nothing may leak.
+			vkDestroyShaderModule(m_logicalDevice->getHandle(), vertexModule, nullptr);
+			vkDestroyShaderModule(m_logicalDevice->getHandle(), fragmentModule, nullptr);
 			VN_LOG_CRITICAL("Failed to create graphics pipeline.");
 			throw std::runtime_error("Failed to create graphics pipeline.");
 		}
+		pipelineCache.recordCreation(creationFeedback, std::chrono::steady_clock::now() - CREATION_START);
 
 		// shader modules can be destroyed after being loaded into the pipeline
 		vkDestroyShaderModule(m_logicalDevice->getHandle(), vertexModule, nullptr);
@@ -217,7 +304,6 @@ namespace venus {
 
 	GraphicsPipeline::~GraphicsPipeline() {
 		vkDestroyPipeline(m_logicalDevice->getHandle(), m_graphicsPipeline, nullptr);
-		vkDestroyPipelineLayout(m_logicalDevice->getHandle(), m_pipelineLayout, nullptr);
 
 		VN_LOG_INFO("GraphicsPipeline has been destructed.");
 	}
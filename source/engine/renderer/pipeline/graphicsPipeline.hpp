@@ -5,15 +5,57 @@
 #include "volk.h"
 
 // STDLIB
+#include <cstdint>
+#include <filesystem>
 #include <memory>
+#include <optional>
+#include <string>
+#include <vector>
 
 namespace venus {
 	class LogicalDevice;
-	class Swapchain;
+	class PipelineCache;
+
+	// A 32-bit specialization constant, bools, ints and floats are all passed as their bit pattern.
+	struct SpecializationConstant {
+		uint32_t constantID;
+		uint32_t value;
+	};
+
+	// The vertex buffers a pipeline reads, pipelines without one generate their vertices in the vertex shader.
+	enum VertexInputLayout : uint8_t {
+		VERTEX_INPUT_LAYOUT_NONE = 0,
+		VERTEX_INPUT_LAYOUT_MESH = 1  // MeshVertex interleaved in binding 0, see MeshRegistry.
+	};
+
+	// Everything a graphics pipeline is built from, shader names are file names in source/shaders such as "mesh.vert".
+	// Specialization constants apply to both stages, so variants of one shader pair differ only in the constants and
+	// the fixed function state below. See PipelineVariantCache for building them on demand.
+	struct GraphicsPipelineDescription {
+		std::string vertexShader;
+		std::string fragmentShader;
+		VkFormat colorFormat;
+		VkFormat depthFormat = VK_FORMAT_UNDEFINED;  // without a depth attachment the depth test is disabled.
+		VertexInputLayout vertexInput = VERTEX_INPUT_LAYOUT_NONE;
+		VkPrimitiveTopology topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+		VkCullModeFlags cullMode = VK_CULL_MODE_BACK_BIT;
+		bool blendEnable = true;
+		std::vector<SpecializationConstant> specializationConstants;
+	};
+
+	// 64-bit key of a description covering its shaders, fixed function state and constants in order.
+	[[nodiscard]] auto hashPipelineDescription(const GraphicsPipelineDescription &description) -> uint64_t;
+
 	class GraphicsPipeline {
 	public:
-		explicit GraphicsPipeline(const std::shared_ptr<LogicalDevice> &logicalDevicePtr,
-															const std::shared_ptr<Swapchain> &swapchainPtr);
+		// Built for dynamic rendering, 'description.colorFormat' is the format of the single color attachment it renders
+		// into. With a depth format draws are depth tested, blended ones without writing depth. 'pipelineLayout' is the
+		// bindless layout shared by every pipeline, it must outlive the pipeline.
+		// Shaders come from the binary unless a development override directory provides them, see createShaderModule.
+		// Blocks while the driver compiles, use a PipelineCompiler to build pipelines in the background.
+		explicit GraphicsPipeline(const std::shared_ptr<LogicalDevice> &logicalDevicePtr, PipelineCache &pipelineCache,
+															VkPipelineLayout pipelineLayout, const GraphicsPipelineDescription &description,
+															const std::optional<std::filesystem::path> &shaderOverrideDirectory);
 		~GraphicsPipeline();
 
 		GraphicsPipeline(const GraphicsPipeline &) = delete;
@@ -23,13 +65,15 @@ namespace venus {
 		auto operator=(const GraphicsPipeline &&) -> GraphicsPipeline & = delete;
 
 		[[nodiscard]] auto getHandle() const { return m_graphicsPipeline; }
+		[[nodiscard]] auto getLayout() const { return m_pipelineLayout; }
+		[[nodiscard]] auto getColorFormat() const { return m_colorFormat; }
 
 	private:
 		VkPipeline m_graphicsPipeline = VK_NULL_HANDLE;
-		VkPipelineLayout m_pipelineLayout = VK_NULL_HANDLE;
+		VkPipelineLayout m_pipelineLayout = VK_NULL_HANDLE;  // not owned, see BindlessDescriptors.
+		VkFormat m_colorFormat = VK_FORMAT_UNDEFINED;
 
 		std::shared_ptr<LogicalDevice> m_logicalDevice;
-		std::shared_ptr<Swapchain> m_swapchain;
 	};
 
 }  // namespace venus
@@ -0,0 +1,250 @@
+#include "pipelineCache.hpp"
+#include "VN_logger.hpp"
+#include "logicalDevice.hpp"
+
+// STDLIB
+#include <algorithm>
+#include <array>
+#include <format>
+#include <fstream>
+#include <span>
+#include <stdexcept>
+#include <system_error>
+#include <type_traits>
+#include <vector>
+
+namespace venus {
+	namespace {  // ANONYMOUS NAMESPACE BEGIN
+		constexpr uint32_t CACHE_FILE_MAGIC = 0x43504E56;  // "VNPC" in little endian.
+		constexpr uint32_t CACHE_FILE_VERSION = 1;
+
+		struct CacheFileHeader {
+			uint32_t magic;
+			uint32_t fileVersion;
+			uint32_t vendorID;
+			uint32_t deviceID;
+			uint32_t driverVersion;
+			uint32_t reserved;
+			std::array<uint8_t, VK_UUID_SIZE> driverUUID;
+			std::array<uint8_t, VK_UUID_SIZE> pipelineCacheUUID;
+			uint64_t dataSize;
+			uint64_t dataChecksum;
+		};
+		static_assert(std::is_trivially_copyable_v<CacheFileHeader>);
+		static_assert(sizeof(CacheFileHeader) == 72, "the header must not contain padding.");
+
+		auto checksum(std::span<const std::byte> data) -> uint64_t {
+			// fnv-1a, only guards against truncated or corrupted files so it does not need to be cryptographic.
+			uint64_t hash = 14695981039346656037ULL;
+			for(const std::byte &byte : data) {
+				hash ^= static_cast<uint64_t>(byte);
+				hash *= 1099511628211ULL;
+			}
+			return hash;
+		}
+
+		auto expectedHeader(const LogicalDevice &logicalDevice) -> CacheFileHeader {
+			const VkPhysicalDeviceProperties &properties = logicalDevice.physicalDeviceProperties();
+
+			CacheFileHeader header{};
+			header.magic = CACHE_FILE_MAGIC;
+			header.fileVersion = CACHE_FILE_VERSION;
+			header.vendorID = properties.vendorID;
+			header.deviceID = properties.deviceID;
+			header.driverVersion = properties.driverVersion;
+			header.driverUUID = logicalDevice.driverUUID();
+			std::ranges::copy(properties.pipelineCacheUUID, header.pipelineCacheUUID.begin());
+			return header;
+		}
+
+		auto matchesDevice(const CacheFileHeader &header, const CacheFileHeader &expected) -> bool {
+			return header.magic == expected.magic && header.fileVersion == expected.fileVersion &&
+						 header.vendorID == expected.vendorID && header.deviceID == expected.deviceID &&
+						 header.driverVersion == expected.driverVersion && header.driverUUID == expected.driverUUID &&
+						 header.pipelineCacheUUID == expected.pipelineCacheUUID;
+		}
+
+		// Returns the driver data stored in the file, or nothing when it is missing or was not written for this device.
+		auto readCacheFile(const std::filesystem::path &filePath, const CacheFileHeader &expected)
+			-> std::optional<std::vector<std::byte>> {
+			std::ifstream file(filePath, std::ios::binary);
+			if(!file.is_open()) {
+				return std::nullopt;
+			}
+
+			CacheFileHeader header{};
+			if(!file.read(reinterpret_cast<char *>(&header), sizeof(header))) {
+				VN_LOG_WARN(std::format("Pipeline cache '{}' is truncated, ignoring it.", filePath.string()));
+				return std::nullopt;
+			}
+			if(!matchesDevice(header, expected)) {
+				VN_LOG_INFO(std::format("Pipeline cache '{}' was written by another device or driver, ignoring it.",
+																filePath.string()));
+				return std::nullopt;
+			}
+
+			std::error_code error;
+			const uintmax_t fileSize = std::filesystem::file_size(filePath, error);
+			if(error || fileSize != sizeof(header) + header.dataSize) {
+				VN_LOG_WARN(std::format("Pipeline cache '{}' has an unexpected size, ignoring it.", filePath.string()));
+				return std::nullopt;
+			}
+
+			std::vector<std::byte> data(header.dataSize);
+			if(!file.read(reinterpret_cast<char *>(data.data()), static_cast<std::streamsize>(data.size())) ||
+				 checksum(data) != header.dataChecksum) {
+				VN_LOG_WARN(std::format("Pipeline cache '{}' is corrupt, ignoring it.", filePath.string()));
+				return std::nullopt;
+			}
+			return data;
+		}
+
+		auto createCache(VkDevice device, std::span<const std::byte> initialData) -> VkPipelineCache {
+			const VkPipelineCacheCreateInfo createInfo{.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO,
+																								 .pNext = nullptr,
+																								 .flags = 0,
+																								 .initialDataSize = initialData.size(),
+																								 .pInitialData = initialData.data()};
+
+			VkPipelineCache pipelineCache = VK_NULL_HANDLE;
+			if(vkCreatePipelineCache(device, &createInfo, nullptr, &pipelineCache) != VK_SUCCESS) {
+				return VK_NULL_HANDLE;
+			}
+			return pipelineCache;
+		}
+	}  // namespace
+	// ANONYMOUS NAMESPACE END
+
+	PipelineCache::PipelineCache(const std::shared_ptr<LogicalDevice> &logicalDevicePtr,
+															 const std::optional<std::filesystem::path> &filePath):
+		m_logicalDevice(logicalDevicePtr), m_filePath(filePath) {
+		std::optional<std::vector<std::byte>> diskData;
+		if(m_filePath.has_value()) {
+			diskData = readCacheFile(m_filePath.value(), expectedHeader(*m_logicalDevice));
+		}
+
+		if(diskData.has_value()) {
+			m_pipelineCache = createCache(m_logicalDevice->getHandle(), diskData.value());
+			if(m_pipelineCache != VK_NULL_HANDLE) {
+				m_diskDataChecksum = checksum(diskData.value());
+				m_loadedFromDisk = true;
+			} else {
+				VN_LOG_WARN("Driver rejected the pipeline cache read from disk, starting with an empty cache.");
+			}
+		}
+
+		if(m_pipelineCache == VK_NULL_HANDLE) {
+			m_pipelineCache = createCache(m_logicalDevice->getHandle(), {});
+			if(m_pipelineCache == VK_NULL_HANDLE) {
+				VN_LOG_CRITICAL("Failed to create pipeline cache.");
+				throw std::runtime_error("Failed to create pipeline cache.");
+			}
+		}
+
+		VN_LOG_INFO(std::format("Pipeline cache created{}.",
+														m_loadedFromDisk ? std::format(" from '{}'", m_filePath->string()) : " empty"));
+	}
+
+	PipelineCache::~PipelineCache() {
+		save();
+
+		const PipelineCacheStatistics statistics = getStatistics();
+		VN_LOG_INFO(std::format("Pipeline cache: {} hits, {} misses, {} unreported, {:.3f} ms spent creating pipelines.",
+														statistics.hitCount, statistics.missCount,
+														m_unreportedCount.load(std::memory_order_relaxed), statistics.creationMilliseconds));
+
+		vkDestroyPipelineCache(m_logicalDevice->getHandle(), m_pipelineCache, nullptr);
+	}
+
+	void PipelineCache::recordCreation(const VkPipelineCreationFeedback &feedback,
+																		 const std::chrono::nanoseconds &duration) {
+		m_creationNanoseconds.fetch_add(duration.count(), std::memory_order_relaxed);
+
+		if((feedback.flags & VK_PIPELINE_CREATION_FEEDBACK_VALID_BIT) == 0) {
+			m_unreportedCount.fetch_add(1, std::memory_order_relaxed);
+		} else if((feedback.flags & VK_PIPELINE_CREATION_FEEDBACK_APPLICATION_PIPELINE_CACHE_HIT_BIT) != 0) {
+			m_hitCount.fetch_add(1, std::memory_order_relaxed);
+		} else {
+			m_missCount.fetch_add(1, std::memory_order_relaxed);
+		}
+	}
+
+	auto PipelineCache::getStatistics() const -> PipelineCacheStatistics {
+		return {.hitCount = m_hitCount.load(std::memory_order_relaxed),
+						.missCount = m_missCount.load(std::memory_order_relaxed),
+						.creationMilliseconds =
+							static_cast<double>(m_creationNanoseconds.load(std::memory_order_relaxed)) / 1000000.0,
+						.loadedFromDisk = m_loadedFromDisk};
+	}
+
+	void PipelineCache::save() {
+		if(!m_filePath.has_value()) {
+			return;
+		}
+
+		const VkDevice device = m_logicalDevice->getHandle();
+		const std::filesystem::path &filePath = m_filePath.value();
+		CacheFileHeader header = expectedHeader(*m_logicalDevice);
+
+		// another process may have saved since we loaded, keep its pipelines rather than overwriting them.
+		const std::optional<std::vector<std::byte>> diskData = readCacheFile(filePath, header);
+		if(diskData.has_value() && checksum(diskData.value()) != m_diskDataChecksum) {
+			VkPipelineCache diskCache = createCache(device, diskData.value());
+			if(diskCache != VK_NULL_HANDLE) {
+				if(vkMergePipelineCaches(device, m_pipelineCache, 1, &diskCache) != VK_SUCCESS) {
+					VN_LOG_WARN("Failed to merge the pipeline cache on disk, its pipelines will be overwritten.");
+				}
+				vkDestroyPipelineCache(device, diskCache, nullptr);
+			}
+		}
+
+		size_t dataSize = 0;
+		std::vector<std::byte> data;
+		if(vkGetPipelineCacheData(device, m_pipelineCache, &dataSize, nullptr) == VK_SUCCESS) {
+			data.resize(dataSize);
+		}
+		if(data.empty() || vkGetPipelineCacheData(device, m_pipelineCache, &dataSize, data.data()) != VK_SUCCESS) {
+			VN_LOG_WARN("Failed to read back pipeline cache data, it is not saved.");
+			return;
+		}
+		data.resize(dataSize);
+
+		header.dataSize = data.size();
+		header.dataChecksum = checksum(data);
+		if(header.dataChecksum == m_diskDataChecksum) {
+			return;  // nothing was added since the cache was loaded or last saved.
+		}
+
+		// written next to the destination so the rename stays on one filesystem and replaces the file atomically.
+		std::filesystem::path temporaryPath = filePath;
+		temporaryPath += ".tmp";
+
+		std::error_code error;
+		if(filePath.has_parent_path()) {
+			std::filesystem::create_directories(filePath.parent_path(), error);
+		}
+
+		{
+			std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+			file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+			file.write(reinterpret_cast<const char *>(data.data()), static_cast<std::streamsize>(data.size()));
+			file.close();
+			if(!file) {
+				VN_LOG_WARN(std::format("Failed to write pipeline cache '{}'.", temporaryPath.string()));
+				std::filesystem::remove(temporaryPath, error);
+				return;
+			}
+		}
+
+		std::filesystem::rename(temporaryPath, filePath, error);
+		if(error) {
+			VN_LOG_WARN(std::format("Failed to replace pipeline cache '{}': {}", filePath.string(), error.message()));
+			std::filesystem::remove(temporaryPath, error);
+			return;
+		}
+
+		m_diskDataChecksum = header.dataChecksum;
+		VN_LOG_INFO(std::format("Saved {} bytes of pipeline cache to '{}'.", data.size(), filePath.string()));
+	}
+
+}  // namespace venus
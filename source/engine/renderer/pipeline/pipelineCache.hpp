@@ -0,0 +1,82 @@
+#ifndef VENUS_PIPELINE_CACHE_HPP
+#define VENUS_PIPELINE_CACHE_HPP
+
+// THIRD PARTY
+#include "volk.h"
+
+// STDLIB
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <optional>
+
+namespace venus {
+	class LogicalDevice;
+
+	struct PipelineCacheStatistics {
+		uint32_t hitCount;
+		uint32_t missCount;
+		double creationMilliseconds;
+		bool loadedFromDisk;
+	};
+
+	/**
+   * @brief A VkPipelineCache persisted to disk between runs.
+   *
+   * @details The file starts with a venus header recording the vendor id, device id, driver version, driverUUID and
+   *          pipelineCacheUUID of the device that wrote it, followed by the driver's cache data and a checksum over it.
+   *          A file written by another device or driver, or one that is truncated or corrupt, is ignored and the cache
+   *          starts empty, drivers are not required to survive bad cache data so it never reaches them.
+   *
+   *          'save()' first merges whatever another process wrote to the file since it was loaded, then writes to a
+   *          temporary file and renames it over the old one so a crash never leaves a partially written cache behind.
+   *          Nothing is written when no pipeline was added. The destructor saves, errors while saving are only logged.
+   *
+   *          Pipelines report through 'recordCreation()' whether the driver found them in the cache, using the core
+   *          pipeline creation feedback, a hit/miss summary is logged when the cache is destroyed.
+   *
+   *          The handle may be used from several threads at once, as allowed by the Vulkan spec.
+   *
+   *          This object cannot be copied. This object cannot be moved.
+   */
+	class PipelineCache {
+	public:
+		// Without a file path the cache only lives for this run.
+		explicit PipelineCache(const std::shared_ptr<LogicalDevice> &logicalDevicePtr,
+													 const std::optional<std::filesystem::path> &filePath);
+		~PipelineCache();
+
+		PipelineCache(const PipelineCache &) = delete;
+		auto operator=(const PipelineCache &) -> PipelineCache & = delete;
+
+		PipelineCache(const PipelineCache &&) = delete;
+		auto operator=(const PipelineCache &&) -> PipelineCache & = delete;
+
+		[[nodiscard]] auto getHandle() const -> VkPipelineCache { return m_pipelineCache; }
+
+		// 'feedback' comes from a VkPipelineCreationFeedbackCreateInfo chained into the pipeline create info.
+		void recordCreation(const VkPipelineCreationFeedback &feedback, const std::chrono::nanoseconds &duration);
+		[[nodiscard]] auto getStatistics() const -> PipelineCacheStatistics;
+
+		void save();
+
+	private:
+		std::shared_ptr<LogicalDevice> m_logicalDevice;
+		VkPipelineCache m_pipelineCache = VK_NULL_HANDLE;
+
+		std::optional<std::filesystem::path> m_filePath;
+		// checksum of the driver data as last read from or written to disk, used to detect changes on either side.
+		uint64_t m_diskDataChecksum = 0;
+		bool m_loadedFromDisk = false;
+
+		std::atomic<uint32_t> m_hitCount = 0;
+		std::atomic<uint32_t> m_missCount = 0;
+		std::atomic<uint32_t> m_unreportedCount = 0;
+		std::atomic<int64_t> m_creationNanoseconds = 0;
+	};
+
+}  // namespace venus
+
+#endif  // VENUS_PIPELINE_CACHE_HPP
@@ -0,0 +1,202 @@
+#include "pipelineCompiler.hpp"
+#include "VN_logger.hpp"
+#include "deletionQueue.hpp"
+#include "logicalDevice.hpp"
+#include "pipelineCache.hpp"
+
+// STDLIB
+#include <algorithm>
+#include <exception>
+#include <format>
+#include <stdexcept>
+
+namespace venus {
+
+	PipelineCompiler::PipelineCompiler(const std::shared_ptr<LogicalDevice> &logicalDevicePtr,
+																		 PipelineCache &pipelineCache, VkPipelineLayout pipelineLayout,
+																		 const std::optional<std::filesystem::path> &shaderOverrideDirectory,
+																		 const uint32_t &threadCount):
+		m_logicalDevice(logicalDevicePtr), m_pipelineCache(pipelineCache), m_pipelineLayout(pipelineLayout),
+		m_shaderOverrideDirectory(shaderOverrideDirectory),
+		m_slots(std::make_unique<Slot[]>(MAX_COMPILED_PIPELINES)) {
+		const uint32_t compilerThreads = std::clamp(threadCount, 1U, MAX_PIPELINE_COMPILER_THREADS);
+		m_threads.reserve(compilerThreads);
+		for(uint32_t i = 0; i < compilerThreads; ++i) {
+			m_threads.emplace_back([this]() { compileLoop(); });
+		}
+
+		VN_LOG_INFO(std::format("Pipeline compiler started with {} threads.", compilerThreads));
+	}
+
+	PipelineCompiler::~PipelineCompiler() {
+		uint32_t cancelledCount = 0;
+		{
+			const std::scoped_lock lock(m_queueMutex);
+			cancelledCount = static_cast<uint32_t>(m_queue.size());
+			m_queue.clear();
+			m_stopping = true;
+		}
+		m_queueCondition.notify_all();
+		m_threads.clear();
+
+		if(cancelledCount != 0) {
+			VN_LOG_INFO(std::format("Pipeline compiler cancelled {} queued pipelines.", cancelledCount));
+		}
+		VN_LOG_INFO("Pipeline compiler has been destroyed.");
+	}
+
+	auto PipelineCompiler::request(const GraphicsPipelineDescription &description) -> PipelineHandle {
+		const std::scoped_lock lock(m_requestMutex);
+		const uint32_t index = m_slotCount.load(std::memory_order_relaxed);
+		if(index == MAX_COMPILED_PIPELINES) {
+			VN_LOG_CRITICAL(std::format("Pipeline compiler is full, at most {} pipelines may be requested.",
+																	MAX_COMPILED_PIPELINES));
+			throw std::runtime_error("Pipeline compiler is full.");
+		}
+
+		// the description is written before the count is published, 'rebuildUsing()' may read it from another thread.
+		m_slots[index].description = description;
+		m_slotCount.store(index + 1, std::memory_order_release);
+		enqueue(index);
+		return {.index = index};
+	}
+
+	auto PipelineCompiler::getStatus(const PipelineHandle &handle) const -> PipelineStatus {
+		if(!handle.isValid() || handle.index >= MAX_COMPILED_PIPELINES) {
+			return PIPELINE_STATUS_FAILED;
+		}
+		return m_slots[handle.index].status.load(std::memory_order_acquire);
+	}
+
+	auto PipelineCompiler::getPipeline(const PipelineHandle &handle) const -> const GraphicsPipeline * {
+		// the acquire in 'getStatus' pairs with the release publishing the slot, the pipeline is fully built once seen.
+		if(getStatus(handle) != PIPELINE_STATUS_READY) {
+			return nullptr;
+		}
+		return m_slots[handle.index].pipeline.get();
+	}
+
+	auto PipelineCompiler::rebuildUsing(std::string_view shaderName) -> uint32_t {
+		uint32_t rebuildCount = 0;
+		const uint32_t slotCount = m_slotCount.load(std::memory_order_acquire);
+		for(uint32_t index = 0; index < slotCount; ++index) {
+			const GraphicsPipelineDescription &description = m_slots[index].description;
+			if(description.vertexShader == shaderName || description.fragmentShader == shaderName) {
+				enqueue(index);
+				++rebuildCount;
+			}
+		}
+		return rebuildCount;
+	}
+
+	void PipelineCompiler::swapRebuilt(DeletionQueue &deletionQueue, const uint64_t &lastUseFrameValue) {
+		if(m_replacementCount.load(std::memory_order_acquire) == 0) {
+			return;
+		}
+
+		const uint32_t slotCount = m_slotCount.load(std::memory_order_acquire);
+		for(uint32_t index = 0; index < slotCount; ++index) {
+			Slot &slot = m_slots[index];
+			// a compiler thread handing over a build holds the lock only briefly, that slot is swapped next frame.
+			const std::unique_lock lock(slot.mutex, std::try_to_lock);
+			if(!lock.owns_lock() || slot.replacement == nullptr) {
+				continue;
+			}
+
+			// deletion entries must be copyable, the retired pipeline is destroyed when its entry is flushed.
+			std::swap(slot.pipeline, slot.replacement);
+			deletionQueue.retire(lastUseFrameValue,
+													 [retired = std::shared_ptr<GraphicsPipeline>(std::move(slot.replacement))]() mutable {
+														 retired.reset();
+													 });
+			m_replacementCount.fetch_sub(1, std::memory_order_relaxed);
+		}
+	}
+
+	void PipelineCompiler::waitIdle() {
+		uint32_t pendingCount = m_pendingCount.load(std::memory_order_acquire);
+		while(pendingCount != 0) {
+			m_pendingCount.wait(pendingCount, std::memory_order_acquire);
+			pendingCount = m_pendingCount.load(std::memory_order_acquire);
+		}
+	}
+
+	void PipelineCompiler::enqueue(const uint32_t &slotIndex) {
+		Slot &slot = m_slots[slotIndex];
+		{
+			const std::scoped_lock lock(m_queueMutex);
+			// a build still waiting in the queue will read the latest shaders anyway, it only needs a newer generation.
+			++slot.requestedGeneration;
+			if(slot.queued) {
+				return;
+			}
+			slot.queued = true;
+			m_queue.push_back(slotIndex);
+			m_pendingCount.fetch_add(1, std::memory_order_relaxed);
+		}
+		m_queueCondition.notify_one();
+	}
+
+	void PipelineCompiler::compileLoop() {
+		while(true) {
+			uint32_t slotIndex = 0;
+			uint64_t generation = 0;
+			{
+				std::unique_lock lock(m_queueMutex);
+				m_queueCondition.wait(lock, [this]() { return m_stopping || !m_queue.empty(); });
+				if(m_stopping) {
+					return;
+				}
+				slotIndex = m_queue.front();
+				m_queue.pop_front();
+
+				// the generation is taken when the build starts, a change after this point queues the slot again.
+				Slot &slot = m_slots[slotIndex];
+				slot.queued = false;
+				generation = slot.requestedGeneration;
+			}
+
+			compile(m_slots[slotIndex], generation);
+			m_pendingCount.fetch_sub(1, std::memory_order_release);
+			m_pendingCount.notify_all();
+		}
+	}
+
+	void PipelineCompiler::compile(Slot &slot, const uint64_t &generation) {
+		std::unique_ptr<GraphicsPipeline> pipeline;
+		try {
+			pipeline = std::make_unique<GraphicsPipeline>(m_logicalDevice, m_pipelineCache, m_pipelineLayout,
+																										slot.description, m_shaderOverrideDirectory);
+		} catch(const std::exception &e) {
+			VN_LOG_ERROR(std::format("Failed to compile pipeline '{}' + '{}': {}", slot.description.vertexShader,
+															 slot.description.fragmentShader, e.what()));
+		}
+
+		const std::scoped_lock lock(slot.mutex);
+		if(generation < slot.builtGeneration) {
+			return;  // a newer build of this slot finished first, this one was never used and is destroyed here.
+		}
+		slot.builtGeneration = generation;
+
+		// a failed pipeline only loses its own draws, a failed rebuild keeps drawing with the pipeline it replaces.
+		if(pipeline == nullptr) {
+			if(slot.status.load(std::memory_order_relaxed) != PIPELINE_STATUS_READY) {
+				slot.status.store(PIPELINE_STATUS_FAILED, std::memory_order_release);
+			}
+			return;
+		}
+
+		// until a slot is first published only compiler threads touch its pipeline, after that only 'swapRebuilt()'.
+		if(slot.status.load(std::memory_order_relaxed) != PIPELINE_STATUS_READY) {
+			slot.pipeline = std::move(pipeline);
+			slot.status.store(PIPELINE_STATUS_READY, std::memory_order_release);
+			return;
+		}
+
+		if(slot.replacement == nullptr) {
+			m_replacementCount.fetch_add(1, std::memory_order_release);
+		}
+		slot.replacement = std::move(pipeline);
+	}
+
+}  // namespace venus
@@ -0,0 +1,140 @@
+#ifndef VENUS_PIPELINE_COMPILER_HPP
+#define VENUS_PIPELINE_COMPILER_HPP
+
+// PROJECT
+#include "graphicsPipeline.hpp"
+#include "renderConfig.hpp"
+
+// STDLIB
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace venus {
+	class LogicalDevice;
+	class PipelineCache;
+	class DeletionQueue;
+
+	enum PipelineStatus : uint8_t { PIPELINE_STATUS_PENDING = 0, PIPELINE_STATUS_READY = 1, PIPELINE_STATUS_FAILED = 2 };
+
+	// Refers to a pipeline requested from a PipelineCompiler, it stays valid for the compiler's lifetime.
+	struct PipelineHandle {
+		uint32_t index = UINT32_MAX;
+
+		[[nodiscard]] auto isValid() const -> bool { return index != UINT32_MAX; }
+	};
+
+	/**
+   * @brief Compiles graphics pipelines on a pool of background threads.
+   *
+   * @details 'request()' queues a description and returns a handle straight away, the renderer polls the handle every
+   *          frame and skips the draws of a pipeline that is not ready yet. Driver compilation therefore never blocks
+   *          startup or the frame loop, and many requested pipelines compile side by side instead of one after another.
+   *
+   *          The threads are the compiler's own rather than the job system's. A compile can take far longer than a
+   *          frame, and a thread waiting on recording jobs would otherwise pick one up and stall the frame with it.
+   *
+   *          Pipelines live in a fixed array of MAX_COMPILED_PIPELINES slots that never moves, a slot is published with
+   *          a release store of its status so 'getPipeline()' is a single atomic load. Requesting is meant for load time
+   *          and may allocate, polling does not.
+   *
+   *          A built pipeline can be rebuilt, for instance after one of its shaders was recompiled. The old pipeline
+   *          keeps being returned while its replacement compiles, 'swapRebuilt()' then swaps them in between frames
+   *          and retires the old one, so nothing waits for the device to idle. A rebuild that fails keeps the old one.
+   *
+   *          Destruction cancels queued requests and waits for those already compiling. The pipelines are destroyed
+   *          with the compiler, so the gpu must be done with them by then.
+   *
+   *          This object cannot be copied. This object cannot be moved.
+   */
+	class PipelineCompiler {
+	public:
+		// Every pipeline is built with 'pipelineLayout', the bindless layout.
+		explicit PipelineCompiler(const std::shared_ptr<LogicalDevice> &logicalDevicePtr, PipelineCache &pipelineCache,
+															VkPipelineLayout pipelineLayout,
+															const std::optional<std::filesystem::path> &shaderOverrideDirectory,
+															const uint32_t &threadCount);
+		~PipelineCompiler();
+
+		PipelineCompiler(const PipelineCompiler &) = delete;
+		auto operator=(const PipelineCompiler &) -> PipelineCompiler & = delete;
+
+		PipelineCompiler(const PipelineCompiler &&) = delete;
+		auto operator=(const PipelineCompiler &&) -> PipelineCompiler & = delete;
+
+		// Any thread, each call is a new pipeline, see PipelineVariantCache for reusing equal descriptions.
+		// Throws once MAX_COMPILED_PIPELINES pipelines have been requested.
+		[[nodiscard]] auto request(const GraphicsPipelineDescription &description) -> PipelineHandle;
+
+		[[nodiscard]] auto getStatus(const PipelineHandle &handle) const -> PipelineStatus;
+
+		// Nullptr until the pipeline is ready, and for good if it failed to compile. Must be called from the thread that
+		// calls 'swapRebuilt()', the returned pipeline stays valid until that thread swaps it out.
+		[[nodiscard]] auto getPipeline(const PipelineHandle &handle) const -> const GraphicsPipeline *;
+
+		// Queues a rebuild of every requested pipeline using 'shaderName' and returns how many that are.
+		// Any thread, shader modules are created anew so an override written since the first build is picked up.
+		auto rebuildUsing(std::string_view shaderName) -> uint32_t;
+
+		// Puts finished rebuilds in place of the pipelines they replace. The replaced pipelines may still be used by
+		// frames in flight, they are retired to 'deletionQueue' until 'lastUseFrameValue' completes.
+		// Costs a single atomic load while no rebuild has finished, call it once per frame before recording.
+		void swapRebuilt(DeletionQueue &deletionQueue, const uint64_t &lastUseFrameValue);
+
+		// Blocks until every request made so far has finished compiling, successfully or not.
+		void waitIdle();
+
+		[[nodiscard]] auto getPendingCount() const -> uint32_t { return m_pendingCount.load(std::memory_order_acquire); }
+
+	private:
+		std::shared_ptr<LogicalDevice> m_logicalDevice;
+		PipelineCache &m_pipelineCache;
+		VkPipelineLayout m_pipelineLayout = VK_NULL_HANDLE;
+		std::optional<std::filesystem::path> m_shaderOverrideDirectory;
+
+		struct Slot {
+			GraphicsPipelineDescription description;
+			std::unique_ptr<GraphicsPipeline> pipeline;
+			std::atomic<PipelineStatus> status = PIPELINE_STATUS_PENDING;
+
+			// guarded by 'm_queueMutex', a slot is queued at most once and every queueing bumps its generation.
+			bool queued = false;
+			uint64_t requestedGeneration = 0;
+
+			// guarded by 'mutex', a finished rebuild waiting for 'swapRebuilt()'. Builds finishing out of order are
+			// dropped by generation so an older build never replaces a newer one.
+			std::mutex mutex;
+			std::unique_ptr<GraphicsPipeline> replacement;
+			uint64_t builtGeneration = 0;
+		};
+		std::unique_ptr<Slot[]> m_slots;
+		std::mutex m_requestMutex;
+		std::atomic<uint32_t> m_slotCount = 0;
+
+		std::mutex m_queueMutex;
+		std::condition_variable m_queueCondition;
+		std::deque<uint32_t> m_queue;
+		bool m_stopping = false;
+
+		std::atomic<uint32_t> m_pendingCount = 0;
+		std::atomic<uint32_t> m_replacementCount = 0;
+
+		void enqueue(const uint32_t &slotIndex);
+		void compileLoop();
+		void compile(Slot &slot, const uint64_t &generation);
+
+		// declared last so every member above is constructed before the threads start and outlives their join.
+		std::vector<std::jthread> m_threads;
+	};
+
+}  // namespace venus
+
+#endif  // VENUS_PIPELINE_COMPILER_HPP
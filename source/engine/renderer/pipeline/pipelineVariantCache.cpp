@@ -0,0 +1,58 @@
+#include "pipelineVariantCache.hpp"
+#include "VN_logger.hpp"
+
+// STDLIB
+#include <format>
+
+namespace venus {
+
+	PipelineVariantCache::PipelineVariantCache(PipelineCompiler &pipelineCompiler):
+		m_pipelineCompiler(pipelineCompiler) {}
+
+	auto PipelineVariantCache::find(const uint64_t &key) const -> PipelineHandle {
+		const uint64_t wantedKey = storedKey(key);
+		for(uint32_t probe = 0; probe < TABLE_CAPACITY; ++probe) {
+			const Entry &entry = m_entries[(wantedKey + probe) & (TABLE_CAPACITY - 1)];
+			// pairs with the release store publishing the entry, its handle is visible once the key is.
+			const uint64_t entryKey = entry.key.load(std::memory_order_acquire);
+			if(entryKey == wantedKey) {
+				return {.index = entry.handleIndex.load(std::memory_order_relaxed)};
+			}
+			if(entryKey == EMPTY_KEY) {
+				break;
+			}
+		}
+		return {};
+	}
+
+	auto PipelineVariantCache::getOrCreate(const uint64_t &key, const GraphicsPipelineDescription &description)
+		-> PipelineHandle {
+		const PipelineHandle existing = find(key);
+		if(existing.isValid()) {
+			return existing;
+		}
+
+		const std::scoped_lock lock(m_insertMutex);
+		// another thread may have created it between the lookup and taking the lock.
+		const PipelineHandle raced = find(key);
+		if(raced.isValid()) {
+			return raced;
+		}
+
+		const PipelineHandle handle = m_pipelineCompiler.request(description);
+		const uint64_t wantedKey = storedKey(key);
+		for(uint32_t probe = 0; probe < TABLE_CAPACITY; ++probe) {
+			Entry &entry = m_entries[(wantedKey + probe) & (TABLE_CAPACITY - 1)];
+			if(entry.key.load(std::memory_order_relaxed) == EMPTY_KEY) {
+				entry.handleIndex.store(handle.index, std::memory_order_relaxed);
+				entry.key.store(wantedKey, std::memory_order_release);
+				break;
+			}
+		}
+
+		const uint32_t variantCount = m_variantCount.fetch_add(1, std::memory_order_relaxed) + 1;
+		VN_LOG_INFO(std::format("Pipeline variant {:016x} requested, {} variants.", key, variantCount));
+		return handle;
+	}
+
+}  // namespace venus
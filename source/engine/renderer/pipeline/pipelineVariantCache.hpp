@@ -0,0 +1,78 @@
+#ifndef VENUS_PIPELINE_VARIANT_CACHE_HPP
+#define VENUS_PIPELINE_VARIANT_CACHE_HPP
+
+// PROJECT
+#include "pipelineCompiler.hpp"
+#include "renderConfig.hpp"
+
+// STDLIB
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+
+namespace venus {
+
+	/**
+   * @brief Pipeline variants keyed by the hash of their description, created on first use.
+   *
+   * @details Variants of one shader pair differ in specialization constants and fixed function state, each is a
+   *          separate pipeline compiled with branch free specialized code. A variant is looked up by the 64-bit key from
+   *          hashPipelineDescription, callers that draw often compute the key once and pass it alongside the description.
+   *          The first lookup of an unknown key requests the variant from the PipelineCompiler and returns its handle,
+   *          which stays pending until the background compile finishes.
+   *
+   *          The map is read-mostly. It is a fixed open addressing table sized for every pipeline the compiler can
+   *          hold, entries are never removed, so lookups are lock free: a key is published with a release store after
+   *          its handle and probing stops at the first empty slot. Inserts are serialized by a mutex.
+   *
+   *          Keys are trusted, two descriptions whose hashes collide share a pipeline.
+   *
+   *          This object cannot be copied. This object cannot be moved.
+   */
+	class PipelineVariantCache {
+	public:
+		explicit PipelineVariantCache(PipelineCompiler &pipelineCompiler);
+		~PipelineVariantCache() = default;
+
+		PipelineVariantCache(const PipelineVariantCache &) = delete;
+		auto operator=(const PipelineVariantCache &) -> PipelineVariantCache & = delete;
+
+		PipelineVariantCache(const PipelineVariantCache &&) = delete;
+		auto operator=(const PipelineVariantCache &&) -> PipelineVariantCache & = delete;
+
+		// Any thread, never blocks. Returns an invalid handle when the variant was never requested.
+		[[nodiscard]] auto find(const uint64_t &key) const -> PipelineHandle;
+
+		// Any thread, lock free once the variant exists. 'key' must be hashPipelineDescription(description).
+		[[nodiscard]] auto getOrCreate(const uint64_t &key, const GraphicsPipelineDescription &description)
+			-> PipelineHandle;
+		[[nodiscard]] auto getOrCreate(const GraphicsPipelineDescription &description) -> PipelineHandle {
+			return getOrCreate(hashPipelineDescription(description), description);
+		}
+
+		[[nodiscard]] auto getVariantCount() const -> uint32_t { return m_variantCount.load(std::memory_order_relaxed); }
+
+	private:
+		// at most half full, so probes stay short.
+		static constexpr uint32_t TABLE_CAPACITY = MAX_COMPILED_PIPELINES * 2;
+		static_assert((TABLE_CAPACITY & (TABLE_CAPACITY - 1)) == 0, "the table is indexed with a mask.");
+		static constexpr uint64_t EMPTY_KEY = 0;
+
+		struct Entry {
+			std::atomic<uint64_t> key = EMPTY_KEY;
+			std::atomic<uint32_t> handleIndex = UINT32_MAX;
+		};
+
+		PipelineCompiler &m_pipelineCompiler;
+		std::array<Entry, TABLE_CAPACITY> m_entries;
+		std::mutex m_insertMutex;
+		std::atomic<uint32_t> m_variantCount = 0;
+
+		// zero marks an empty entry, the one key hashing to it is moved aside.
+		[[nodiscard]] static auto storedKey(const uint64_t &key) -> uint64_t { return key == EMPTY_KEY ? 1 : key; }
+	};
+
+}  // namespace venus
+
+#endif  // VENUS_PIPELINE_VARIANT_CACHE_HPP
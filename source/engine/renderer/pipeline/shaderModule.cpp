@@ -0,0 +1,129 @@
+#include "shaderModule.hpp"
+#include "VN_logger.hpp"
+#include "shaderRegistry.hpp"
+
+// STDLIB
+#include <format>
+#include <stdexcept>
+#include <system_error>
+
+#if defined(_WIN32)
+#include <fstream>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace venus {
+	namespace {  // ANONYMOUS NAMESPACE BEGIN
+		constexpr uint32_t SPIRV_MAGIC_NUMBER = 0x07230203;
+		constexpr size_t SPIRV_HEADER_WORD_COUNT = 5;
+
+		[[noreturn]] void throwLoadError(const std::filesystem::path &filePath, const char *reason) {
+			VN_LOG_CRITICAL(std::format("Failed to load shader '{}': {}", filePath.string(), reason));
+			throw std::runtime_error(std::format("Failed to load shader '{}': {}", filePath.string(), reason));
+		}
+
+		auto createModuleFromCode(VkDevice device, std::span<const uint32_t> code, std::string_view shaderName)
+			-> VkShaderModule {
+			const VkShaderModuleCreateInfo createInfo{.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO,
+																								.pNext = nullptr,
+																								.flags = 0,
+																								.codeSize = code.size_bytes(),
+																								.pCode = code.data()};
+
+			VkShaderModule shaderModule = VK_NULL_HANDLE;
+			if(vkCreateShaderModule(device, &createInfo, nullptr, &shaderModule) != VK_SUCCESS) {
+				VN_LOG_CRITICAL(std::format("Failed to create shader module for '{}'.", shaderName));
+				throw std::runtime_error("Failed to create shader module.");
+			}
+			return shaderModule;
+		}
+
+		// SPIR-V is stored in the byte order of the machine that wrote it, a swapped magic number is rejected as well.
+		auto isSpirv(std::span<const uint32_t> code) -> bool {
+			return code.size() >= SPIRV_HEADER_WORD_COUNT && code[0] == SPIRV_MAGIC_NUMBER;
+		}
+	}  // namespace
+	// ANONYMOUS NAMESPACE END
+
+	SpirvFile::SpirvFile(const std::filesystem::path &filePath) {
+		std::error_code error;
+		const uintmax_t fileSize = std::filesystem::file_size(filePath, error);
+		if(error) {
+			throwLoadError(filePath, "file could not be opened.");
+		}
+		if(fileSize % sizeof(uint32_t) != 0) {
+			throwLoadError(filePath, "size is not a multiple of the SPIR-V word size.");
+		}
+		if(fileSize < SPIRV_HEADER_WORD_COUNT * sizeof(uint32_t)) {
+			throwLoadError(filePath, "file is smaller than a SPIR-V header.");
+		}
+
+#if defined(_WIN32)
+		m_fallbackStorage.resize(fileSize / sizeof(uint32_t));
+		std::ifstream file(filePath, std::ios::binary);
+		if(!file.read(reinterpret_cast<char *>(m_fallbackStorage.data()), static_cast<std::streamsize>(fileSize))) {
+			throwLoadError(filePath, "file could not be read.");
+		}
+		m_code = m_fallbackStorage;
+#else
+		const int fileDescriptor = ::open(filePath.c_str(), O_RDONLY | O_CLOEXEC);
+		if(fileDescriptor < 0) {
+			throwLoadError(filePath, "file could not be opened.");
+		}
+
+		void *mapping = ::mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+		// the mapping keeps its own reference to the file.
+		::close(fileDescriptor);
+		if(mapping == MAP_FAILED) {
+			throwLoadError(filePath, "file could not be mapped.");
+		}
+
+		m_mapping = mapping;
+		m_mappingSize = fileSize;
+		m_code = {static_cast<const uint32_t *>(mapping), fileSize / sizeof(uint32_t)};
+#endif
+
+		if(!isSpirv(m_code)) {
+			unmap();
+			throwLoadError(filePath, "file is not SPIR-V, or was written with the opposite byte order.");
+		}
+	}
+
+	SpirvFile::~SpirvFile() { unmap(); }
+
+	void SpirvFile::unmap() {
+#if !defined(_WIN32)
+		if(m_mapping != nullptr) {
+			::munmap(m_mapping, m_mappingSize);
+			m_mapping = nullptr;
+			m_code = {};
+		}
+#endif
+	}
+
+	auto createShaderModule(VkDevice device, std::string_view shaderName,
+													const std::optional<std::filesystem::path> &overrideDirectory) -> VkShaderModule {
+		if(overrideDirectory.has_value()) {
+			std::filesystem::path overridePath = overrideDirectory.value() / shaderName;
+			overridePath += ".spv";
+
+			std::error_code error;
+			if(std::filesystem::exists(overridePath, error)) {
+				const SpirvFile spirv(overridePath);
+				VN_LOG_INFO(std::format("Shader '{}' loaded from override '{}'.", shaderName, overridePath.string()));
+				return createModuleFromCode(device, spirv.getCode(), shaderName);
+			}
+		}
+
+		const std::span<const uint32_t> embeddedCode = findEmbeddedShader(shaderName);
+		if(embeddedCode.empty()) {
+			VN_LOG_CRITICAL(std::format("No shader named '{}' was embedded.", shaderName));
+			throw std::runtime_error("Requested shader was not embedded.");
+		}
+		return createModuleFromCode(device, embeddedCode, shaderName);
+	}
+
+}  // namespace venus
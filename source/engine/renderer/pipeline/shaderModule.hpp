@@ -0,0 +1,67 @@
+#ifndef VENUS_SHADER_MODULE_HPP
+#define VENUS_SHADER_MODULE_HPP
+
+// THIRD PARTY
+#include "volk.h"
+
+// STDLIB
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace venus {
+
+	/**
+   * @brief A read-only view of a SPIR-V binary on disk.
+   *
+   * @details The file is memory mapped and its words are handed to the driver in place, nothing is copied on our side.
+   *          A mapping is page aligned so the words are always suitably aligned for 'VkShaderModuleCreateInfo::pCode'.
+   *          On platforms without mmap the file is read with a single read into word aligned storage instead.
+   *
+   *          The constructor validates the SPIR-V magic number and that the size is a whole number of words holding at
+   *          least the five word header, anything else throws.
+   *
+   *          Nothing is shared between instances, files may be loaded on several threads at once.
+   *
+   *          This object cannot be copied. This object cannot be moved.
+   */
+	class SpirvFile {
+	public:
+		explicit SpirvFile(const std::filesystem::path &filePath);
+		~SpirvFile();
+
+		SpirvFile(const SpirvFile &) = delete;
+		auto operator=(const SpirvFile &) -> SpirvFile & = delete;
+
+		SpirvFile(const SpirvFile &&) = delete;
+		auto operator=(const SpirvFile &&) -> SpirvFile & = delete;
+
+		[[nodiscard]] auto getCode() const -> std::span<const uint32_t> { return m_code; }
+
+	private:
+		std::span<const uint32_t> m_code;
+		void *m_mapping = nullptr;
+		size_t m_mappingSize = 0;
+		std::vector<uint32_t> m_fallbackStorage;
+		void unmap();
+	};
+
+	/**
+   * @brief Creates a shader module for 'shaderName', the file name of a shader in source/shaders such as "mesh.vert".
+   *
+   * @details Shaders are compiled into the binary at build time, see shaderRegistry.hpp, so normally no file is read.
+   *          For development an override directory may be given, a '<shaderName>.spv' found there is mapped from disk
+   *          and used instead of the embedded copy. Throws if the shader is neither overridden nor embedded.
+   *
+   *          Thread safe, 'device' may be shared between threads creating modules concurrently.
+   */
+	[[nodiscard]] auto createShaderModule(VkDevice device, std::string_view shaderName,
+																				const std::optional<std::filesystem::path> &overrideDirectory) -> VkShaderModule;
+
+}  // namespace venus
+
+#endif  // VENUS_SHADER_MODULE_HPP
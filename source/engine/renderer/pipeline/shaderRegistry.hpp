@@ -0,0 +1,25 @@
+#ifndef VENUS_SHADER_REGISTRY_HPP
+#define VENUS_SHADER_REGISTRY_HPP
+
+// STDLIB
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+namespace venus {
+
+	// SPIR-V compiled from source/shaders at build time, 'name' is the shader's file name such as "mesh.vert".
+	struct EmbeddedShader {
+		std::string_view name;
+		std::span<const uint32_t> code;
+	};
+
+	// Implemented by the registry cmake generates from source/shaders, see cmake/embedShaders.cmake.
+	[[nodiscard]] auto embeddedShaders() -> std::span<const EmbeddedShader>;
+
+	// Returns an empty span when no shader of that name was embedded.
+	[[nodiscard]] auto findEmbeddedShader(std::string_view shaderName) -> std::span<const uint32_t>;
+
+}  // namespace venus
+
+#endif  // VENUS_SHADER_REGISTRY_HPP
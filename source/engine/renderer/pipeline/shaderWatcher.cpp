@@ -0,0 +1,195 @@
+#include "shaderWatcher.hpp"
+#include "VN_logger.hpp"
+
+// STDLIB
+#include <array>
+#include <cerrno>
+#include <chrono>
+#include <format>
+#include <set>
+#include <stdexcept>
+#include <string_view>
+#include <system_error>
+
+#if defined(__linux__)
+#include <poll.h>
+#include <spawn.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+extern char **environ;
+#endif
+
+#ifndef VENUS_GLSLC_EXECUTABLE
+#define VENUS_GLSLC_EXECUTABLE "glslc"
+#endif
+
+namespace venus {
+	namespace {  // ANONYMOUS NAMESPACE BEGIN
+		// editors tend to save through several writes and renames, events arriving this close together are one save.
+		constexpr int SAVE_SETTLE_MILLISECONDS = 50;
+
+		auto isShaderStage(std::string_view fileName) -> bool {
+			return fileName.ends_with(".vert") || fileName.ends_with(".frag") || fileName.ends_with(".comp");
+		}
+	}  // namespace
+	// ANONYMOUS NAMESPACE END
+
+	ShaderWatcher::ShaderWatcher(const std::filesystem::path &sourceDirectory,
+															 const std::filesystem::path &outputDirectory):
+		m_sourceDirectory(sourceDirectory), m_outputDirectory(outputDirectory) {
+#if defined(__linux__)
+		std::error_code error;
+		std::filesystem::create_directories(m_outputDirectory, error);
+
+		m_inotifyDescriptor = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+		m_stopDescriptor = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+		// editors that save by renaming a temporary file over the original produce IN_MOVED_TO instead of a write.
+		if(m_inotifyDescriptor < 0 || m_stopDescriptor < 0 ||
+			 inotify_add_watch(m_inotifyDescriptor, m_sourceDirectory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) < 0) {
+			if(m_inotifyDescriptor >= 0) {
+				::close(m_inotifyDescriptor);
+			}
+			if(m_stopDescriptor >= 0) {
+				::close(m_stopDescriptor);
+			}
+			VN_LOG_CRITICAL(std::format("Failed to watch shader directory '{}'.", m_sourceDirectory.string()));
+			throw std::runtime_error("Failed to watch shader directory.");
+		}
+
+		m_thread = std::jthread([this]() { watchLoop(); });
+		VN_LOG_INFO(std::format("Watching '{}' for shader changes, recompiling into '{}'.", m_sourceDirectory.string(),
+														m_outputDirectory.string()));
+#else
+		VN_LOG_WARN("Shader hot reload needs inotify and is not available on this platform.");
+#endif
+	}
+
+	ShaderWatcher::~ShaderWatcher() {
+#if defined(__linux__)
+		if(m_thread.joinable()) {
+			const uint64_t stop = 1;
+			[[maybe_unused]] const ssize_t written = ::write(m_stopDescriptor, &stop, sizeof(stop));
+			m_thread.join();
+		}
+		::close(m_inotifyDescriptor);
+		::close(m_stopDescriptor);
+#endif
+		VN_LOG_INFO("Shader watcher has been destroyed.");
+	}
+
+	void ShaderWatcher::takeRecompiled(std::vector<std::string> &shaderNames) {
+		if(!m_hasRecompiled.load(std::memory_order_acquire)) {
+			return;
+		}
+
+		const std::scoped_lock lock(m_recompiledMutex);
+		shaderNames.insert(shaderNames.end(), m_recompiled.begin(), m_recompiled.end());
+		m_recompiled.clear();
+		m_hasRecompiled.store(false, std::memory_order_release);
+	}
+
+	void ShaderWatcher::watchLoop() {
+#if defined(__linux__)
+		// inotify events are variable length, the buffer must be aligned for the event struct and fit at least one.
+		alignas(inotify_event) std::array<char, 4096> eventBuffer{};
+		std::array<pollfd, 2> descriptors{{{.fd = m_inotifyDescriptor, .events = POLLIN, .revents = 0},
+																			 {.fd = m_stopDescriptor, .events = POLLIN, .revents = 0}}};
+		std::set<std::string> changedShaders;
+
+		while(true) {
+			// block until something changes, then keep collecting until the directory has been quiet for a moment.
+			const int timeout = changedShaders.empty() ? -1 : SAVE_SETTLE_MILLISECONDS;
+			const int ready = ::poll(descriptors.data(), descriptors.size(), timeout);
+			if(ready < 0) {
+				if(errno == EINTR) {
+					continue;
+				}
+				// anything else fails again right away, retrying would only spin.
+				const std::error_code error(errno, std::generic_category());
+				VN_LOG_ERROR(std::format("Failed to wait for shader changes, hot reload stops: {}", error.message()));
+				return;
+			}
+			if((descriptors[1].revents & POLLIN) != 0) {
+				return;
+			}
+
+			if(ready == 0) {
+				bool anyRecompiled = false;
+				for(const std::string &shaderName : changedShaders) {
+					if(recompile(shaderName)) {
+						const std::scoped_lock lock(m_recompiledMutex);
+						m_recompiled.push_back(shaderName);
+						anyRecompiled = true;
+					}
+				}
+				changedShaders.clear();
+				if(anyRecompiled) {
+					m_hasRecompiled.store(true, std::memory_order_release);
+				}
+				continue;
+			}
+
+			ssize_t length = 0;
+			while((length = ::read(m_inotifyDescriptor, eventBuffer.data(), eventBuffer.size())) > 0) {
+				for(ssize_t offset = 0; offset < length;) {
+					const auto *event = reinterpret_cast<const inotify_event *>(eventBuffer.data() + offset);
+					if(event->len > 0 && isShaderStage(event->name)) {
+						changedShaders.emplace(event->name);
+					}
+					offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+				}
+			}
+		}
+#endif
+	}
+
+	auto ShaderWatcher::recompile(const std::string &shaderName) const -> bool {
+#if defined(__linux__)
+		const std::string sourcePath = (m_sourceDirectory / shaderName).string();
+		const std::string outputPath = (m_outputDirectory / (shaderName + ".spv")).string();
+		const std::string temporaryPath = outputPath + ".tmp";
+
+		// same compiler and target environment the build embeds shaders with, see cmake/embedShaders.cmake.
+		std::string compiler = VENUS_GLSLC_EXECUTABLE;
+		std::string targetEnvironment = "--target-env=vulkan1.3";
+		std::string outputFlag = "-o";
+		std::array<char *, 6> arguments{compiler.data(), targetEnvironment.data(), const_cast<char *>(sourcePath.c_str()),
+																		outputFlag.data(), const_cast<char *>(temporaryPath.c_str()), nullptr};
+
+		const auto COMPILE_START = std::chrono::steady_clock::now();
+		pid_t compilerProcess = 0;
+		if(posix_spawnp(&compilerProcess, compiler.c_str(), nullptr, nullptr, arguments.data(), environ) != 0) {
+			VN_LOG_ERROR(std::format("Failed to start '{}' to recompile '{}'.", compiler, shaderName));
+			return false;
+		}
+
+		int status = 0;
+		while(::waitpid(compilerProcess, &status, 0) < 0 && errno == EINTR) {
+		}
+		std::error_code error;
+		if(!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+			VN_LOG_ERROR(std::format("Shader '{}' failed to compile, keeping the previous version.", shaderName));
+			std::filesystem::remove(temporaryPath, error);
+			return false;
+		}
+
+		std::filesystem::rename(temporaryPath, outputPath, error);
+		if(error) {
+			VN_LOG_ERROR(std::format("Failed to replace '{}': {}", outputPath, error.message()));
+			std::filesystem::remove(temporaryPath, error);
+			return false;
+		}
+
+		const std::chrono::duration<double, std::milli> COMPILE_TIME = std::chrono::steady_clock::now() - COMPILE_START;
+		VN_LOG_INFO(std::format("Recompiled shader '{}' in {:.1f} ms.", shaderName, COMPILE_TIME.count()));
+		return true;
+#else
+		static_cast<void>(shaderName);
+		return false;
+#endif
+	}
+
+}  // namespace venus
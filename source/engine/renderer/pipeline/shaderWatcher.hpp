@@ -0,0 +1,67 @@
+#ifndef VENUS_SHADER_WATCHER_HPP
+#define VENUS_SHADER_WATCHER_HPP
+
+// STDLIB
+#include <atomic>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace venus {
+
+	/**
+   * @brief Recompiles shader sources as they are saved, for development.
+   *
+   * @details A background thread watches 'sourceDirectory' with inotify. When a .vert, .frag or .comp file in it is
+   *          written, it runs glslc on that one file and writes '<shader file name>.spv' into 'outputDirectory'. That
+   *          directory is meant to be the shader override directory, so the next module created for the shader uses it.
+   *          A burst of saves is collected for a moment first so an editor writing several files compiles each once.
+   *
+   *          The .spv is written next to its destination and renamed over it, a module never maps a half written file.
+   *          A shader that fails to compile is logged as an error and not reported, glslc prints its diagnostics and
+   *          the old binary stays.
+   *          Only stage files are watched, editing a file they #include does not trigger a recompile.
+   *
+   *          Watching needs inotify, on other platforms the watcher logs a warning and never reports anything. Should
+   *          waiting for changes fail, the error is logged and the watcher stops reporting.
+   *
+   *          This object cannot be copied. This object cannot be moved.
+   */
+	class ShaderWatcher {
+	public:
+		explicit ShaderWatcher(const std::filesystem::path &sourceDirectory, const std::filesystem::path &outputDirectory);
+		~ShaderWatcher();
+
+		ShaderWatcher(const ShaderWatcher &) = delete;
+		auto operator=(const ShaderWatcher &) -> ShaderWatcher & = delete;
+
+		ShaderWatcher(const ShaderWatcher &&) = delete;
+		auto operator=(const ShaderWatcher &&) -> ShaderWatcher & = delete;
+
+		// Appends the file names of shaders recompiled since the last call, such as "mesh.frag". Never blocks, and
+		// costs a single atomic load while nothing was recompiled so it may be polled every frame.
+		void takeRecompiled(std::vector<std::string> &shaderNames);
+
+	private:
+		std::filesystem::path m_sourceDirectory;
+		std::filesystem::path m_outputDirectory;
+
+		int m_inotifyDescriptor = -1;
+		int m_stopDescriptor = -1;
+
+		std::mutex m_recompiledMutex;
+		std::vector<std::string> m_recompiled;
+		std::atomic<bool> m_hasRecompiled = false;
+
+		void watchLoop();
+		[[nodiscard]] auto recompile(const std::string &shaderName) const -> bool;
+
+		// declared last so every member above is constructed before the thread starts and outlives its join.
+		std::jthread m_thread;
+	};
+
+}  // namespace venus
+
+#endif  // VENUS_SHADER_WATCHER_HPP
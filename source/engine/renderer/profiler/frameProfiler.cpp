@@ -0,0 +1,318 @@
+#include "frameProfiler.hpp"
+#include "VN_logger.hpp"
+#include "logicalDevice.hpp"
+
+// STDLIB
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <format>
+#include <iterator>
+#include <span>
+#include <stdexcept>
+#include <string>
+
+namespace venus {
+	namespace {  // ANONYMOUS NAMESPACE BEGIN
+		// a frame spending at least this fraction of its cpu time in the fence wait is considered stalled on the gpu.
+		constexpr float FENCE_STALL_FRACTION = 0.5F;
+
+		constexpr std::array<const char *, FRAME_PHASE_COUNT> PHASE_NAMES = {
+			"present wait", "fence wait", "housekeeping", "acquire", "record", "submit", "present"};
+
+		auto toMilliseconds(std::chrono::steady_clock::duration duration) -> float {
+			return std::chrono::duration<float, std::milli>(duration).count();
+		}
+
+		// sorts the given values in place, percentiles use the nearest-rank method.
+		auto computeStatistics(std::span<float> values) -> FrameTimingStatistics {
+			if(values.empty()) {
+				return {};
+			}
+
+			std::ranges::sort(values);
+
+			double total = 0.0;
+			for(const float &value : values) {
+				total += value;
+			}
+
+			auto percentile = [&values](const double &fraction) -> double {
+				const auto rank = static_cast<size_t>(std::ceil(fraction * static_cast<double>(values.size())));
+				return values[std::clamp<size_t>(rank, 1, values.size()) - 1];
+			};
+
+			return {.minMilliseconds = values.front(),
+							.averageMilliseconds = total / static_cast<double>(values.size()),
+							.p95Milliseconds = percentile(0.95),
+							.p99Milliseconds = percentile(0.99),
+							.sampleCount = static_cast<uint32_t>(values.size())};
+		}
+
+		template<typename SampleT>
+		auto classifyFrame(const SampleT &sample, const uint32_t &gpuPassCount) -> FrameBottleneck {
+			const float fenceWait = sample.cpuPhaseMilliseconds[FRAME_PHASE_FENCE_WAIT];
+			if(fenceWait >= sample.cpuFrameMilliseconds * FENCE_STALL_FRACTION) {
+				return FRAME_BOTTLENECK_FENCE_STALL;
+			}
+
+			float gpuTotal = 0.0F;
+			for(uint32_t pass = 0; pass < gpuPassCount; ++pass) {
+				if((sample.gpuPassMask & (1U << pass)) != 0) {
+					gpuTotal += sample.gpuPassMilliseconds[pass];
+				}
+			}
+
+			const float cpuWork =
+				sample.cpuFrameMilliseconds - fenceWait - sample.cpuPhaseMilliseconds[FRAME_PHASE_PRESENT_WAIT];
+			if(sample.gpuPassMask != 0 && gpuTotal > cpuWork) {
+				return FRAME_BOTTLENECK_GPU;
+			}
+			return FRAME_BOTTLENECK_CPU;
+		}
+
+	}  // namespace
+	// ANONYMOUS NAMESPACE END
+
+	FrameProfiler::FrameProfiler(const std::shared_ptr<LogicalDevice> &logicalDevicePtr):
+		m_logicalDevice(logicalDevicePtr) {
+		const uint32_t graphicsFamily = m_logicalDevice->queueFamilyIndices().graphicsFamilyIndex.value();  // NOLINT
+		const uint32_t validBits = m_logicalDevice->queueFamilyProperties(graphicsFamily).timestampValidBits;
+		const float timestampPeriod = m_logicalDevice->physicalDeviceProperties().limits.timestampPeriod;
+
+		m_gpuTimingSupported = validBits > 0 && timestampPeriod > 0.0F;
+		if(m_gpuTimingSupported) {
+			static constexpr uint32_t ALL_BITS = 64;
+			m_timestampMask = validBits >= ALL_BITS ? ~uint64_t{0} : (uint64_t{1} << validBits) - 1;
+			m_timestampPeriodNanoseconds = static_cast<double>(timestampPeriod);
+			createTimestampPool();
+		} else {
+			VN_LOG_WARN("Graphics queue does not support timestamps, gpu pass timings are disabled.");
+		}
+
+		m_frameStart = std::chrono::steady_clock::now();
+		m_lapStart = m_frameStart;
+		VN_LOG_INFO("Frame profiler has been created.");
+	}
+
+	FrameProfiler::~FrameProfiler() {
+		if(m_timestampPool != VK_NULL_HANDLE) {
+			vkDestroyQueryPool(m_logicalDevice->getHandle(), m_timestampPool, nullptr);
+		}
+		VN_LOG_INFO("Frame profiler has been destroyed.");
+	}
+
+	void FrameProfiler::createTimestampPool() {
+		const VkQueryPoolCreateInfo createInfo{.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO,
+																					 .pNext = nullptr,
+																					 .flags = 0,
+																					 .queryType = VK_QUERY_TYPE_TIMESTAMP,
+																					 .queryCount = QUERIES_PER_FRAME * MAX_FRAMES_IN_FLIGHT,
+																					 .pipelineStatistics = 0};
+
+		if(vkCreateQueryPool(m_logicalDevice->getHandle(), &createInfo, nullptr, &m_timestampPool) != VK_SUCCESS) {
+			VN_LOG_CRITICAL("Failed to create timestamp query pool.");
+			throw std::runtime_error("Failed to create timestamp query pool.");
+		}
+	}
+
+	auto FrameProfiler::registerGpuPass(const char *passName) -> uint32_t {
+		if(m_gpuPassCount >= MAX_PROFILED_GPU_PASSES) {
+			VN_LOG_CRITICAL("Exceeded the maximum number of profiled gpu passes.");
+			throw std::runtime_error("Exceeded the maximum number of profiled gpu passes.");
+		}
+
+		m_gpuPassNames[m_gpuPassCount] = passName;
+		return m_gpuPassCount++;
+	}
+
+	auto FrameProfiler::currentSample() -> FrameSample & { return m_samples[m_frameNumber % FRAME_PROFILER_HISTORY]; }
+
+	auto FrameProfiler::sampleCount() const -> uint32_t {
+		return static_cast<uint32_t>(std::min<uint64_t>(m_frameNumber, FRAME_PROFILER_HISTORY));
+	}
+
+	void FrameProfiler::publishSample(const uint64_t &frameNumber) {
+		const size_t slot = frameNumber % FRAME_PROFILER_HISTORY;
+		const std::scoped_lock lock(m_publishedMutex);
+		m_publishedSamples[slot] = m_samples[slot];
+		m_publishedSampleCount = sampleCount();
+	}
+
+	void FrameProfiler::beginFrame(const uint32_t &frameIndex) {
+		assert(frameIndex < MAX_FRAMES_IN_FLIGHT);
+		(void) frameIndex;
+
+		currentSample() = {};
+		m_frameStart = std::chrono::steady_clock::now();
+		m_lapStart = m_frameStart;
+	}
+
+	void FrameProfiler::endPhase(const FrameCpuPhase &phase) {
+		const auto NOW = std::chrono::steady_clock::now();
+		currentSample().cpuPhaseMilliseconds[phase] += toMilliseconds(NOW - m_lapStart);
+		m_lapStart = NOW;
+	}
+
+	void FrameProfiler::endFrame() {
+		currentSample().cpuFrameMilliseconds = toMilliseconds(std::chrono::steady_clock::now() - m_frameStart);
+		++m_frameNumber;
+		publishSample(m_frameNumber - 1);
+	}
+
+	void FrameProfiler::recordPresentTime(const std::chrono::steady_clock::time_point &presentTime) {
+		if(m_lastPresentTime.time_since_epoch().count() != 0) {
+			currentSample().presentIntervalMilliseconds = toMilliseconds(presentTime - m_lastPresentTime);
+		}
+		m_lastPresentTime = presentTime;
+	}
+
+	void FrameProfiler::resolveGpuTimings(const uint32_t &frameIndex) {
+		const uint32_t passMask = m_slotGpuPassMask[frameIndex];
+		if(!m_gpuTimingSupported || passMask == 0) {
+			return;
+		}
+		m_slotGpuPassMask[frameIndex] = 0;
+
+		// the sample has already been overwritten by newer frames.
+		const uint64_t slotFrameNumber = m_slotFrameNumber[frameIndex];
+		if(m_frameNumber - slotFrameNumber >= FRAME_PROFILER_HISTORY) {
+			return;
+		}
+
+		// each query yields its value followed by its availability.
+		std::array<uint64_t, static_cast<size_t>(QUERIES_PER_FRAME) * 2> results{};
+		const VkResult result = vkGetQueryPoolResults(
+			m_logicalDevice->getHandle(), m_timestampPool, frameIndex * QUERIES_PER_FRAME, QUERIES_PER_FRAME,
+			sizeof(results), results.data(), sizeof(uint64_t) * 2, VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT);
+		if(result != VK_SUCCESS && result != VK_NOT_READY) {
+			VN_LOG_ERROR("Failed to read gpu timestamp queries.");
+			return;
+		}
+
+		FrameSample &sample = m_samples[slotFrameNumber % FRAME_PROFILER_HISTORY];
+		for(uint32_t pass = 0; pass < m_gpuPassCount; ++pass) {
+			if((passMask & (1U << pass)) == 0) {
+				continue;
+			}
+
+			const size_t beginQuery = static_cast<size_t>(pass) * 2 * 2;
+			const size_t endQuery = beginQuery + 2;
+			if(results[beginQuery + 1] == 0 || results[endQuery + 1] == 0) {
+				continue;
+			}
+
+			const uint64_t ticks = (results[endQuery] - results[beginQuery]) & m_timestampMask;
+			static constexpr double NANOSECONDS_PER_MILLISECOND = 1000000.0;
+			sample.gpuPassMilliseconds[pass] =
+				static_cast<float>(static_cast<double>(ticks) * m_timestampPeriodNanoseconds / NANOSECONDS_PER_MILLISECOND);
+			sample.gpuPassMask |= (1U << pass);
+		}
+
+		// the sample was published without its gpu timings when its frame ended.
+		publishSample(slotFrameNumber);
+	}
+
+	void FrameProfiler::resetGpuQueries(VkCommandBuffer commandBuffer, const uint32_t &frameIndex) {
+		if(!m_gpuTimingSupported) {
+			return;
+		}
+
+		vkCmdResetQueryPool(commandBuffer, m_timestampPool, frameIndex * QUERIES_PER_FRAME, QUERIES_PER_FRAME);
+		m_slotFrameNumber[frameIndex] = m_frameNumber;
+		m_slotGpuPassMask[frameIndex] = 0;
+	}
+
+	void FrameProfiler::beginGpuPass(VkCommandBuffer commandBuffer, const uint32_t &frameIndex,
+																	 const uint32_t &passIndex) {
+		assert(passIndex < m_gpuPassCount);
+		if(!m_gpuTimingSupported) {
+			return;
+		}
+
+		vkCmdWriteTimestamp2(commandBuffer, VK_PIPELINE_STAGE_2_TOP_OF_PIPE_BIT, m_timestampPool,
+												 (frameIndex * QUERIES_PER_FRAME) + (passIndex * 2));
+	}
+
+	void FrameProfiler::endGpuPass(VkCommandBuffer commandBuffer, const uint32_t &frameIndex, const uint32_t &passIndex) {
+		assert(passIndex < m_gpuPassCount);
+		if(!m_gpuTimingSupported) {
+			return;
+		}
+
+		vkCmdWriteTimestamp2(commandBuffer, VK_PIPELINE_STAGE_2_BOTTOM_OF_PIPE_BIT, m_timestampPool,
+												 (frameIndex * QUERIES_PER_FRAME) + (passIndex * 2) + 1);
+		m_slotGpuPassMask[frameIndex] |= (1U << passIndex);
+	}
+
+	auto FrameProfiler::getReport() const -> FrameTimingReport {
+		FrameTimingReport report{};
+		report.gpuPassCount = m_gpuPassCount;
+
+		// statistics are computed outside the lock so the render thread is never held up by a report.
+		std::array<FrameSample, FRAME_PROFILER_HISTORY> published{};
+		uint32_t count = 0;
+		{
+			const std::scoped_lock lock(m_publishedMutex);
+			count = m_publishedSampleCount;
+			std::copy_n(m_publishedSamples.begin(), count, published.begin());
+		}
+
+		const std::span<const FrameSample> samples(published.data(), count);
+		std::array<float, FRAME_PROFILER_HISTORY> scratch{};
+
+		auto gather = [&](auto &&selectValue) -> std::span<float> {
+			size_t written = 0;
+			for(const FrameSample &sample : samples) {
+				if(const float *value = selectValue(sample); value != nullptr) {
+					scratch[written++] = *value;
+				}
+			}
+			return {scratch.data(), written};
+		};
+
+		report.cpuFrame = computeStatistics(gather([](const FrameSample &sample) { return &sample.cpuFrameMilliseconds; }));
+		report.presentInterval = computeStatistics(gather([](const FrameSample &sample) -> const float * {
+			return sample.presentIntervalMilliseconds > 0.0F ? &sample.presentIntervalMilliseconds : nullptr;
+		}));
+		for(size_t phase = 0; phase < FRAME_PHASE_COUNT; ++phase) {
+			report.cpuPhases[phase] = computeStatistics(
+				gather([phase](const FrameSample &sample) { return &sample.cpuPhaseMilliseconds[phase]; }));
+		}
+		for(uint32_t pass = 0; pass < m_gpuPassCount; ++pass) {
+			report.gpuPasses[pass] = computeStatistics(gather([pass](const FrameSample &sample) -> const float * {
+				return (sample.gpuPassMask & (1U << pass)) != 0 ? &sample.gpuPassMilliseconds[pass] : nullptr;
+			}));
+		}
+
+		for(const FrameSample &sample : samples) {
+			++report.bottleneckCounts[classifyFrame(sample, m_gpuPassCount)];
+		}
+
+		return report;
+	}
+
+	void FrameProfiler::logSummary() const {
+		const FrameTimingReport report = getReport();
+
+		std::string summary = std::format("[Frame Profiler] cpu frame avg {:.3f}ms p95 {:.3f}ms p99 {:.3f}ms",
+																			report.cpuFrame.averageMilliseconds, report.cpuFrame.p95Milliseconds,
+																			report.cpuFrame.p99Milliseconds);
+		std::format_to(std::back_inserter(summary), " | present interval avg {:.3f}ms p99 {:.3f}ms",
+									 report.presentInterval.averageMilliseconds, report.presentInterval.p99Milliseconds);
+		for(size_t phase = 0; phase < FRAME_PHASE_COUNT; ++phase) {
+			std::format_to(std::back_inserter(summary), " | {} avg {:.3f}ms p99 {:.3f}ms", PHASE_NAMES[phase],
+										 report.cpuPhases[phase].averageMilliseconds, report.cpuPhases[phase].p99Milliseconds);
+		}
+		for(uint32_t pass = 0; pass < report.gpuPassCount; ++pass) {
+			std::format_to(std::back_inserter(summary), " | gpu {} avg {:.3f}ms p99 {:.3f}ms", m_gpuPassNames[pass],
+										 report.gpuPasses[pass].averageMilliseconds, report.gpuPasses[pass].p99Milliseconds);
+		}
+		std::format_to(std::back_inserter(summary), " | bound cpu:{} gpu:{} fence-stall:{}",
+									 report.bottleneckCounts[FRAME_BOTTLENECK_CPU], report.bottleneckCounts[FRAME_BOTTLENECK_GPU],
+									 report.bottleneckCounts[FRAME_BOTTLENECK_FENCE_STALL]);
+
+		VN_LOG_TRACE(summary);
+	}
+
+}  // namespace venus
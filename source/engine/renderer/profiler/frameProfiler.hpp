@@ -0,0 +1,114 @@
+#ifndef VENUS_FRAME_PROFILER_HPP
+#define VENUS_FRAME_PROFILER_HPP
+
+// PROJECT
+#include "frameStatistics.hpp"
+#include "renderConfig.hpp"
+
+// THIRD PARTY
+#include "volk.h"
+
+// STDLIB
+#include <array>
+#include <chrono>
+#include <memory>
+#include <mutex>
+
+namespace venus {
+	class LogicalDevice;
+
+	/**
+   * @brief A cpu phase and gpu pass frame profiler.
+   *
+   * @details CPU phases are timed as laps, 'beginFrame()' starts the lap timer and every 'endPhase()' closes one phase.
+   *          GPU passes are timed with timestamp queries, each frame in flight owns its own range of the query pool
+   *          which is read back once that frame's timeline value has been waited on, so gpu timings land a few frames late.
+   *
+   *          Samples are kept in a fixed ring buffer of the last FRAME_PROFILER_HISTORY frames, nothing in the per-frame
+   *          path allocates. Statistics are computed on demand over the whole ring.
+   *
+   *          Every method except 'getReport()' must be called from the thread that draws. Finished samples are copied
+   *          into a second ring under a mutex, so 'getReport()' can be called from any thread while frames are drawn.
+   *
+   *          This object cannot be copied. This object cannot be moved.
+   */
+	class FrameProfiler {
+	public:
+		explicit FrameProfiler(const std::shared_ptr<LogicalDevice> &logicalDevicePtr);
+		~FrameProfiler();
+
+		FrameProfiler(const FrameProfiler &) = delete;
+		auto operator=(const FrameProfiler &) -> FrameProfiler & = delete;
+
+		FrameProfiler(const FrameProfiler &&) = delete;
+		auto operator=(const FrameProfiler &&) -> FrameProfiler & = delete;
+
+		// Registers a named gpu pass, the returned index is passed to 'beginGpuPass()'/'endGpuPass()'.
+		// The name must outlive the profiler, string literals are expected.
+		[[nodiscard]] auto registerGpuPass(const char *passName) -> uint32_t;
+
+		void beginFrame(const uint32_t &frameIndex);
+		void endPhase(const FrameCpuPhase &phase);
+		void endFrame();
+
+		// Records the time a frame was presented, the interval since the previous call is stored with the current frame.
+		void recordPresentTime(const std::chrono::steady_clock::time_point &presentTime);
+
+		// Must be called once the last submission from 'frameIndex' has completed.
+		void resolveGpuTimings(const uint32_t &frameIndex);
+
+		// Must be recorded before any gpu pass of the frame, outside of any rendering instance.
+		void resetGpuQueries(VkCommandBuffer commandBuffer, const uint32_t &frameIndex);
+		void beginGpuPass(VkCommandBuffer commandBuffer, const uint32_t &frameIndex, const uint32_t &passIndex);
+		void endGpuPass(VkCommandBuffer commandBuffer, const uint32_t &frameIndex, const uint32_t &passIndex);
+
+		[[nodiscard]] auto getReport() const -> FrameTimingReport;
+		[[nodiscard]] auto getFrameCount() const -> uint64_t { return m_frameNumber; }
+		void logSummary() const;
+
+	private:
+		struct FrameSample {
+			float cpuFrameMilliseconds;
+			float presentIntervalMilliseconds;
+			std::array<float, FRAME_PHASE_COUNT> cpuPhaseMilliseconds;
+			std::array<float, MAX_PROFILED_GPU_PASSES> gpuPassMilliseconds;
+			uint32_t gpuPassMask;
+		};
+
+		static constexpr uint32_t QUERIES_PER_FRAME = MAX_PROFILED_GPU_PASSES * 2;
+
+		std::shared_ptr<LogicalDevice> m_logicalDevice;
+
+		std::array<FrameSample, FRAME_PROFILER_HISTORY> m_samples{};
+		uint64_t m_frameNumber = 0;
+
+		// copies of finished samples, the only state 'getReport()' reads besides the gpu passes registered at setup.
+		mutable std::mutex m_publishedMutex;
+		std::array<FrameSample, FRAME_PROFILER_HISTORY> m_publishedSamples{};
+		uint32_t m_publishedSampleCount = 0;
+
+		std::chrono::steady_clock::time_point m_frameStart;
+		std::chrono::steady_clock::time_point m_lapStart;
+		std::chrono::steady_clock::time_point m_lastPresentTime;
+
+		std::array<const char *, MAX_PROFILED_GPU_PASSES> m_gpuPassNames{};
+		uint32_t m_gpuPassCount = 0;
+
+		VkQueryPool m_timestampPool = VK_NULL_HANDLE;
+		bool m_gpuTimingSupported = false;
+		double m_timestampPeriodNanoseconds = 0.0;
+		uint64_t m_timestampMask = 0;
+
+		// tracks which frame last used each frame in flight's query range, and which of its passes were written.
+		std::array<uint64_t, MAX_FRAMES_IN_FLIGHT> m_slotFrameNumber{};
+		std::array<uint32_t, MAX_FRAMES_IN_FLIGHT> m_slotGpuPassMask{};
+
+		void createTimestampPool();
+		[[nodiscard]] auto currentSample() -> FrameSample &;
+		[[nodiscard]] auto sampleCount() const -> uint32_t;
+		void publishSample(const uint64_t &frameNumber);
+	};
+
+}  // namespace venus
+
+#endif  // VENUS_FRAME_PROFILER_HPP
@@ -3,9 +3,56 @@
 
 namespace venus {
 
-	// Maximum number of in flight frames, used to control amount of command buffers, semaphores, fences, and swapchain image count.
+	// Maximum number of in flight frames, used to control amount of command buffers, semaphores, and swapchain image count.
 	static constexpr unsigned int MAX_FRAMES_IN_FLIGHT = 4;
 
+	// Number of frames kept in the frame profiler history, all timing statistics are computed over this window.
+	static constexpr unsigned int FRAME_PROFILER_HISTORY = 240;
+
+	// Upper bound on secondary command buffers a draw list is split into, each slice is recorded by its own job.
+	static constexpr unsigned int MAX_RECORD_SLICES = 8;
+
+	// The main pass is only split further when every slice keeps at least this many batches. A batch records a pipeline
+	// bind and one indirect draw however many instances it has, so at most MAX_MATERIALS batches still fill several
+	// slices, while a job and a secondary command buffer cost more than recording a handful of batches.
+	static constexpr unsigned int MIN_BATCHES_PER_RECORD_SLICE = 32;
+
+	// Capacity of the pipeline compiler, its slots are allocated up front so handles can be polled without locking.
+	static constexpr unsigned int MAX_COMPILED_PIPELINES = 256;
+
+	// Upper bound on background pipeline compiler threads, they share the cores with the job system.
+	static constexpr unsigned int MAX_PIPELINE_COMPILER_THREADS = 4;
+
+	// Size of the device memory blocks resources are sub-allocated from, heaps smaller than eight blocks use an eighth of
+	// the heap instead. Larger resources get dedicated allocations.
+	static constexpr unsigned long long DEVICE_MEMORY_BLOCK_SIZE = 64ULL * 1024 * 1024;
+
+	// Size of the persistently mapped staging ring uploads are copied through, a single upload must fit in it.
+	static constexpr unsigned long long STAGING_RING_SIZE = 32ULL * 1024 * 1024;
+
+	// Bytes of transient gpu data each frame in flight can allocate from the frame data ring.
+	static constexpr unsigned long long FRAME_DATA_RING_SIZE = 4ULL * 1024 * 1024;
+
+	// Sizes of the vertex and index buffers every mesh is packed into, and the number of meshes they can hold.
+	static constexpr unsigned long long MESH_VERTEX_BUFFER_SIZE = 64ULL * 1024 * 1024;
+	static constexpr unsigned long long MESH_INDEX_BUFFER_SIZE = 32ULL * 1024 * 1024;
+	static constexpr unsigned int MAX_MESHES = 4096;
+
+	// Upper bound on materials, the first is the built-in one.
+	static constexpr unsigned int MAX_MATERIALS = 256;
+
+	// Draw packets accepted per frame, further packets submitted in the same frame are dropped.
+	static constexpr unsigned int MAX_DRAW_PACKETS = 16384;
+
+	// Sizes of the arrays in the bindless descriptor set, devices whose update after bind limits are lower are not
+	// selected.
+	static constexpr unsigned int MAX_BINDLESS_SAMPLED_IMAGES = 16384;
+	static constexpr unsigned int MAX_BINDLESS_SAMPLERS = 64;
+	static constexpr unsigned int MAX_BINDLESS_STORAGE_BUFFERS = 16384;
+
+	// Textures the texture registry can hold, each takes one sampled image of the bindless set.
+	static constexpr unsigned int MAX_TEXTURES = 4096;
+
 }  // namespace venus
 
 #endif  // VENUS_RENDERER_CONFIG_HPP
\ No newline at end of file
@@ -1,118 +1,475 @@
 #include "renderer.hpp"
 #include "VN_logger.hpp"
-#include "graphicsPipeline.hpp"
+#include "allocationCounter.hpp"
+#include "bindlessDescriptors.hpp"
+#include "computeQueue.hpp"
+#include "drawCuller.hpp"
+#include "drawPacketQueue.hpp"
+#include "frameDataRing.hpp"
+#include "frameProfiler.hpp"
+#include "jobSystem.hpp"
 #include "logicalDevice.hpp"
+#include "meshRegistry.hpp"
+#include "parallelCommandRecorder.hpp"
+#include "pipelineCache.hpp"
+#include "pipelineCompiler.hpp"
+#include "pipelineVariantCache.hpp"
 #include "renderConfig.hpp"
+#include "shaderWatcher.hpp"
 #include "swapchain.hpp"
+#include "textureRegistry.hpp"
+#include "timelineSemaphore.hpp"
+#include "uploadQueue.hpp"
 #include "window.hpp"
 
 // STDLIB
+#include <algorithm>
 #include <chrono>
+#include <filesystem>
+#include <format>
+#include <optional>
+#include <stdexcept>
 
 namespace venus {
 	namespace {  // ANONYMOUS NAMESPACE BEGIN
-		void logLoopTime() {
-			static constexpr uint32_t TIME_LIMIT = 5;
-			static auto LAST_MESSAGE_TIME = std::chrono::steady_clock::now();
+		constexpr std::chrono::seconds FRAME_LOG_INTERVAL{5};
 
-			static uint32_t loopCount = 0;
-			++loopCount;
+		// materials without shaders of their own use these.
+		constexpr const char *DEFAULT_MESH_VERTEX_SHADER = "mesh.vert";
+		constexpr const char *DEFAULT_MESH_FRAGMENT_SHADER = "mesh.frag";
 
-			auto NOW = std::chrono::steady_clock::now();
-			auto ELAPSED = std::chrono::duration_cast<std::chrono::seconds>(NOW - LAST_MESSAGE_TIME);
+		// pushed once per command buffer, laid out as the push constant block of shaders/mesh.vert.
+		struct DrawConstants {
+			VkDeviceAddress instances;
+		};
+
+		// the instances are the frame's first allocation from the frame data ring, a full frame of them always fits.
+		static_assert(MAX_DRAW_PACKETS * sizeof(DrawInstance) <= FRAME_DATA_RING_SIZE,
+									"The frame data ring must hold MAX_DRAW_PACKETS draw instances.");
+
+		// D16 is the one depth format every device can render to, the others are preferred for their precision.
+		auto chooseDepthFormat(const LogicalDevice &logicalDevice) -> VkFormat {
+			constexpr std::array<VkFormat, 2> PREFERRED_FORMATS{VK_FORMAT_D32_SFLOAT, VK_FORMAT_X8_D24_UNORM_PACK32};
+			for(const VkFormat format : PREFERRED_FORMATS) {
+				if((logicalDevice.formatProperties(format).optimalTilingFeatures &
+						VK_FORMAT_FEATURE_DEPTH_STENCIL_ATTACHMENT_BIT) != 0) {
+					return format;
+				}
+			}
+			return VK_FORMAT_D16_UNORM;
+		}
+
+		// bounded so a hidden or occluded window, whose frames never reach the display, cannot stall the loop.
+		constexpr uint64_t PRESENT_WAIT_TIMEOUT_NS = 100000000;
+
+		// number of presented frames allowed to queue for the display before the cpu waits, zero disables pacing.
+		auto presentWaitDepth(const PresentPolicyFlags &presentPolicy) -> uint32_t {
+			if((presentPolicy & PRESENT_POLICY_MAX_THROUGHPUT_FLAG_BIT) != 0) {
+				return 0;
+			}
+			if((presentPolicy & PRESENT_POLICY_VSYNC_FLAG_BIT) != 0) {
+				return 2;
+			}
+			return 1;
+		}
 
-			if(ELAPSED.count() >= TIME_LIMIT) {
-				VN_LOG_TRACE(std::format("[Frame Count {}] Time Elapsed: {}", loopCount, ELAPSED.count()));
-				LAST_MESSAGE_TIME = NOW;
+		auto presentModeName(const VkPresentModeKHR &presentMode) -> const char * {
+			switch(presentMode) {
+				case VK_PRESENT_MODE_IMMEDIATE_KHR:
+					return "immediate";
+				case VK_PRESENT_MODE_MAILBOX_KHR:
+					return "mailbox";
+				case VK_PRESENT_MODE_FIFO_KHR:
+					return "fifo";
+				case VK_PRESENT_MODE_FIFO_RELAXED_KHR:
+					return "fifo-relaxed";
+				default:
+					return "unknown";
 			}
 		}
 	}  // namespace
 	// ANONYMOUS NAMEPSACE END
 
-	Renderer::Renderer(const std::shared_ptr<Window> &windowPtr): m_window(windowPtr) {
+	Renderer::Renderer(const std::shared_ptr<Window> &windowPtr, const std::shared_ptr<JobSystem> &jobSystemPtr,
+										 const ApplicationConfigDetails &configDetails):
+		m_window(windowPtr), m_jobSystem(jobSystemPtr) {
+		const PipelineCacheConfigDetails &pipelineCacheConfig = configDetails.pipelineCacheConfig;
+		std::optional<std::filesystem::path> shaderOverrideDirectory;
+		if(configDetails.shaderConfig.overrideDirectory != nullptr) {
+			shaderOverrideDirectory = configDetails.shaderConfig.overrideDirectory;
+			VN_LOG_INFO(std::format("Shaders found in '{}' override their embedded copies.",
+															configDetails.shaderConfig.overrideDirectory));
+		}
+
 		m_logicalDevice = std::make_shared<LogicalDevice>(m_window->getSurfaceHandle());
 		m_swapchain = std::make_shared<Swapchain>(m_window, m_logicalDevice);
-		m_graphicsPipeline = std::make_unique<GraphicsPipeline>(m_logicalDevice, m_swapchain);
+		m_depthFormat = chooseDepthFormat(*m_logicalDevice);
+		m_pipelineCache = std::make_unique<PipelineCache>(
+			m_logicalDevice, pipelineCacheConfig.filePath != nullptr ?
+												 std::optional<std::filesystem::path>(pipelineCacheConfig.filePath) :
+												 std::nullopt);
+		m_bindlessDescriptors = std::make_unique<BindlessDescriptors>(m_logicalDevice);
+		// half the cores are left to the job system, compiles only run while pipelines are being loaded.
+		m_pipelineCompiler = std::make_unique<PipelineCompiler>(m_logicalDevice, *m_pipelineCache,
+																														m_bindlessDescriptors->getPipelineLayout(),
+																														shaderOverrideDirectory, m_jobSystem->getThreadCount() / 2);
+		m_pipelineVariants = std::make_unique<PipelineVariantCache>(*m_pipelineCompiler);
+		// the built-in material, the default MaterialHandle.
+		static_cast<void>(createMaterial({.vertexShader = nullptr,
+																			.fragmentShader = nullptr,
+																			.baseColor = {1.0F, 1.0F, 1.0F, 1.0F},
+																			.baseColorTexture = {}}));
+
+		if(configDetails.shaderConfig.watchDirectory != nullptr) {
+			if(shaderOverrideDirectory.has_value()) {
+				m_shaderWatcher =
+					std::make_unique<ShaderWatcher>(configDetails.shaderConfig.watchDirectory, shaderOverrideDirectory.value());
+			} else {
+				VN_LOG_WARN("Shader hot reload needs a shader override directory to compile into, it stays disabled.");
+			}
+		}
+		m_uploadQueue = std::make_unique<UploadQueue>(m_logicalDevice);
+		m_meshRegistry = std::make_unique<MeshRegistry>(m_logicalDevice, *m_uploadQueue);
+		m_textureRegistry = std::make_unique<TextureRegistry>(m_logicalDevice, *m_uploadQueue, *m_bindlessDescriptors);
+		m_drawPackets = std::make_unique<DrawPacketQueue>();
+		m_computeQueue = std::make_unique<ComputeQueue>(m_logicalDevice);
+		m_frameData = std::make_unique<FrameDataRing>(m_logicalDevice, m_computeQueue->getSharingFamilies());
+		m_drawCuller = std::make_unique<DrawCuller>(m_logicalDevice, *m_pipelineCache,
+																								m_bindlessDescriptors->getPipelineLayout(), shaderOverrideDirectory,
+																								m_computeQueue->getSharingFamilies());
+		m_drawBatches.reserve(MAX_MATERIALS);
+		m_packetMeshes.resize(MAX_DRAW_PACKETS);
+		m_frameProfiler = std::make_unique<FrameProfiler>(m_logicalDevice);
+		m_cullPassProfileIndex = m_frameProfiler->registerGpuPass("cull");
+		m_mainPassProfileIndex = m_frameProfiler->registerGpuPass("main");
+		m_commandRecorder = std::make_unique<ParallelCommandRecorder>(m_logicalDevice, m_jobSystem);
+		buildRenderGraph();
 
 		createSyncObjects();
+
+		m_presentIdEnabled = m_logicalDevice->supportsPresentWait();
+		m_presentWaitDepth = m_presentIdEnabled ? presentWaitDepth(m_window->getPresentPolicy()) : 0;
+		VN_LOG_INFO(std::format("Presenting with {} mode, {}.", presentModeName(m_swapchain->getPresentMode()),
+														m_presentWaitDepth > 0 ? "paced by present-wait" : "without present pacing"));
+
+		m_lastFrameLogTime = std::chrono::steady_clock::now();
 		VN_LOG_INFO("Venus Renderer has been created.");
 	}
 
 	Renderer::~Renderer() {
+		// work that was never waited on may still reference retired resources.
+		TimelineSemaphore &timeline = m_logicalDevice->getGraphicsTimeline();
+		timeline.wait(timeline.lastSubmittedValue());
+		m_deletionQueue.flushAll();
 		destroySyncObjects();
-		m_graphicsPipeline.reset();
+		m_renderGraph.reset();
+		m_commandRecorder.reset();
+		m_frameProfiler.reset();
+		m_drawCuller.reset();
+		m_frameData.reset();
+		m_computeQueue.reset();
+		m_drawPackets.reset();
+		m_textureRegistry.reset();
+		m_meshRegistry.reset();
+		m_uploadQueue.reset();
+		m_shaderWatcher.reset();
+		m_pipelineVariants.reset();
+		m_pipelineCompiler.reset();
+		m_bindlessDescriptors.reset();
+		m_pipelineCache.reset();
 		m_swapchain.reset();
 		m_logicalDevice.reset();
 		VN_LOG_INFO("Venus Renderer has been destroyed.");
 	}
 
-	void Renderer::draw() {
-		vkWaitForFences(m_logicalDevice->getHandle(), 1, &inFlightFences[m_currentFrame], VK_TRUE, UINT64_MAX);
-		vkResetFences(m_logicalDevice->getHandle(), 1, &inFlightFences[m_currentFrame]);
+	void Renderer::draw(const FrameState &frameState) {
+		// acquired even when the frame is skipped, so packets still being written are finished before it is reused.
+		m_drawPacketList = m_drawPackets->acquire(frameState.drawList);
+		drawFrame(frameState);
+		m_drawPacketList = {};
+		m_drawPackets->release(frameState.drawList);
+	}
+
+	void Renderer::drawFrame(const FrameState &frameState) {
+		// everything from the timeline wait to presentation must remain free of heap allocations, when allocation
+		// tracking is enabled this is verified every frame. Recreating the swapchain happens before the wait and a shader
+		// hot reload is not counted, those two may allocate.
+		if(!prepareSwapchain()) {
+			return;
+		}
+		m_frameProfiler->beginFrame(m_currentFrame);
+		m_frameState = frameState;
+
+		waitForPresentPacing();
+		m_frameProfiler->endPhase(FRAME_PHASE_PRESENT_WAIT);
+
+		TimelineSemaphore &timeline = m_logicalDevice->getGraphicsTimeline();
+		timeline.wait(m_slotFrameValues[m_currentFrame]);
+		m_frameProfiler->endPhase(FRAME_PHASE_FENCE_WAIT);
+		uint64_t allocationsAtFrameStart = memory::threadAllocationCount();
+
+		m_deletionQueue.flush(timeline.completedValue());
+		m_frameData->beginFrame(m_currentFrame);
+		const uint64_t allocationsBeforeReload = memory::threadAllocationCount();
+		reloadShaders();
+		allocationsAtFrameStart += memory::threadAllocationCount() - allocationsBeforeReload;
+		m_meshRegistry->update(m_deletionQueue, timeline.lastSubmittedValue());
+		m_textureRegistry->update(m_deletionQueue, timeline.lastSubmittedValue());
+		m_frameProfiler->resolveGpuTimings(m_currentFrame);
+		m_frameProfiler->endPhase(FRAME_PHASE_HOUSEKEEPING);
 
 		uint32_t imageIndex = 0;
-		vkAcquireNextImageKHR(m_logicalDevice->getHandle(), m_swapchain->getHandle(), UINT64_MAX,
-													imageAvailableSemaphores[m_currentFrame], VK_NULL_HANDLE, &imageIndex);
+		const VkResult acquireResult =
+			vkAcquireNextImageKHR(m_logicalDevice->getHandle(), m_swapchain->getHandle(), UINT64_MAX,
+														imageAvailableSemaphores[m_currentFrame], VK_NULL_HANDLE, &imageIndex);
+		if(acquireResult == VK_ERROR_OUT_OF_DATE_KHR) {
+			// nothing was submitted for this slot so its timeline value stays reached, the swapchain is rebuilt next frame.
+			m_swapchainDirty = true;
+			return;
+		}
+		if(acquireResult == VK_SUBOPTIMAL_KHR) {
+			m_swapchainDirty = true;
+		} else if(acquireResult != VK_SUCCESS) {
+			VN_LOG_CRITICAL("Failed to acquire swapchain image.");
+			throw std::runtime_error("Failed to acquire swapchain image.");
+		}
+		m_frameProfiler->endPhase(FRAME_PHASE_ACQUIRE);
+
+		const VkCommandBuffer commandBuffer = m_logicalDevice->getCommandBuffer(m_currentFrame);
+		m_logicalDevice->resetCommandPool(m_currentFrame);
+		recordDrawCommandBuffer(commandBuffer, imageIndex);
+		m_frameProfiler->endPhase(FRAME_PHASE_RECORD);
+
+		// uploads queued up to now go out on the transfer queue, the frame waits on the gpu for them and not the cpu.
+		const std::optional<VkSemaphoreSubmitInfo> uploadWait = m_uploadQueue->submit();
+		// async compute work goes out ahead of the graphics work consuming it, after the uploads it may read.
+		const std::optional<VkSemaphoreSubmitInfo> computeWait = m_computeQueue->submit(m_currentFrame, uploadWait);
+
+		// acquire and present only accept binary semaphores, the timeline value alone tracks completion.
+		const VkSemaphore signalSemaphore = renderFinishedSemaphores[m_currentFrame];
+		const uint64_t frameValue = timeline.peekNextValue();
+
+		std::array<VkSemaphoreSubmitInfo, 3> waitInfos{{{.sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO,
+																										 .pNext = nullptr,
+																										 .semaphore = imageAvailableSemaphores[m_currentFrame],
+																										 .value = 0,
+																										 .stageMask = VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT,
+																										 .deviceIndex = 0}}};
+		uint32_t waitCount = 1;
+		if(uploadWait.has_value()) {
+			waitInfos[waitCount++] = uploadWait.value();
+		}
+		if(computeWait.has_value()) {
+			waitInfos[waitCount++] = computeWait.value();
+		}
+		const std::array<VkSemaphoreSubmitInfo, 2> signalInfos{
+			{{.sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO,
+				.pNext = nullptr,
+				.semaphore = signalSemaphore,
+				.value = 0,
+				.stageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT,
+				.deviceIndex = 0},
+			 {.sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO,
+				.pNext = nullptr,
+				.semaphore = timeline.getHandle(),
+				.value = frameValue,
+				.stageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT,
+				.deviceIndex = 0}}};
+		const VkCommandBufferSubmitInfo commandBufferInfo{.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO,
+																											.pNext = nullptr,
+																											.commandBuffer = commandBuffer,
+																											.deviceMask = 0};
+
+		const VkSubmitInfo2 submitInfo{.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO_2,
+																	 .pNext = nullptr,
+																	 .flags = 0,
+																	 .waitSemaphoreInfoCount = waitCount,
+																	 .pWaitSemaphoreInfos = waitInfos.data(),
+																	 .commandBufferInfoCount = 1,
+																	 .pCommandBufferInfos = &commandBufferInfo,
+																	 .signalSemaphoreInfoCount = static_cast<uint32_t>(signalInfos.size()),
+																	 .pSignalSemaphoreInfos = signalInfos.data()};
+
+		if(vkQueueSubmit2(m_logicalDevice->getGraphicsQueue(), 1, &submitInfo, VK_NULL_HANDLE) != VK_SUCCESS) {
+			VN_LOG_CRITICAL("Failed to submit graphics queue.");
+			throw std::runtime_error("Failed to submit graphics queue.");
+		}
+		timeline.commitSubmittedValue(frameValue);
+		m_slotFrameValues[m_currentFrame] = frameValue;
+		m_frameProfiler->endPhase(FRAME_PHASE_SUBMIT);
+
+		++m_presentId;
+		const VkPresentIdKHR presentIdInfo{
+			.sType = VK_STRUCTURE_TYPE_PRESENT_ID_KHR, .pNext = nullptr, .swapchainCount = 1, .pPresentIds = &m_presentId};
+
+		const VkSwapchainKHR swapchain = m_swapchain->getHandle();
+		const VkPresentInfoKHR presentInfo{.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR,
+																			 .pNext = m_presentIdEnabled ? &presentIdInfo : nullptr,
+																			 .waitSemaphoreCount = 1,
+																			 .pWaitSemaphores = &signalSemaphore,
+																			 .swapchainCount = 1,
+																			 .pSwapchains = &swapchain,
+																			 .pImageIndices = &imageIndex,
+																			 .pResults = nullptr};
+
+		const VkResult presentResult = vkQueuePresentKHR(m_logicalDevice->getPresentQueue(), &presentInfo);
+		if(presentResult == VK_ERROR_OUT_OF_DATE_KHR || presentResult == VK_SUBOPTIMAL_KHR) {
+			m_swapchainDirty = true;
+		} else if(presentResult != VK_SUCCESS) {
+			VN_LOG_CRITICAL("Failed to present swapchain image.");
+			throw std::runtime_error("Failed to present swapchain image.");
+		}
+		if(m_presentWaitDepth == 0) {
+			m_frameProfiler->recordPresentTime(std::chrono::steady_clock::now());
+		}
+		m_frameProfiler->endPhase(FRAME_PHASE_PRESENT);
+		m_frameProfiler->endFrame();
 
-		vkResetCommandBuffer(m_logicalDevice->getCommandBuffers()[m_currentFrame], 0);
-		recordDrawCommandBuffer(imageIndex);
+		m_currentFrame = (m_currentFrame + 1) % MAX_FRAMES_IN_FLIGHT;
 
-		std::vector<VkSemaphore> waitSemaphores = {imageAvailableSemaphores[m_currentFrame]};
-		std::vector<VkPipelineStageFlags> waitStages = {VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT};
+		m_frameAllocationCount += memory::threadAllocationCount() - allocationsAtFrameStart;
+		logFrameStatistics();
+	}
 
-		std::vector<VkCommandBuffer> commandBuffers = {m_logicalDevice->getCommandBuffers()[m_currentFrame]};
+	auto Renderer::prepareSwapchain() -> bool {
+		// consume the resize event even when the swapchain is already dirty so it is not handled twice.
+		if(m_window->consumeFramebufferResize()) {
+			m_swapchainDirty = true;
+		}
+		if(!m_swapchainDirty) {
+			return true;
+		}
 
-		std::vector<VkSemaphore> signalSemaphores = {renderFinishedSemaphores[m_currentFrame]};
+		// minimized, skip the frame and keep polling instead of blocking the loop until the window is restored.
+		if(!m_swapchain->isSurfaceDrawable()) {
+			return false;
+		}
 
-		VkSubmitInfo submitInfo{.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO,
-														.pNext = nullptr,
-														.waitSemaphoreCount = static_cast<uint32_t>(waitSemaphores.size()),
-														.pWaitSemaphores = waitSemaphores.data(),
-														.pWaitDstStageMask = waitStages.data(),
-														.commandBufferCount = static_cast<uint32_t>(commandBuffers.size()),
-														.pCommandBuffers = commandBuffers.data(),
-														.signalSemaphoreCount = static_cast<uint32_t>(signalSemaphores.size()),
-														.pSignalSemaphores = signalSemaphores.data()};
+		// frames still in flight may reference the old swapchain, its destruction waits until the most recent
+		// submission has completed rather than idling the whole device.
+		const uint64_t lastSubmittedValue = m_logicalDevice->getGraphicsTimeline().lastSubmittedValue();
+		m_deletionQueue.retire(lastSubmittedValue,
+													 [device = m_logicalDevice->getHandle(), retired = m_swapchain->recreate()]() {
+														 Swapchain::destroyRetired(device, retired);
+													 });
+		// the transient attachments follow the new extent, the old ones are retired along with the swapchain.
+		m_renderGraph->compile(m_swapchain->getImageExtent(), m_deletionQueue, lastSubmittedValue);
+
+		// present ids are counted per swapchain.
+		m_presentId = 0;
+		m_swapchainDirty = false;
+		return true;
+	}
 
-		if(vkQueueSubmit(m_logicalDevice->getGraphicsQueue(), 1, &submitInfo, inFlightFences[m_currentFrame]) !=
-			 VK_SUCCESS) {
-			VN_LOG_CRITICAL("Failed to submit graphics queue.");
-			throw std::runtime_error("Failed to submit graphics queue.");
+	void Renderer::reloadShaders() {
+		// frames in flight may still use a replaced pipeline, it is destroyed once the last of them has completed.
+		const uint64_t lastSubmittedValue = m_logicalDevice->getGraphicsTimeline().lastSubmittedValue();
+
+		if(m_shaderWatcher != nullptr) {
+			m_shaderWatcher->takeRecompiled(m_recompiledShaders);
+			for(const std::string &shaderName : m_recompiledShaders) {
+				uint32_t rebuildCount = m_pipelineCompiler->rebuildUsing(shaderName);
+				// graphics pipelines compile in the background, the only compute pipeline is rebuilt right here.
+				if(m_drawCuller->rebuildUsing(shaderName, m_deletionQueue, lastSubmittedValue)) {
+					++rebuildCount;
+				}
+				VN_LOG_INFO(std::format("Shader '{}' changed, rebuilding {} pipelines.", shaderName, rebuildCount));
+			}
+			m_recompiledShaders.clear();
 		}
 
-		std::vector<VkSwapchainKHR> swapchains = {m_swapchain->getHandle()};
-		VkPresentInfoKHR presentInfo{.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR,
-																 .pNext = nullptr,
-																 .waitSemaphoreCount = static_cast<uint32_t>(signalSemaphores.size()),
-																 .pWaitSemaphores = signalSemaphores.data(),
-																 .swapchainCount = static_cast<uint32_t>(swapchains.size()),
-																 .pSwapchains = swapchains.data(),
-																 .pImageIndices = &imageIndex,
-																 .pResults = nullptr};
+		m_pipelineCompiler->swapRebuilt(m_deletionQueue, lastSubmittedValue);
+	}
 
-		vkQueuePresentKHR(m_logicalDevice->getPresentQueue(), &presentInfo);
+	void Renderer::waitForPresentPacing() {
+		if(m_presentWaitDepth == 0 || m_presentId < m_presentWaitDepth) {
+			return;
+		}
 
-		m_currentFrame = (m_currentFrame + 1) % MAX_FRAMES_IN_FLIGHT;
+		// waiting on the frame presented 'depth - 1' frames ago keeps at most 'depth' frames queued for the display.
+		const uint64_t targetPresentId = m_presentId - (m_presentWaitDepth - 1);
+		if(vkWaitForPresentKHR(m_logicalDevice->getHandle(), m_swapchain->getHandle(), targetPresentId,
+													 PRESENT_WAIT_TIMEOUT_NS) == VK_SUCCESS) {
+			m_frameProfiler->recordPresentTime(std::chrono::steady_clock::now());
+		}
+	}
+
+	void Renderer::logFrameStatistics() {
+		const auto NOW = std::chrono::steady_clock::now();
+		const auto ELAPSED = std::chrono::duration_cast<std::chrono::seconds>(NOW - m_lastFrameLogTime);
+		if(ELAPSED < FRAME_LOG_INTERVAL) {
+			return;
+		}
+
+		VN_LOG_TRACE(
+			std::format("[Frame Count {}] Time Elapsed: {}", m_frameProfiler->getFrameCount(), ELAPSED.count()));
+		m_frameProfiler->logSummary();
+		if(memory::ALLOCATION_TRACKING_ENABLED && m_frameAllocationCount != 0) {
+			VN_LOG_WARN(std::format("Frame loop made {} heap allocations in the last {} seconds.", m_frameAllocationCount,
+															ELAPSED.count()));
+		}
+
+		m_frameAllocationCount = 0;
+		m_lastFrameLogTime = NOW;
+	}
+
+	auto Renderer::getFrameTimingReport() const -> FrameTimingReport { return m_frameProfiler->getReport(); }
 
-		logLoopTime();
+	auto Renderer::getPresentMode() const -> VkPresentModeKHR { return m_swapchain->getPresentMode(); }
+
+	auto Renderer::getPipelineCacheStatistics() const -> PipelineCacheStatistics {
+		return m_pipelineCache->getStatistics();
+	}
+
+	void Renderer::waitForPipelines() { m_pipelineCompiler->waitIdle(); }
+
+	auto Renderer::createMesh(const MeshData &meshData) -> MeshHandle { return m_meshRegistry->createMesh(meshData); }
+
+	void Renderer::destroyMesh(const MeshHandle &mesh) { m_meshRegistry->destroyMesh(mesh); }
+
+	auto Renderer::createTexture(const TextureData &textureData) -> TextureHandle {
+		return m_textureRegistry->createTexture(textureData);
 	}
 
+	void Renderer::destroyTexture(const TextureHandle &texture) { m_textureRegistry->destroyTexture(texture); }
+
+	auto Renderer::createMaterial(const MaterialDetails &details) -> MaterialHandle {
+		const std::scoped_lock lock(m_materialMutex);
+		const uint32_t materialIndex = m_materialCount.load(std::memory_order_relaxed);
+		if(materialIndex >= MAX_MATERIALS) {
+			VN_LOG_CRITICAL(std::format("Cannot create more than {} materials.", MAX_MATERIALS));
+			throw std::runtime_error("Cannot create more materials.");
+		}
+
+		// materials sharing shaders and opacity share one pipeline variant, they only differ in their instance data.
+		const PipelineHandle pipeline = m_pipelineVariants->getOrCreate(
+			{.vertexShader = details.vertexShader != nullptr ? details.vertexShader : DEFAULT_MESH_VERTEX_SHADER,
+			 .fragmentShader = details.fragmentShader != nullptr ? details.fragmentShader : DEFAULT_MESH_FRAGMENT_SHADER,
+			 .colorFormat = m_swapchain->getImageFormat(),
+			 .depthFormat = m_depthFormat,
+			 .vertexInput = VERTEX_INPUT_LAYOUT_MESH,
+			 .blendEnable = details.baseColor[3] < 1.0F});
+		m_materials[materialIndex] = {
+			.pipeline = pipeline, .baseColor = details.baseColor, .baseColorTexture = details.baseColorTexture};
+		m_materialCount.store(materialIndex + 1, std::memory_order_release);
+		return {.index = materialIndex};
+	}
+
+	auto Renderer::submitDraw(const DrawPacket &packet) -> bool { return m_drawPackets->submit(packet); }
+
+	auto Renderer::sealDrawList() -> uint32_t { return m_drawPackets->seal(); }
+
 	void Renderer::createSyncObjects() {
 		imageAvailableSemaphores.resize(MAX_FRAMES_IN_FLIGHT);
 		renderFinishedSemaphores.resize(MAX_FRAMES_IN_FLIGHT);
-		inFlightFences.resize(MAX_FRAMES_IN_FLIGHT);
 
 		VkSemaphoreCreateInfo semaphoreInfo{.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO, .pNext = nullptr, .flags = 0};
-		VkFenceCreateInfo fenceInfo{.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO,
-																.pNext = nullptr,
-																.flags = VK_FENCE_CREATE_SIGNALED_BIT};
 
 		for(size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; ++i) {
 			if(vkCreateSemaphore(m_logicalDevice->getHandle(), &semaphoreInfo, nullptr, &imageAvailableSemaphores[i]) !=
 					 VK_SUCCESS ||
 				 vkCreateSemaphore(m_logicalDevice->getHandle(), &semaphoreInfo, nullptr, &renderFinishedSemaphores[i]) !=
-					 VK_SUCCESS ||
-				 vkCreateFence(m_logicalDevice->getHandle(), &fenceInfo, nullptr, &inFlightFences[i]) != VK_SUCCESS) {
+					 VK_SUCCESS) {
 				VN_LOG_CRITICAL("Failed to create synchronization objects.");
 				throw std::runtime_error("Failed to create synchronization objects.");
 			}
@@ -128,47 +485,271 @@ namespace venus {
 			vkDestroySemaphore(m_logicalDevice->getHandle(), semaphore, nullptr);
 		}
 
-		for(auto &fence : inFlightFences) {
-			vkDestroyFence(m_logicalDevice->getHandle(), fence, nullptr);
-		}
-
 		VN_LOG_INFO("Destroyed synchronization objects.");
 	}
 
-	void Renderer::recordDrawCommandBuffer(const uint32_t &imageIndex) {
-		m_logicalDevice->start_RecordCommandBuffer(m_currentFrame);
-
-		VkClearValue clearColor = {{{0.0F, 0.0F, 0.0F, 1.0F}}};
-		VkRenderPassBeginInfo renderBeginInfo{.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO,
-																					.pNext = nullptr,
-																					.renderPass = m_swapchain->getRenderPass(),
-																					.framebuffer = m_swapchain->getFrameBuffers()[imageIndex],
-																					.renderArea = {{0, 0}, m_swapchain->getImageExtent()},
-																					.clearValueCount = 1,
-																					.pClearValues = &clearColor};
-		vkCmdBeginRenderPass(m_logicalDevice->getCommandBuffers()[m_currentFrame], &renderBeginInfo,
-												 VK_SUBPASS_CONTENTS_INLINE);
-		vkCmdBindPipeline(m_logicalDevice->getCommandBuffers()[m_currentFrame], VK_PIPELINE_BIND_POINT_GRAPHICS,
-											m_graphicsPipeline->getHandle());
+	void Renderer::recordMainPassSlice(VkCommandBuffer commandBuffer, const DrawSlice &slice, void *userData) {
+		const auto *renderer = static_cast<const Renderer *>(userData);
+		const VkExtent2D imageExtent = renderer->m_swapchain->getImageExtent();
 
 		VkViewport viewport{.x = 0.0F,
 												.y = 0.0F,
-												.width = static_cast<float>(m_swapchain->getImageExtent().width),
-												.height = static_cast<float>(m_swapchain->getImageExtent().height),
+												.width = static_cast<float>(imageExtent.width),
+												.height = static_cast<float>(imageExtent.height),
 												.minDepth = 0.0F,
 												.maxDepth = 1.0F};
 		VkRect2D scissor{
 			.offset = {0, 0},
-			.extent = m_swapchain->getImageExtent(),
+			.extent = imageExtent,
 		};
 
-		vkCmdSetViewport(m_logicalDevice->getCommandBuffers()[m_currentFrame], 0, 1, &viewport);
-		vkCmdSetScissor(m_logicalDevice->getCommandBuffers()[m_currentFrame], 0, 1, &scissor);
+		vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
+		vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
+
+		// every mesh lives in the same two buffers, they are bound once and draws only differ in their offsets.
+		const VkBuffer vertexBuffer = renderer->m_meshRegistry->getVertexBuffer();
+		const VkDeviceSize vertexBufferOffset = 0;
+		vkCmdBindVertexBuffers(commandBuffer, 0, 1, &vertexBuffer, &vertexBufferOffset);
+		vkCmdBindIndexBuffer(commandBuffer, renderer->m_meshRegistry->getIndexBuffer(), 0, VK_INDEX_TYPE_UINT32);
+
+		// every pipeline shares the bindless layout, so the set and the constants stay bound across pipeline switches.
+		// Per draw resources are indices in the draw's instance, nothing is bound per batch but the pipeline.
+		const BindlessDescriptors &bindless = *renderer->m_bindlessDescriptors;
+		bindless.bind(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS);
+		const DrawConstants constants{.instances = renderer->m_drawInstanceAddress};
+		vkCmdPushConstants(commandBuffer, bindless.getPipelineLayout(), BindlessDescriptors::PUSH_CONSTANT_STAGES, 0,
+											 sizeof(DrawConstants), &constants);
+
+		VkPipeline boundPipeline = VK_NULL_HANDLE;
+		for(uint32_t draw = slice.firstDraw; draw < slice.firstDraw + slice.drawCount; ++draw) {
+			const DrawBatch &batch = renderer->m_drawBatches[draw];
+			if(batch.pipeline != boundPipeline) {
+				vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, batch.pipeline);
+				boundPipeline = batch.pipeline;
+			}
+			renderer->m_drawCuller->recordDraw(commandBuffer, renderer->m_currentFrame, batch.firstInstance,
+																				 batch.instanceCount, batch.material);
+		}
+	}
+
+	void Renderer::buildDrawInstances() {
+		m_drawBatches.clear();
+		m_drawInstanceCount = 0;
+		m_drawInstanceAddress = 0;
+
+		// resolved once per frame, a material whose pipeline is still compiling or whose texture is still uploading
+		// resolves to a null pipeline and its draws wait.
+		const uint32_t materialCount = m_materialCount.load(std::memory_order_acquire);
+		for(uint32_t material = 0; material < materialCount; ++material) {
+			const Material &details = m_materials[material];
+			m_materialPipelines[material] = m_pipelineCompiler->getPipeline(details.pipeline);
+			m_materialTextures[material] = BindlessDescriptors::INVALID_INDEX;
+			m_materialDrawCounts[material] = 0;
+			if(details.baseColorTexture.isValid()) {
+				const std::optional<uint32_t> texture = m_textureRegistry->findTexture(details.baseColorTexture);
+				if(texture.has_value()) {
+					m_materialTextures[material] = texture.value();
+				} else {
+					m_materialPipelines[material] = nullptr;
+				}
+			}
+		}
+
+		// counting the drawable packets of every material first lets each instance be written straight into its batch.
+		const auto packetCount = static_cast<uint32_t>(m_drawPacketList.size());
+		for(uint32_t packetIndex = 0; packetIndex < packetCount; ++packetIndex) {
+			const DrawPacket &packet = m_drawPacketList[packetIndex];
+			const uint32_t material = packet.material.index;
+			const bool materialReady = material < materialCount && m_materialPipelines[material] != nullptr;
+			m_packetMeshes[packetIndex] = materialReady ? m_meshRegistry->findMesh(packet.mesh) : nullptr;
+			if(m_packetMeshes[packetIndex] != nullptr) {
+				++m_materialDrawCounts[material];
+			}
+		}
+
+		// a batch's instances and the indirect commands culled from them take the same range of their buffers.
+		for(uint32_t material = 0; material < materialCount; ++material) {
+			if(m_materialDrawCounts[material] == 0) {
+				continue;
+			}
+			const GraphicsPipeline *pipeline = m_materialPipelines[material];
+			m_drawBatches.push_back({.pipeline = pipeline->getHandle(),
+															 .firstInstance = m_drawInstanceCount,
+															 .instanceCount = m_materialDrawCounts[material],
+															 .material = material});
+			m_materialFirstInstances[material] = m_drawInstanceCount;
+			m_drawInstanceCount += m_materialDrawCounts[material];
+			m_materialDrawCounts[material] = 0;
+		}
+
+		// written straight into the mapped ring, the gpu reads them where the cpu left them.
+		const std::optional<FrameAllocation> instanceData =
+			m_frameData->allocate(m_drawInstanceCount * sizeof(DrawInstance), alignof(DrawInstance));
+		if(!instanceData.has_value()) {
+			// unreachable while the instances are allocated first, see the static_assert above.
+			m_drawBatches.clear();
+			m_drawInstanceCount = 0;
+			return;
+		}
+		m_drawInstanceAddress = instanceData->address;
+
+		// packets keep their submission order within a batch until culling compacts it.
+		const std::span<DrawInstance> instances(static_cast<DrawInstance *>(instanceData->mappedData),
+																						m_drawInstanceCount);
+		for(uint32_t packetIndex = 0; packetIndex < packetCount; ++packetIndex) {
+			const GpuMesh *mesh = m_packetMeshes[packetIndex];
+			if(mesh == nullptr) {
+				continue;
+			}
+			const DrawPacket &packet = m_drawPacketList[packetIndex];
+			const uint32_t material = packet.material.index;
+			const uint32_t firstInstance = m_materialFirstInstances[material];
+			const uint32_t instanceIndex = firstInstance + m_materialDrawCounts[material]++;
+			instances[instanceIndex] = {.transform = packet.transform,
+																	.baseColor = m_materials[material].baseColor,
+																	.boundsMin = mesh->boundsMin,
+																	.firstIndex = mesh->firstIndex,
+																	.boundsMax = mesh->boundsMax,
+																	.indexCount = mesh->indexCount,
+																	.vertexOffset = mesh->vertexOffset,
+																	.batch = material,
+																	.firstCommand = firstInstance,
+																	.baseColorTexture = m_materialTextures[material]};
+		}
+	}
+
+	void Renderer::recordComputeWork(VkCommandBuffer computeCommandBuffer) {
+		m_bindlessDescriptors->bind(computeCommandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE);
+		// the profiler's queries are reset and read on the graphics queue, async compute work goes unmeasured.
+		const bool profiled = !m_computeQueue->isAsync();
+		if(profiled) {
+			m_frameProfiler->beginGpuPass(computeCommandBuffer, m_currentFrame, m_cullPassProfileIndex);
+		}
+		m_drawCuller->recordCulling(computeCommandBuffer, m_currentFrame, m_drawInstanceAddress, m_drawInstanceCount);
+		if(profiled) {
+			m_frameProfiler->endGpuPass(computeCommandBuffer, m_currentFrame, m_cullPassProfileIndex);
+		}
+	}
+
+	void Renderer::recordDrawCommandBuffer(VkCommandBuffer commandBuffer, const uint32_t &imageIndex) {
+		m_logicalDevice->start_RecordCommandBuffer(m_currentFrame);
+		m_frameProfiler->resetGpuQueries(commandBuffer, m_currentFrame);
+
+		// with nothing drawable yet the culling dispatch is empty and the main pass only clears.
+		buildDrawInstances();
+		recordComputeWork(m_computeQueue->begin(m_currentFrame, commandBuffer));
 
-		vkCmdDraw(m_logicalDevice->getCommandBuffers()[m_currentFrame], 3, 1, 0, 0);
-		vkCmdEndRenderPass(m_logicalDevice->getCommandBuffers()[m_currentFrame]);
+		m_renderGraph->setImportedImage(m_swapchainTarget, m_swapchain->getImages()[imageIndex],
+																		m_swapchain->getImageViews()[imageIndex]);
+		m_renderGraph->execute(commandBuffer);
 
 		m_logicalDevice->stop_RecordCommandBuffer(m_currentFrame);
 	}
 
+	void Renderer::buildRenderGraph() {
+		m_renderGraph = std::make_unique<RenderGraph>(m_logicalDevice);
+
+		// the previous contents are cleared anyway, so the first barrier discards them. It waits on the same stage the
+		// acquire semaphore is waited on, which orders it after the presentation engine has released the image.
+		// Presentation waits on the render finished semaphore, which already makes the writes available to it.
+		m_swapchainTarget = m_renderGraph->importImage("swapchain", VK_IMAGE_ASPECT_COLOR_BIT,
+																									 {.stageMask = VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT,
+																										.accessMask = VK_ACCESS_2_NONE,
+																										.layout = VK_IMAGE_LAYOUT_UNDEFINED},
+																									 {.stageMask = VK_PIPELINE_STAGE_2_NONE,
+																										.accessMask = VK_ACCESS_2_NONE,
+																										.layout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR});
+		m_depthTarget =
+			m_renderGraph->createImage("depth", {.format = m_depthFormat,
+																					 .usage = VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT,
+																					 .aspectMask = VK_IMAGE_ASPECT_DEPTH_BIT});
+
+		const uint32_t mainPass = m_renderGraph->addPass("main", recordMainPass, this);
+		m_renderGraph->write(mainPass, m_swapchainTarget,
+												 {.stageMask = VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT,
+													.accessMask = VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT,
+													.layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL});
+		m_renderGraph->write(
+			mainPass, m_depthTarget,
+			{.stageMask = VK_PIPELINE_STAGE_2_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_2_LATE_FRAGMENT_TESTS_BIT,
+			 .accessMask = VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
+			 .layout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL});
+
+		m_renderGraph->compile(m_swapchain->getImageExtent(), m_deletionQueue,
+													 m_logicalDevice->getGraphicsTimeline().lastSubmittedValue());
+	}
+
+	void Renderer::recordMainPass(VkCommandBuffer commandBuffer, const RenderGraph &graph, void *userData) {
+		auto *renderer = static_cast<Renderer *>(userData);
+		const uint32_t frameIndex = renderer->m_currentFrame;
+
+		const VkRenderingAttachmentInfo colorAttachment{.sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO,
+																										.pNext = nullptr,
+																										.imageView = graph.getImageView(renderer->m_swapchainTarget),
+																										.imageLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+																										.resolveMode = VK_RESOLVE_MODE_NONE,
+																										.resolveImageView = VK_NULL_HANDLE,
+																										.resolveImageLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+																										.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR,
+																										.storeOp = VK_ATTACHMENT_STORE_OP_STORE,
+																										.clearValue = {{{0.0F, 0.0F, 0.0F, 1.0F}}}};
+
+		// depth only lives through the pass, its memory is shared with other transient attachments.
+		const VkRenderingAttachmentInfo depthAttachment{.sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO,
+																										.pNext = nullptr,
+																										.imageView = graph.getImageView(renderer->m_depthTarget),
+																										.imageLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL,
+																										.resolveMode = VK_RESOLVE_MODE_NONE,
+																										.resolveImageView = VK_NULL_HANDLE,
+																										.resolveImageLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+																										.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR,
+																										.storeOp = VK_ATTACHMENT_STORE_OP_DONT_CARE,
+																										.clearValue = {.depthStencil = {.depth = 1.0F, .stencil = 0}}};
+
+		const VkRenderingInfo renderingInfo{.sType = VK_STRUCTURE_TYPE_RENDERING_INFO,
+																				.pNext = nullptr,
+																				.flags = VK_RENDERING_CONTENTS_SECONDARY_COMMAND_BUFFERS_BIT,
+																				.renderArea = {{0, 0}, graph.getExtent()},
+																				.layerCount = 1,
+																				.viewMask = 0,
+																				.colorAttachmentCount = 1,
+																				.pColorAttachments = &colorAttachment,
+																				.pDepthAttachment = &depthAttachment,
+																				.pStencilAttachment = nullptr};
+		renderer->m_frameProfiler->beginGpuPass(commandBuffer, frameIndex, renderer->m_mainPassProfileIndex);
+		vkCmdBeginRendering(commandBuffer, &renderingInfo);
+
+		const VkFormat colorFormat = renderer->m_swapchain->getImageFormat();
+		const VkCommandBufferInheritanceRenderingInfo inheritanceRenderingInfo{
+			.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_RENDERING_INFO,
+			.pNext = nullptr,
+			.flags = 0,
+			.viewMask = 0,
+			.colorAttachmentCount = 1,
+			.pColorAttachmentFormats = &colorFormat,
+			.depthAttachmentFormat = renderer->m_depthFormat,
+			.stencilAttachmentFormat = VK_FORMAT_UNDEFINED,
+			.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT};
+
+		const VkCommandBufferInheritanceInfo inheritanceInfo{.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO,
+																												 .pNext = &inheritanceRenderingInfo,
+																												 .renderPass = VK_NULL_HANDLE,
+																												 .subpass = 0,
+																												 .framebuffer = VK_NULL_HANDLE,
+																												 .occlusionQueryEnable = VK_FALSE,
+																												 .queryFlags = 0,
+																												 .pipelineStatistics = 0};
+
+		// slices are cut between batches, the instances behind a batch cost the same single indirect draw to record.
+		const auto batchCount = static_cast<uint32_t>(renderer->m_drawBatches.size());
+		const auto secondaryBuffers = renderer->m_commandRecorder->record(
+			frameIndex, inheritanceInfo, batchCount, MIN_BATCHES_PER_RECORD_SLICE, recordMainPassSlice, renderer);
+		if(!secondaryBuffers.empty()) {
+			vkCmdExecuteCommands(commandBuffer, static_cast<uint32_t>(secondaryBuffers.size()), secondaryBuffers.data());
+		}
+
+		vkCmdEndRendering(commandBuffer);
+		renderer->m_frameProfiler->endGpuPass(commandBuffer, frameIndex, renderer->m_mainPassProfileIndex);
+	}
+
 }  // namespace venus
@@ -1,21 +1,53 @@
 #ifndef VENUS_RENDERER_HPP
 #define VENUS_RENDERER_HPP
 
+// PROJECT
+#include "deletionQueue.hpp"
+#include "drawPacket.hpp"
+#include "frameState.hpp"
+#include "frameStatistics.hpp"
+#include "meshRegistry.hpp"
+#include "pipelineCompiler.hpp"
+#include "renderConfig.hpp"
+#include "renderGraph.hpp"
+#include "venusConfigOptions.hpp"
+
 // THIRD PARTY
 #include "volk.h"
 
 // STDLIB
+#include <array>
+#include <atomic>
+#include <chrono>
 #include <memory>
+#include <mutex>
+#include <span>
+#include <string>
 #include <vector>
 
 namespace venus {
 	class Window;
 	class LogicalDevice;
 	class Swapchain;
-	class GraphicsPipeline;
+	class PipelineCache;
+	class PipelineVariantCache;
+	class ShaderWatcher;
+	class UploadQueue;
+	class DrawPacketQueue;
+	class DrawCuller;
+	class FrameDataRing;
+	class ComputeQueue;
+	class BindlessDescriptors;
+	class TextureRegistry;
+	struct PipelineCacheStatistics;
+	class FrameProfiler;
+	class ParallelCommandRecorder;
+	class JobSystem;
+	struct DrawSlice;
 	class Renderer {
 	public:
-		explicit Renderer(const std::shared_ptr<Window> &windowPtr);
+		explicit Renderer(const std::shared_ptr<Window> &windowPtr, const std::shared_ptr<JobSystem> &jobSystemPtr,
+											const ApplicationConfigDetails &configDetails);
 		~Renderer();
 
 		Renderer(const Renderer &) = delete;
@@ -24,22 +56,140 @@ namespace venus {
 		Renderer(const Renderer &&) = delete;
 		auto operator=(const Renderer &&) -> Renderer & = delete;
 
-		void draw();
+		// Safe to call from a thread other than the one that created the renderer, as long as only one thread draws.
+		// Every sealed draw list must be drawn exactly once, the list is released afterwards.
+		void draw(const FrameState &frameState);
+
+		// Safe to call from any thread, including while another thread draws.
+		[[nodiscard]] auto getFrameTimingReport() const -> FrameTimingReport;
+		[[nodiscard]] auto getPresentMode() const -> VkPresentModeKHR;
+		[[nodiscard]] auto getPipelineCacheStatistics() const -> PipelineCacheStatistics;
+
+		// Pipelines compile in the background and their draws are skipped until then, this blocks until all are built.
+		void waitForPipelines();
+
+		// Streams buffer and image data to the gpu from any thread, draws recorded after the upload's frame see it.
+		[[nodiscard]] auto getUploadQueue() const -> UploadQueue & { return *m_uploadQueue; }
+
+		// Any thread. A mesh is packed into the shared mesh buffers and drawn once its upload has been submitted.
+		[[nodiscard]] auto createMesh(const MeshData &meshData) -> MeshHandle;
+		void destroyMesh(const MeshHandle &mesh);
+
+		// Any thread. A texture is sampled through the bindless set once its upload has been submitted.
+		[[nodiscard]] auto createTexture(const TextureData &textureData) -> TextureHandle;
+		void destroyTexture(const TextureHandle &texture);
+
+		// Any thread. The material's pipeline compiles in the background, throws once MAX_MATERIALS exist.
+		[[nodiscard]] auto createMaterial(const MaterialDetails &details) -> MaterialHandle;
+
+		// Any thread, lock free. The packet is drawn with the frame whose draw list is sealed next, false when that
+		// list is full.
+		auto submitDraw(const DrawPacket &packet) -> bool;
+
+		// Frame producing thread only, closes the draw list for the frame state about to be handed to 'draw()'.
+		[[nodiscard]] auto sealDrawList() -> uint32_t;
 
 	private:
 		std::shared_ptr<Window> m_window;
+		std::shared_ptr<JobSystem> m_jobSystem;
 		std::shared_ptr<LogicalDevice> m_logicalDevice;
 		std::shared_ptr<Swapchain> m_swapchain;
-		std::unique_ptr<GraphicsPipeline> m_graphicsPipeline;
+		std::unique_ptr<PipelineCache> m_pipelineCache;
+		// every pipeline is built with its layout, it is bound once per command buffer and never per draw.
+		std::unique_ptr<BindlessDescriptors> m_bindlessDescriptors;
+		std::unique_ptr<PipelineCompiler> m_pipelineCompiler;
+		std::unique_ptr<PipelineVariantCache> m_pipelineVariants;
+
+		// only created for shader hot reload, recompiled shaders have their pipelines rebuilt and swapped between frames.
+		std::unique_ptr<ShaderWatcher> m_shaderWatcher;
+		std::vector<std::string> m_recompiledShaders;
+		void reloadShaders();
+
+		std::unique_ptr<UploadQueue> m_uploadQueue;
+		std::unique_ptr<MeshRegistry> m_meshRegistry;
+		std::unique_ptr<TextureRegistry> m_textureRegistry;
+		std::unique_ptr<DrawPacketQueue> m_drawPackets;
+
+		struct Material {
+			PipelineHandle pipeline;
+			std::array<float, 4> baseColor;
+			TextureHandle baseColorTexture;
+		};
+		// appended under the mutex and published by the count, the render thread reads them without locking.
+		std::array<Material, MAX_MATERIALS> m_materials{};
+		std::atomic<uint32_t> m_materialCount = 0;
+		std::mutex m_materialMutex;
+
+		std::unique_ptr<FrameProfiler> m_frameProfiler;
+		uint32_t m_mainPassProfileIndex = 0;
 
 		std::vector<VkSemaphore> imageAvailableSemaphores;
 		std::vector<VkSemaphore> renderFinishedSemaphores;
-		std::vector<VkFence> inFlightFences;
 		void createSyncObjects();
 		void destroySyncObjects();
 
-		void recordDrawCommandBuffer(const uint32_t &imageIndex);
+		// graphics timeline value signaled by the last submission from each slot, zero while a slot is unused.
+		std::array<uint64_t, MAX_FRAMES_IN_FLIGHT> m_slotFrameValues{};
+		DeletionQueue m_deletionQueue;
+
+		bool m_swapchainDirty = false;
+		[[nodiscard]] auto prepareSwapchain() -> bool;
+
+		uint64_t m_presentId = 0;
+		uint32_t m_presentWaitDepth = 0;
+		bool m_presentIdEnabled = false;
+		void waitForPresentPacing();
+
+		// snapshot the current frame is recorded from, recording jobs read it while 'draw()' waits for them.
+		FrameState m_frameState{};
+		std::span<const DrawPacket> m_drawPacketList;
+		std::unique_ptr<ParallelCommandRecorder> m_commandRecorder;
+		void drawFrame(const FrameState &frameState);
+		void recordDrawCommandBuffer(VkCommandBuffer commandBuffer, const uint32_t &imageIndex);
+
+		// the frame's packets are written as instances grouped into one batch per material, without sorting. The gpu
+		// culls them and each batch becomes a single indirect draw, so recording costs the same for any number of packets.
+		struct DrawBatch {
+			VkPipeline pipeline;
+			uint32_t firstInstance;
+			uint32_t instanceCount;
+			uint32_t material;
+		};
+		std::unique_ptr<DrawCuller> m_drawCuller;
+		uint32_t m_cullPassProfileIndex = 0;
+
+		// the frame's compute slot, every dispatch of the frame is recorded here before the main pass. It goes into the
+		// graphics command buffer, or into one submitted to the async compute queue ahead of the graphics work.
+		std::unique_ptr<ComputeQueue> m_computeQueue;
+		void recordComputeWork(VkCommandBuffer computeCommandBuffer);
+
+		// transient data the gpu reads during the frame, rewound once the frame slot's timeline value was reached.
+		std::unique_ptr<FrameDataRing> m_frameData;
+
+		std::vector<DrawBatch> m_drawBatches;
+		uint32_t m_drawInstanceCount = 0;
+		VkDeviceAddress m_drawInstanceAddress = 0;  // the frame's instances in the frame data ring.
+		std::vector<const GpuMesh *> m_packetMeshes;  // null for packets that cannot be drawn yet.
+		std::array<const GraphicsPipeline *, MAX_MATERIALS> m_materialPipelines{};
+		std::array<uint32_t, MAX_MATERIALS> m_materialTextures{};  // bindless index of each base color texture.
+		std::array<uint32_t, MAX_MATERIALS> m_materialDrawCounts{};
+		std::array<uint32_t, MAX_MATERIALS> m_materialFirstInstances{};
+		void buildDrawInstances();
+
+		// the frame's graphics passes and the attachments between them, the graph places every barrier. It is compiled
+		// again whenever the swapchain is recreated, which resizes its transient attachments.
+		std::unique_ptr<RenderGraph> m_renderGraph;
+		RenderResource m_swapchainTarget;
+		RenderResource m_depthTarget;
+		VkFormat m_depthFormat = VK_FORMAT_UNDEFINED;
+		void buildRenderGraph();
+		static void recordMainPass(VkCommandBuffer commandBuffer, const RenderGraph &graph, void *userData);
+		static void recordMainPassSlice(VkCommandBuffer commandBuffer, const DrawSlice &slice, void *userData);
 		uint32_t m_currentFrame = 0;
+
+		uint64_t m_frameAllocationCount = 0;
+		std::chrono::steady_clock::time_point m_lastFrameLogTime;
+		void logFrameStatistics();
 	};
 
 }  // namespace venus
@@ -6,8 +6,12 @@
 
 // STDLIB
 #include <algorithm>
+#include <array>
 #include <cassert>
+#include <format>
+#include <initializer_list>
 #include <limits>
+#include <utility>
 
 namespace venus {
 
@@ -27,29 +31,36 @@ namespace venus {
 			return supportedFormats[0];
 		}
 
-		auto choosePresentMode(const std::vector<VkPresentModeKHR> &supportedPresentModes) -> VkPresentModeKHR {
+		auto findPresentMode(const std::vector<VkPresentModeKHR> &supportedPresentModes,
+												 const std::initializer_list<VkPresentModeKHR> &preferredModes) -> VkPresentModeKHR {
+			for(const auto &preferredMode : preferredModes) {
+				if(std::ranges::find(supportedPresentModes, preferredMode) != supportedPresentModes.end()) {
+					return preferredMode;
+				}
+			}
+
+			// default to v-sync since its always supported as is required in the vulkan spec.
+			return VK_PRESENT_MODE_FIFO_KHR;
+		}
+
+		auto choosePresentMode(const std::vector<VkPresentModeKHR> &supportedPresentModes,
+													 const PresentPolicyFlags &presentPolicy) -> VkPresentModeKHR {
 			assert(supportedPresentModes.data() != nullptr);
+
 			// It should be noted that among linux users with nvidia graphics cards triple buffering may not work at all,
 			// unfortunately nvidia has poor support for linux users.
 			// It should work perfectly fine for amd graphics cards however.
-			for(const auto &presentMode : supportedPresentModes) {
-				if(presentMode == VK_PRESENT_MODE_MAILBOX_KHR) {
-					VN_LOG_INFO("Using triple-buffering presentation.");
-					return presentMode;
-				}
+			if((presentPolicy & PRESENT_POLICY_MAX_THROUGHPUT_FLAG_BIT) != 0) {
+				return findPresentMode(supportedPresentModes, {VK_PRESENT_MODE_IMMEDIATE_KHR, VK_PRESENT_MODE_MAILBOX_KHR,
+																											 VK_PRESENT_MODE_FIFO_RELAXED_KHR});
 			}
 
-			// This is querying for adaptive vsync specifically to limit our rendering at this time.
-			for(const auto &presentMode : supportedPresentModes) {
-				if(presentMode == VK_PRESENT_MODE_FIFO_RELAXED_KHR) {
-					VN_LOG_INFO("Using adaptive v-sync presentation.");
-					return presentMode;
-				}
+			if((presentPolicy & PRESENT_POLICY_VSYNC_FLAG_BIT) != 0) {
+				return VK_PRESENT_MODE_FIFO_KHR;
 			}
 
-			// default to v-sync since its always supported as is required in the vulkan spec.
-			VN_LOG_INFO("Using v-sync presentation.");
-			return VK_PRESENT_MODE_FIFO_KHR;
+			// low latency, adaptive v-sync is preferred over strict v-sync to avoid stutter when a frame misses a refresh.
+			return findPresentMode(supportedPresentModes, {VK_PRESENT_MODE_MAILBOX_KHR, VK_PRESENT_MODE_FIFO_RELAXED_KHR});
 		}
 
 		auto chooseSwapExtent(const VkSurfaceCapabilitiesKHR &surfaceCapabilities, const VkExtent2D &currentWindowExtent) {
@@ -72,24 +83,66 @@ namespace venus {
 	Swapchain::Swapchain(const std::shared_ptr<Window> &windowPtr,
 											 const std::shared_ptr<LogicalDevice> &logicalDevicePtr):
 		m_window(windowPtr), m_logicalDevice(logicalDevicePtr) {
+		createSwapchain(VK_NULL_HANDLE);
+		createImageViews();
+		VN_LOG_INFO("Swapchain construction was successful.");
+	}
+
+	Swapchain::~Swapchain() {
+		assert(m_swapchain != nullptr);
+		destroyRetired(m_logicalDevice->getHandle(),
+									 {.swapchain = m_swapchain, .imageViews = std::move(m_swapchainImageViews)});
+		VN_LOG_INFO("Swapchain destruction was successful.");
+	}
+
+	auto Swapchain::isSurfaceDrawable() const -> bool {
+		const VkExtent2D windowExtent = m_window->getCurrentSurfaceExtent();
+		return windowExtent.width != 0 && windowExtent.height != 0;
+	}
+
+	auto Swapchain::recreate() -> RetiredResources {
+		RetiredResources retired{.swapchain = m_swapchain, .imageViews = std::move(m_swapchainImageViews)};
+		m_swapchainImageViews.clear();
+
+		createSwapchain(retired.swapchain);
+		createImageViews();
+		VN_LOG_INFO(std::format("Swapchain recreated at {}x{}.", m_imageExtent.width, m_imageExtent.height));
+		return retired;
+	}
+
+	void Swapchain::destroyRetired(VkDevice device, const RetiredResources &retired) {
+		for(const auto &imageView : retired.imageViews) {
+			vkDestroyImageView(device, imageView, nullptr);
+		}
+
+		if(retired.swapchain != VK_NULL_HANDLE) {
+			vkDestroySwapchainKHR(device, retired.swapchain, nullptr);
+		}
+	}
+
+	void Swapchain::createSwapchain(VkSwapchainKHR oldSwapchain) {
 		auto swapchainSupport = m_logicalDevice->swapchainSupportDetails();
-		auto chosenPresentMode = choosePresentMode(swapchainSupport.supportedPresentModes);
+		// the capabilities stored at device selection describe the surface as it was then, extent and transform
+		// follow the window so they are queried fresh on every (re)creation.
+		const VkSurfaceCapabilitiesKHR surfaceCapabilities = m_logicalDevice->currentSurfaceCapabilities();
+		auto chosenPresentMode = choosePresentMode(swapchainSupport.supportedPresentModes, m_window->getPresentPolicy());
 		auto chosenFormat = chooseSurfaceFormat(swapchainSupport.supportedSurfaceFormats);
-		auto chosenExtent =
-			chooseSwapExtent(swapchainSupport.supportedSurfaceCapabilities, m_window->getCurrentSurfaceExtent());
+		auto chosenExtent = chooseSwapExtent(surfaceCapabilities, m_window->getCurrentSurfaceExtent());
 
-		uint32_t imageCount = swapchainSupport.supportedSurfaceCapabilities.minImageCount + 1;
-		if(swapchainSupport.supportedSurfaceCapabilities.maxImageCount > 0 &&
-			 imageCount > swapchainSupport.supportedSurfaceCapabilities.maxImageCount) {
-			imageCount = swapchainSupport.supportedSurfaceCapabilities.maxImageCount;
+		uint32_t imageCount = surfaceCapabilities.minImageCount + 1;
+		if(surfaceCapabilities.maxImageCount > 0 && imageCount > surfaceCapabilities.maxImageCount) {
+			imageCount = surfaceCapabilities.maxImageCount;
 		}
 		imageCount = std::min(imageCount, MAX_FRAMES_IN_FLIGHT);
 
 		static constexpr uint8_t IMAGE_LAYER_COUNT = 1;
 
-		auto indices = m_logicalDevice->queueFamilyIndices();
-		std::vector<uint32_t> queueindices = {indices.graphicsFamilyIndex.value(),  // NOLINT
-																					indices.presentFamilyIndex.value()};  // NOLINT
+		// exclusive images handed from the graphics to a separate present family would need an ownership release and
+		// acquire every frame, device selection prefers one family for both so this only applies when none exists.
+		const QueueFamilyIndices indices = m_logicalDevice->queueFamilyIndices();
+		const std::array<uint32_t, 2> sharingFamilies{indices.graphicsFamilyIndex.value(),  // NOLINT
+																									indices.presentFamilyIndex.value()};  // NOLINT
+		const bool sharedWithPresent = sharingFamilies[0] != sharingFamilies[1];
 
 		const VkSwapchainCreateInfoKHR createInfo = {
 			.sType = VK_STRUCTURE_TYPE_SWAPCHAIN_CREATE_INFO_KHR,
@@ -102,14 +155,14 @@ namespace venus {
 			.imageExtent = chosenExtent,
 			.imageArrayLayers = IMAGE_LAYER_COUNT,
 			.imageUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT,
-			.imageSharingMode = VK_SHARING_MODE_EXCLUSIVE,
-			.queueFamilyIndexCount = 0,
-			.pQueueFamilyIndices = nullptr,
-			.preTransform = swapchainSupport.supportedSurfaceCapabilities.currentTransform,
+			.imageSharingMode = sharedWithPresent ? VK_SHARING_MODE_CONCURRENT : VK_SHARING_MODE_EXCLUSIVE,
+			.queueFamilyIndexCount = sharedWithPresent ? static_cast<uint32_t>(sharingFamilies.size()) : 0,
+			.pQueueFamilyIndices = sharedWithPresent ? sharingFamilies.data() : nullptr,
+			.preTransform = surfaceCapabilities.currentTransform,
 			.compositeAlpha = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR,
 			.presentMode = chosenPresentMode,
 			.clipped = VK_TRUE,
-			.oldSwapchain = VK_NULL_HANDLE};
+			.oldSwapchain = oldSwapchain};
 
 		if(vkCreateSwapchainKHR(m_logicalDevice->getHandle(), &createInfo, nullptr, &m_swapchain) != VK_SUCCESS) {
 			VN_LOG_CRITICAL("Failed to create swapchain, swapchain is nullptr.");
@@ -122,27 +175,7 @@ namespace venus {
 
 		m_imageExtent = chosenExtent;
 		m_imageFormat = chosenFormat.format;
-
-		createImageViews();
-		createRenderPass();
-		createFrameBuffers();
-		VN_LOG_INFO("Swapchain construction was successful.");
-	}
-
-	Swapchain::~Swapchain() {
-		for(auto &framebuffer : m_frameBuffers) {
-			vkDestroyFramebuffer(m_logicalDevice->getHandle(), framebuffer, nullptr);
-		}
-
-		vkDestroyRenderPass(m_logicalDevice->getHandle(), m_renderPass, nullptr);
-
-		for(auto &imageView : m_swapchainImageViews) {
-			vkDestroyImageView(m_logicalDevice->getHandle(), imageView, nullptr);
-		}
-
-		assert(m_swapchain != nullptr);
-		vkDestroySwapchainKHR(m_logicalDevice->getHandle(), m_swapchain, nullptr);
-		VN_LOG_INFO("Swapchain destruction was successful.");
+		m_presentMode = chosenPresentMode;
 	}
 
 	void Swapchain::createImageViews() {
@@ -177,76 +210,4 @@ namespace venus {
 		}
 	}
 
-	void Swapchain::createFrameBuffers() {
-		m_frameBuffers.resize(m_swapchainImageViews.size());
-		for(size_t i = 0; i < m_swapchainImageViews.size(); ++i) {
-			std::vector<VkImageView> attachments = {m_swapchainImageViews[i]};
-
-			const VkFramebufferCreateInfo frameBufferInfo{.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO,
-																										.pNext = nullptr,
-																										.flags = 0,
-																										.renderPass = m_renderPass,
-																										.attachmentCount = 1,
-																										.pAttachments = attachments.data(),
-																										.width = m_imageExtent.width,
-																										.height = m_imageExtent.height,
-																										.layers = 1};
-
-			if(vkCreateFramebuffer(m_logicalDevice->getHandle(), &frameBufferInfo, nullptr, &m_frameBuffers[i]) !=
-				 VK_SUCCESS) {
-				VN_LOG_CRITICAL("Failed to create framebuffer.");
-				throw std::runtime_error("Failed to create framebuffer.");
-			}
-		}
-	}
-
-	void Swapchain::createRenderPass() {
-		const VkAttachmentDescription colorAttachmentDescription{.flags = 0,
-																														 .format = m_imageFormat,
-																														 .samples = VK_SAMPLE_COUNT_1_BIT,
-																														 .loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR,
-																														 .storeOp = VK_ATTACHMENT_STORE_OP_STORE,
-																														 .stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE,
-																														 .stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE,
-																														 .initialLayout = VK_IMAGE_LAYOUT_UNDEFINED,
-																														 .finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR};
-
-		const VkAttachmentReference colorAttachmentReference{.attachment = 0,
-																												 .layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL};
-
-		const VkSubpassDescription subpassDescription{.flags = 0,
-																									.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS,
-																									.inputAttachmentCount = 0,
-																									.pInputAttachments = nullptr,
-																									.colorAttachmentCount = 1,
-																									.pColorAttachments = &colorAttachmentReference,
-																									.pResolveAttachments = nullptr,
-																									.pDepthStencilAttachment = nullptr,
-																									.preserveAttachmentCount = 0,
-																									.pPreserveAttachments = nullptr};
-
-		const VkSubpassDependency subpassDependency{.srcSubpass = VK_SUBPASS_EXTERNAL,
-																								.dstSubpass = 0,
-																								.srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
-																								.dstStageMask = VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT,
-																								.srcAccessMask = 0,
-																								.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
-																								.dependencyFlags = 0};
-
-		const VkRenderPassCreateInfo renderPassInfo{.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO,
-																								.pNext = nullptr,
-																								.flags = 0,
-																								.attachmentCount = 1,
-																								.pAttachments = &colorAttachmentDescription,
-																								.subpassCount = 1,
-																								.pSubpasses = &subpassDescription,
-																								.dependencyCount = 1,
-																								.pDependencies = &subpassDependency};
-
-		if(vkCreateRenderPass(m_logicalDevice->getHandle(), &renderPassInfo, nullptr, &m_renderPass) != VK_SUCCESS) {
-			VN_LOG_CRITICAL("Failed to create renderpass.");
-			throw std::runtime_error("Failed to create renderpass.");
-		}
-	}
-
 }  // namespace venus
\ No newline at end of file
@@ -13,6 +13,12 @@ namespace venus {
 	class LogicalDevice;
 	class Swapchain {
 	public:
+		// Handles replaced by recreate(), they may still be referenced by frames in flight so the caller destroys them later.
+		struct RetiredResources {
+			VkSwapchainKHR swapchain = VK_NULL_HANDLE;
+			std::vector<VkImageView> imageViews;
+		};
+
 		explicit Swapchain(const std::shared_ptr<Window> &windowPtr,
 											 const std::shared_ptr<LogicalDevice> &logicalDevicePtr);
 		~Swapchain();
@@ -27,27 +33,36 @@ namespace venus {
 
 		[[nodiscard]] auto getImageExtent() const { return m_imageExtent; }
 		[[nodiscard]] auto getImageFormat() const { return m_imageFormat; }
-		[[nodiscard]] auto getImages() const { return m_swapchainImages; }
-		[[nodiscard]] auto getImageViews() const { return m_swapchainImageViews; }
+		[[nodiscard]] auto getPresentMode() const { return m_presentMode; }
+		[[nodiscard]] auto getImages() const -> const std::vector<VkImage> & { return m_swapchainImages; }
+		[[nodiscard]] auto getImageViews() const -> const std::vector<VkImageView> & { return m_swapchainImageViews; }
+
+		// A minimized window reports a zero sized framebuffer which cannot back a swapchain.
+		[[nodiscard]] auto isSurfaceDrawable() const -> bool;
 
-		[[nodiscard]] auto getRenderPass() const { return m_renderPass; }
-		[[nodiscard]] auto getFrameBuffers() const { return m_frameBuffers; }
+		/**
+     * @brief Rebuilds the swapchain for the current surface extent without waiting on the device.
+     *
+     * @details The old swapchain is handed to the driver as oldSwapchain so presentation can transition smoothly,
+     *          the image format does not change so pipelines stay valid. The replaced handles are returned
+     *          and must be passed to destroyRetired() once every frame that used them has completed.
+     *
+     * @return RetiredResources
+     */
+		[[nodiscard]] auto recreate() -> RetiredResources;
+		static void destroyRetired(VkDevice device, const RetiredResources &retired);
 
 	private:
 		VkSwapchainKHR m_swapchain = VK_NULL_HANDLE;
-
-		VkRenderPass m_renderPass = VK_NULL_HANDLE;
-		void createRenderPass();
+		void createSwapchain(VkSwapchainKHR oldSwapchain);
 
 		std::vector<VkImage> m_swapchainImages;
 		VkExtent2D m_imageExtent{};
 		VkFormat m_imageFormat{};
+		VkPresentModeKHR m_presentMode = VK_PRESENT_MODE_FIFO_KHR;
 		std::vector<VkImageView> m_swapchainImageViews;
 		void createImageViews();
 
-		std::vector<VkFramebuffer> m_frameBuffers;
-		void createFrameBuffers();
-
 		std::shared_ptr<Window> m_window;
 		std::shared_ptr<LogicalDevice> m_logicalDevice;
 	};
@@ -0,0 +1,36 @@
+#include "deletionQueue.hpp"
+#include "VN_logger.hpp"
+
+// STDLIB
+#include <cassert>
+#include <utility>
+
+namespace venus {
+
+	DeletionQueue::~DeletionQueue() {
+		if(!m_entries.empty()) {
+			VN_LOG_WARN("Deletion queue destroyed with resources still pending, they will be destroyed now.");
+			flushAll();
+		}
+	}
+
+	void DeletionQueue::retire(const uint64_t &lastUseFrameValue, std::function<void()> &&destroyFunc) {
+		assert(m_entries.empty() || m_entries.back().lastUseFrameValue <= lastUseFrameValue);
+		m_entries.push_back({.lastUseFrameValue = lastUseFrameValue, .destroyFunc = std::move(destroyFunc)});
+	}
+
+	void DeletionQueue::flush(const uint64_t &completedFrameValue) {
+		while(!m_entries.empty() && m_entries.front().lastUseFrameValue <= completedFrameValue) {
+			m_entries.front().destroyFunc();
+			m_entries.pop_front();
+		}
+	}
+
+	void DeletionQueue::flushAll() {
+		for(auto &entry : m_entries) {
+			entry.destroyFunc();
+		}
+		m_entries.clear();
+	}
+
+}  // namespace venus
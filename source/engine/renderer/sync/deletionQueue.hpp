@@ -0,0 +1,53 @@
+#ifndef VENUS_DELETION_QUEUE_HPP
+#define VENUS_DELETION_QUEUE_HPP
+
+// STDLIB
+#include <cstdint>
+#include <deque>
+#include <functional>
+
+namespace venus {
+
+	/**
+   * @brief A deferred deletion queue for gpu resources.
+   *
+   * @details Resources that may still be referenced by frames in flight are retired here instead of waiting for the device
+   *          to idle. Every entry is tagged with the last frame value that may use it, entries are destroyed once the graphics
+   *          timeline reports that value as completed by the gpu.
+   *
+   *          Frame values must be retired in non-decreasing order, which lets flushing stop at the first entry still in use.
+   *          Flushing an empty queue is free, so it is safe to call every frame.
+   *
+   *          This object cannot be copied. This object cannot be moved.
+   */
+	class DeletionQueue {
+	public:
+		DeletionQueue() = default;
+		~DeletionQueue();
+
+		DeletionQueue(const DeletionQueue &) = delete;
+		auto operator=(const DeletionQueue &) -> DeletionQueue & = delete;
+
+		DeletionQueue(const DeletionQueue &&) = delete;
+		auto operator=(const DeletionQueue &&) -> DeletionQueue & = delete;
+
+		void retire(const uint64_t &lastUseFrameValue, std::function<void()> &&destroyFunc);
+		void flush(const uint64_t &completedFrameValue);
+
+		// Destroys everything regardless of frame value, the device must be idle.
+		void flushAll();
+
+		[[nodiscard]] auto empty() const -> bool { return m_entries.empty(); }
+
+	private:
+		struct Entry {
+			uint64_t lastUseFrameValue;
+			std::function<void()> destroyFunc;
+		};
+
+		std::deque<Entry> m_entries;
+	};
+
+}  // namespace venus
+
+#endif  // VENUS_DELETION_QUEUE_HPP
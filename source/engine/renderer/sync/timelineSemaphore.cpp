@@ -0,0 +1,74 @@
+#include "timelineSemaphore.hpp"
+#include "VN_logger.hpp"
+
+// STDLIB
+#include <cassert>
+#include <stdexcept>
+
+namespace venus {
+
+	TimelineSemaphore::TimelineSemaphore(VkDevice device): m_device(device) {
+		assert(m_device != VK_NULL_HANDLE);
+
+		const VkSemaphoreTypeCreateInfo typeInfo{.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO,
+																						 .pNext = nullptr,
+																						 .semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE,
+																						 .initialValue = 0};
+
+		const VkSemaphoreCreateInfo createInfo{
+			.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO, .pNext = &typeInfo, .flags = 0};
+
+		if(vkCreateSemaphore(m_device, &createInfo, nullptr, &m_semaphore) != VK_SUCCESS) {
+			VN_LOG_CRITICAL("Failed to create timeline semaphore.");
+			throw std::runtime_error("Failed to create timeline semaphore.");
+		}
+	}
+
+	TimelineSemaphore::~TimelineSemaphore() {
+		assert(m_semaphore != VK_NULL_HANDLE);
+		vkDestroySemaphore(m_device, m_semaphore, nullptr);
+	}
+
+	void TimelineSemaphore::commitSubmittedValue(const uint64_t &value) {
+		assert(value == peekNextValue() && "submissions must signal the timeline in order.");
+		m_lastSubmittedValue.store(value, std::memory_order_release);
+	}
+
+	auto TimelineSemaphore::poll() -> uint64_t {
+		uint64_t value = 0;
+		if(vkGetSemaphoreCounterValue(m_device, m_semaphore, &value) != VK_SUCCESS) {
+			VN_LOG_CRITICAL("Failed to query timeline semaphore value.");
+			throw std::runtime_error("Failed to query timeline semaphore value.");
+		}
+		advanceCompletedValue(value);
+		return completedValue();
+	}
+
+	void TimelineSemaphore::wait(const uint64_t &value) {
+		if(isComplete(value)) {
+			return;
+		}
+
+		const VkSemaphoreWaitInfo waitInfo{.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO,
+																			 .pNext = nullptr,
+																			 .flags = 0,
+																			 .semaphoreCount = 1,
+																			 .pSemaphores = &m_semaphore,
+																			 .pValues = &value};
+
+		if(vkWaitSemaphores(m_device, &waitInfo, UINT64_MAX) != VK_SUCCESS) {
+			VN_LOG_CRITICAL("Failed to wait on timeline semaphore.");
+			throw std::runtime_error("Failed to wait on timeline semaphore.");
+		}
+		advanceCompletedValue(value);
+	}
+
+	void TimelineSemaphore::advanceCompletedValue(const uint64_t &value) {
+		// several threads may refresh the cache at once, it must only ever move forward.
+		uint64_t cached = m_completedValue.load(std::memory_order_relaxed);
+		while(cached < value &&
+					!m_completedValue.compare_exchange_weak(cached, value, std::memory_order_release, std::memory_order_relaxed)) {
+		}
+	}
+
+}  // namespace venus
@@ -0,0 +1,70 @@
+#ifndef VENUS_TIMELINE_SEMAPHORE_HPP
+#define VENUS_TIMELINE_SEMAPHORE_HPP
+
+// THIRD PARTY
+#include "volk.h"
+
+// STDLIB
+#include <atomic>
+#include <cstdint>
+
+namespace venus {
+
+	/**
+   * @brief A timeline semaphore tracking the progress of one queue.
+   *
+   * @details Every submission to the queue signals the next value from 'peekNextValue()', so "is work N done" is a
+   *          single comparison against the completed value. The completed value is cached, 'isComplete()' never calls
+   *          into the driver, the cache only advances through 'poll()' and 'wait()' which any thread may call.
+   *
+   *          Subsystems that need to know when gpu work has finished keep the value they submitted with instead of
+   *          owning fences, and may wait on or signal it from other queues for cheap cross-queue dependencies.
+   *
+   *          A value only counts as submitted once 'commitSubmittedValue()' is called after vkQueueSubmit2 succeeded,
+   *          so a failed submission never leaves waiters blocked on a value nothing will signal. Peeking and committing
+   *          are not thread safe, like vkQueueSubmit they must be externally synchronized per queue.
+   *
+   *          This object cannot be copied. This object cannot be moved.
+   */
+	class TimelineSemaphore {
+	public:
+		explicit TimelineSemaphore(VkDevice device);
+		~TimelineSemaphore();
+
+		TimelineSemaphore(const TimelineSemaphore &) = delete;
+		auto operator=(const TimelineSemaphore &) -> TimelineSemaphore & = delete;
+
+		TimelineSemaphore(const TimelineSemaphore &&) = delete;
+		auto operator=(const TimelineSemaphore &&) -> TimelineSemaphore & = delete;
+
+		[[nodiscard]] auto getHandle() const -> VkSemaphore { return m_semaphore; }
+
+		// The value the next submission must signal, commit it once the submission succeeded.
+		[[nodiscard]] auto peekNextValue() const -> uint64_t { return lastSubmittedValue() + 1; }
+		void commitSubmittedValue(const uint64_t &value);
+		[[nodiscard]] auto lastSubmittedValue() const -> uint64_t {
+			return m_lastSubmittedValue.load(std::memory_order_acquire);
+		}
+
+		// Cached, may lag behind the gpu until the next 'poll()' or 'wait()'.
+		[[nodiscard]] auto completedValue() const -> uint64_t { return m_completedValue.load(std::memory_order_acquire); }
+		[[nodiscard]] auto isComplete(const uint64_t &value) const -> bool { return value <= completedValue(); }
+
+		// Queries the driver once and refreshes the cached completed value.
+		auto poll() -> uint64_t;
+
+		// Blocks until 'value' has completed, returns immediately when the cache already says so.
+		void wait(const uint64_t &value);
+
+	private:
+		VkDevice m_device = VK_NULL_HANDLE;
+		VkSemaphore m_semaphore = VK_NULL_HANDLE;
+
+		std::atomic<uint64_t> m_lastSubmittedValue = 0;
+		std::atomic<uint64_t> m_completedValue = 0;
+		void advanceCompletedValue(const uint64_t &value);
+	};
+
+}  // namespace venus
+
+#endif  // VENUS_TIMELINE_SEMAPHORE_HPP
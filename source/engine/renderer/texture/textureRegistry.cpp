@@ -0,0 +1,248 @@
+#include "textureRegistry.hpp"
+#include "VN_logger.hpp"
+#include "bindlessDescriptors.hpp"
+#include "deletionQueue.hpp"
+#include "logicalDevice.hpp"
+
+// STDLIB
+#include <format>
+#include <stdexcept>
+
+namespace venus {
+	namespace {  // ANONYMOUS NAMESPACE BEGIN
+		constexpr VkFormat TEXTURE_FORMAT = VK_FORMAT_R8G8B8A8_SRGB;
+		constexpr VkDeviceSize TEXEL_SIZE = 4;
+
+		constexpr VkImageSubresourceRange TEXTURE_SUBRESOURCE_RANGE{.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+																																 .baseMipLevel = 0,
+																																 .levelCount = 1,
+																																 .baseArrayLayer = 0,
+																																 .layerCount = 1};
+
+		// uploads waiting for the staging ring and destroyed textures tracked before the lists reallocate.
+		constexpr size_t INITIAL_LIST_CAPACITY = 64;
+	}  // namespace
+	// ANONYMOUS NAMESPACE END
+
+	TextureRegistry::TextureRegistry(const std::shared_ptr<LogicalDevice> &logicalDevicePtr, UploadQueue &uploadQueue,
+																	 BindlessDescriptors &bindlessDescriptors):
+		m_logicalDevice(logicalDevicePtr), m_uploadQueue(uploadQueue), m_bindlessDescriptors(bindlessDescriptors) {
+		// handed out lowest first.
+		m_freeSlots.reserve(MAX_TEXTURES);
+		for(uint32_t slot = MAX_TEXTURES; slot > 0; --slot) {
+			m_freeSlots.push_back(slot - 1);
+		}
+		m_pendingUploads.reserve(INITIAL_LIST_CAPACITY);
+		m_destroyedSlots.reserve(INITIAL_LIST_CAPACITY);
+
+		VN_LOG_INFO(std::format("Texture registry created for {} textures.", MAX_TEXTURES));
+	}
+
+	TextureRegistry::~TextureRegistry() {
+		// retired textures were released when the deletion queue was flushed, what is left was never destroyed.
+		for(const TextureSlot &slot : m_slots) {
+			if(slot.image.image != VK_NULL_HANDLE) {
+				destroyImage(slot.image);
+			}
+		}
+
+		VN_LOG_INFO("Texture registry has been destroyed.");
+	}
+
+	auto TextureRegistry::createTexture(const TextureData &textureData) -> TextureHandle {
+		const VkDeviceSize size = static_cast<VkDeviceSize>(textureData.width) * textureData.height * TEXEL_SIZE;
+		if(size == 0 || textureData.texels.size() != size) {
+			VN_LOG_CRITICAL(std::format("Texture of {}x{} texels needs {} bytes, got {}.", textureData.width,
+																	textureData.height, size, textureData.texels.size()));
+			throw std::runtime_error("Texture data does not match its size.");
+		}
+		// images are uploaded in one copy, unlike meshes they are not split into chunks.
+		if(size > STAGING_RING_SIZE) {
+			VN_LOG_CRITICAL(
+				std::format("Texture of {} bytes does not fit the {} byte staging ring.", size, STAGING_RING_SIZE));
+			throw std::runtime_error("Texture does not fit the staging ring.");
+		}
+
+		// outside the lock, creating the image and writing its descriptor are safe from any thread.
+		const TextureImage image = createImage(textureData.width, textureData.height);
+
+		const std::scoped_lock lock(m_mutex);
+		if(m_freeSlots.empty()) {
+			destroyImage(image);
+			VN_LOG_CRITICAL(std::format("Cannot create more than {} textures.", MAX_TEXTURES));
+			throw std::runtime_error("Cannot create more textures.");
+		}
+
+		const uint32_t slotIndex = m_freeSlots.back();
+		m_freeSlots.pop_back();
+
+		TextureSlot &slot = m_slots[slotIndex];
+		slot.image = image;
+		slot.pending = false;
+		slot.alive = true;
+
+		const ImageUploadDetails details{.image = image.image,
+																		 .subresource = {.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+																										 .mipLevel = 0,
+																										 .baseArrayLayer = 0,
+																										 .layerCount = 1},
+																		 .extent = {.width = textureData.width, .height = textureData.height, .depth = 1},
+																		 .finalLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL};
+		const std::optional<UploadTicket> ticket = m_uploadQueue.uploadImage(details, textureData.texels);
+		if(ticket.has_value()) {
+			slot.readyTransferValue.store(ticket->transferValue, std::memory_order_release);
+		} else {
+			// the staging ring is full, 'update()' retries once earlier batches have freed it.
+			m_pendingUploads.push_back({.slot = slotIndex,
+																	.details = details,
+																	.texels = {textureData.texels.begin(), textureData.texels.end()}});
+			slot.pending = true;
+		}
+		return {.index = slotIndex};
+	}
+
+	void TextureRegistry::destroyTexture(const TextureHandle &texture) {
+		if(!texture.isValid() || texture.index >= MAX_TEXTURES) {
+			return;
+		}
+
+		const std::scoped_lock lock(m_mutex);
+		TextureSlot &slot = m_slots[texture.index];
+		if(!slot.alive) {
+			VN_LOG_WARN(std::format("Texture {} was destroyed twice.", texture.index));
+			return;
+		}
+		slot.alive = false;
+		slot.readyTransferValue.store(HIDDEN, std::memory_order_release);
+		m_destroyedSlots.push_back(texture.index);
+	}
+
+	void TextureRegistry::update(DeletionQueue &deletionQueue, const uint64_t &lastUseValue) {
+		// a texture being created holds the lock for its copy into the staging ring, its work waits for the next frame.
+		const std::unique_lock lock(m_mutex, std::try_to_lock);
+		if(!lock.owns_lock()) {
+			return;
+		}
+
+		// oldest first, the ring frees in submission order so once one upload does not fit the rest would not either.
+		size_t handledUploads = 0;
+		for(; handledUploads < m_pendingUploads.size(); ++handledUploads) {
+			const PendingUpload &upload = m_pendingUploads[handledUploads];
+			TextureSlot &slot = m_slots[upload.slot];
+			if(slot.alive) {
+				const std::optional<UploadTicket> ticket = m_uploadQueue.uploadImage(upload.details, upload.texels);
+				if(!ticket.has_value()) {
+					break;
+				}
+				slot.readyTransferValue.store(ticket->transferValue, std::memory_order_release);
+			}
+			slot.pending = false;
+		}
+		m_pendingUploads.erase(m_pendingUploads.begin(),
+													 m_pendingUploads.begin() + static_cast<std::ptrdiff_t>(handledUploads));
+
+		// a destroyed texture keeps its slot while its upload still names it.
+		std::erase_if(m_destroyedSlots, [this, &deletionQueue, &lastUseValue](const uint32_t &slotIndex) {
+			if(m_slots[slotIndex].pending) {
+				return false;
+			}
+			deletionQueue.retire(lastUseValue, [this, slotIndex]() {
+				TextureImage image;
+				{
+					const std::scoped_lock retireLock(m_mutex);
+					image = m_slots[slotIndex].image;
+					m_slots[slotIndex].image = {};
+					m_freeSlots.push_back(slotIndex);
+				}
+				destroyImage(image);
+			});
+			return true;
+		});
+	}
+
+	auto TextureRegistry::findTexture(const TextureHandle &texture) const -> std::optional<uint32_t> {
+		if(!texture.isValid() || texture.index >= MAX_TEXTURES) {
+			return std::nullopt;
+		}
+
+		const TextureSlot &slot = m_slots[texture.index];
+		const uint64_t readyTransferValue = slot.readyTransferValue.load(std::memory_order_acquire);
+		if(readyTransferValue == HIDDEN || !m_uploadQueue.isSubmitted({.transferValue = readyTransferValue})) {
+			return std::nullopt;
+		}
+		return slot.image.descriptorIndex;
+	}
+
+	auto TextureRegistry::createImage(const uint32_t &width, const uint32_t &height) -> TextureImage {
+		// written on the transfer queue and sampled on the graphics queue, shared by both when they are different families.
+		const std::span<const uint32_t> sharingFamilies = m_uploadQueue.getSharingFamilies();
+		const bool concurrent = sharingFamilies.size() > 1;
+		const VkImageCreateInfo imageInfo{
+			.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
+			.pNext = nullptr,
+			.flags = 0,
+			.imageType = VK_IMAGE_TYPE_2D,
+			.format = TEXTURE_FORMAT,
+			.extent = {.width = width, .height = height, .depth = 1},
+			.mipLevels = 1,
+			.arrayLayers = 1,
+			.samples = VK_SAMPLE_COUNT_1_BIT,
+			.tiling = VK_IMAGE_TILING_OPTIMAL,
+			.usage = VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
+			.sharingMode = concurrent ? VK_SHARING_MODE_CONCURRENT : VK_SHARING_MODE_EXCLUSIVE,
+			.queueFamilyIndexCount = concurrent ? static_cast<uint32_t>(sharingFamilies.size()) : 0,
+			.pQueueFamilyIndices = concurrent ? sharingFamilies.data() : nullptr,
+			.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED};
+
+		const VkDevice device = m_logicalDevice->getHandle();
+		TextureImage image;
+		if(vkCreateImage(device, &imageInfo, nullptr, &image.image) != VK_SUCCESS) {
+			VN_LOG_CRITICAL("Failed to create texture image.");
+			throw std::runtime_error("Failed to create texture image.");
+		}
+
+		try {
+			image.allocation = m_logicalDevice->getDeviceAllocator().allocateForImage(
+				image.image, {.usage = MEMORY_USAGE_GPU_ONLY, .tiling = RESOURCE_TILING_OPTIMAL});
+		} catch(...) {
+			vkDestroyImage(device, image.image, nullptr);
+			throw;
+		}
+
+		const VkImageViewCreateInfo viewInfo{.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO,
+																				 .pNext = nullptr,
+																				 .flags = 0,
+																				 .image = image.image,
+																				 .viewType = VK_IMAGE_VIEW_TYPE_2D,
+																				 .format = TEXTURE_FORMAT,
+																				 .components = {.r = VK_COMPONENT_SWIZZLE_IDENTITY,
+																												.g = VK_COMPONENT_SWIZZLE_IDENTITY,
+																												.b = VK_COMPONENT_SWIZZLE_IDENTITY,
+																												.a = VK_COMPONENT_SWIZZLE_IDENTITY},
+																				 .subresourceRange = TEXTURE_SUBRESOURCE_RANGE};
+		if(vkCreateImageView(device, &viewInfo, nullptr, &image.view) != VK_SUCCESS) {
+			destroyImage(image);
+			VN_LOG_CRITICAL("Failed to create texture image view.");
+			throw std::runtime_error("Failed to create texture image view.");
+		}
+
+		try {
+			image.descriptorIndex = m_bindlessDescriptors.addSampledImage(image.view);
+		} catch(...) {
+			destroyImage(image);
+			throw;
+		}
+		return image;
+	}
+
+	void TextureRegistry::destroyImage(const TextureImage &image) {
+		if(image.descriptorIndex != UINT32_MAX) {
+			m_bindlessDescriptors.removeSampledImage(image.descriptorIndex);
+		}
+		const VkDevice device = m_logicalDevice->getHandle();
+		vkDestroyImageView(device, image.view, nullptr);
+		vkDestroyImage(device, image.image, nullptr);
+		m_logicalDevice->getDeviceAllocator().free(image.allocation);
+	}
+
+}  // namespace venus
@@ -0,0 +1,112 @@
+#ifndef VENUS_TEXTURE_REGISTRY_HPP
+#define VENUS_TEXTURE_REGISTRY_HPP
+
+// PROJECT
+#include "deviceAllocator.hpp"
+#include "drawPacket.hpp"
+#include "renderConfig.hpp"
+#include "uploadQueue.hpp"
+
+// THIRD PARTY
+#include "volk.h"
+
+// STDLIB
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace venus {
+	class LogicalDevice;
+	class DeletionQueue;
+	class BindlessDescriptors;
+
+	/**
+   * @brief Owns the textures materials sample, each a sampled image of the bindless set.
+   *
+   * @details A texture is an sRGB RGBA8 image with a single mip level. Its view is added to the bindless set when the
+   *          texture is created, shaders then reach it by the index 'findTexture()' returns, no descriptor is bound
+   *          per draw.
+   *
+   *          Textures are created and destroyed from any thread. The texels go through the UploadQueue in one copy
+   *          that leaves the image ready to be sampled, a copy that does not fit into the staging ring yet is kept and
+   *          retried by 'update()' on later frames. Until it has been submitted 'findTexture()' returns nothing.
+   *
+   *          A destroyed texture disappears from 'findTexture()' right away, its image and bindless index are released
+   *          once the graphics timeline passes the frames that may still sample it.
+   *
+   *          This object cannot be copied. This object cannot be moved.
+   */
+	class TextureRegistry {
+	public:
+		explicit TextureRegistry(const std::shared_ptr<LogicalDevice> &logicalDevicePtr, UploadQueue &uploadQueue,
+														 BindlessDescriptors &bindlessDescriptors);
+		~TextureRegistry();
+
+		TextureRegistry(const TextureRegistry &) = delete;
+		auto operator=(const TextureRegistry &) -> TextureRegistry & = delete;
+
+		TextureRegistry(const TextureRegistry &&) = delete;
+		auto operator=(const TextureRegistry &&) -> TextureRegistry & = delete;
+
+		// Any thread. Throws when the texels do not match the size, do not fit the staging ring at all or the texture
+		// handles are exhausted.
+		[[nodiscard]] auto createTexture(const TextureData &textureData) -> TextureHandle;
+		void destroyTexture(const TextureHandle &texture);
+
+		// Render thread only, before the frame's uploads are submitted. 'lastUseValue' is the graphics timeline value of
+		// the most recent submission, which is the last that may sample a texture destroyed since the previous call.
+		void update(DeletionQueue &deletionQueue, const uint64_t &lastUseValue);
+
+		// Render thread only, never blocks. The texture's sampled image index in the bindless set, nothing for invalid,
+		// destroyed and not yet uploaded textures.
+		[[nodiscard]] auto findTexture(const TextureHandle &texture) const -> std::optional<uint32_t>;
+
+	private:
+		std::shared_ptr<LogicalDevice> m_logicalDevice;
+		UploadQueue &m_uploadQueue;
+		BindlessDescriptors &m_bindlessDescriptors;
+
+		struct TextureImage {
+			VkImage image = VK_NULL_HANDLE;
+			VkImageView view = VK_NULL_HANDLE;
+			DeviceAllocation allocation;
+			uint32_t descriptorIndex = UINT32_MAX;
+		};
+
+		// the ticket is published last with a release store, UINT64_MAX keeps the texture hidden from 'findTexture()'.
+		static constexpr uint64_t HIDDEN = UINT64_MAX;
+		struct TextureSlot {
+			TextureImage image;  // written before the ticket is published.
+			std::atomic<uint64_t> readyTransferValue = HIDDEN;
+
+			// guarded by the mutex.
+			bool pending = false;
+			bool alive = false;
+		};
+		std::array<TextureSlot, MAX_TEXTURES> m_slots;
+
+		struct PendingUpload {
+			uint32_t slot;
+			ImageUploadDetails details;
+			std::vector<std::byte> texels;
+		};
+
+		// guards the slots' bookkeeping and the lists below.
+		std::mutex m_mutex;
+		std::vector<uint32_t> m_freeSlots;
+		std::vector<PendingUpload> m_pendingUploads;
+		std::vector<uint32_t> m_destroyedSlots;
+
+		// any thread, the view is added to the bindless set as well.
+		[[nodiscard]] auto createImage(const uint32_t &width, const uint32_t &height) -> TextureImage;
+		void destroyImage(const TextureImage &image);
+	};
+
+}  // namespace venus
+
+#endif  // VENUS_TEXTURE_REGISTRY_HPP
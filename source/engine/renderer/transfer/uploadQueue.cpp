@@ -0,0 +1,351 @@
+#include "uploadQueue.hpp"
+#include "VN_logger.hpp"
+#include "logicalDevice.hpp"
+#include "timelineSemaphore.hpp"
+
+// STDLIB
+#include <cstring>
+#include <format>
+#include <stdexcept>
+
+namespace venus {
+	namespace {  // ANONYMOUS NAMESPACE BEGIN
+		// covers optimalBufferCopyOffsetAlignment in practice and the texel size of every power of two sized format.
+		constexpr VkDeviceSize STAGING_ALIGNMENT = 16;
+
+		// copies queued per frame before the queues reallocate, only bursts beyond it allocate.
+		constexpr size_t INITIAL_COPY_CAPACITY = 256;
+
+		auto alignUp(const VkDeviceSize &value, const VkDeviceSize &alignment) -> VkDeviceSize {
+			return (value + alignment - 1) & ~(alignment - 1);
+		}
+	}  // namespace
+	// ANONYMOUS NAMESPACE END
+
+	UploadQueue::UploadQueue(const std::shared_ptr<LogicalDevice> &logicalDevicePtr): m_logicalDevice(logicalDevicePtr) {
+		m_transferTimeline = std::make_unique<TimelineSemaphore>(m_logicalDevice->getHandle());
+
+		const uint32_t graphicsFamily = m_logicalDevice->queueFamilyIndices().graphicsFamilyIndex.value();  // NOLINT
+		const uint32_t transferFamily = m_logicalDevice->getTransferFamilyIndex();
+		m_sharingFamilies = {graphicsFamily, transferFamily};
+		m_sharingFamilyCount = graphicsFamily == transferFamily ? 1 : 2;
+
+		createRing();
+		createBatches();
+		m_queuedCopies.reserve(INITIAL_COPY_CAPACITY);
+		m_recordingCopies.reserve(INITIAL_COPY_CAPACITY);
+		m_imageBarriers.reserve(INITIAL_COPY_CAPACITY);
+
+		VN_LOG_INFO(std::format("Upload queue created with a {} MiB staging ring on queue family {}.",
+														STAGING_RING_SIZE / (1024 * 1024), transferFamily));
+	}
+
+	UploadQueue::~UploadQueue() {
+		m_transferTimeline->wait(m_transferTimeline->lastSubmittedValue());
+
+		const VkDevice device = m_logicalDevice->getHandle();
+		for(const Batch &batch : m_batches) {
+			vkDestroyCommandPool(device, batch.commandPool, nullptr);
+		}
+		vkDestroyBuffer(device, m_ringBuffer, nullptr);
+		m_logicalDevice->getDeviceAllocator().free(m_ringAllocation);
+		m_transferTimeline.reset();
+
+		VN_LOG_INFO("Upload queue has been destroyed.");
+	}
+
+	auto UploadQueue::uploadBuffer(VkBuffer buffer, const VkDeviceSize &offset, std::span<const std::byte> data)
+		-> std::optional<UploadTicket> {
+		return enqueue(data, {.stagingOffset = 0, .size = 0, .buffer = buffer, .bufferOffset = offset, .image = {}});
+	}
+
+	auto UploadQueue::uploadImage(const ImageUploadDetails &details, std::span<const std::byte> data)
+		-> std::optional<UploadTicket> {
+		return enqueue(data,
+									 {.stagingOffset = 0, .size = 0, .buffer = VK_NULL_HANDLE, .bufferOffset = 0, .image = details});
+	}
+
+	auto UploadQueue::isComplete(const UploadTicket &ticket) const -> bool {
+		return m_transferTimeline->isComplete(ticket.transferValue);
+	}
+
+	auto UploadQueue::isSubmitted(const UploadTicket &ticket) const -> bool {
+		return ticket.transferValue <= m_transferTimeline->lastSubmittedValue();
+	}
+
+	auto UploadQueue::submit() -> std::optional<VkSemaphoreSubmitInfo> {
+		const Batch *submittedBatch = nullptr;
+		{
+			// an upload holding the lock is in the middle of its memcpy, its copies go out with the next frame instead.
+			const std::unique_lock lock(m_mutex, std::try_to_lock);
+			if(lock.owns_lock()) {
+				m_transferTimeline->poll();
+				reclaimCompletedBatches();
+
+				Batch &batch = m_batches[m_nextBatch];
+				if(!m_queuedCopies.empty() && m_transferTimeline->isComplete(batch.transferValue)) {
+					m_recordingCopies.swap(m_queuedCopies);
+					batch.transferValue = m_nextTransferValue++;
+					batch.ringBytes = m_queuedRingBytes;
+					m_queuedRingBytes = 0;
+					m_nextBatch = (m_nextBatch + 1) % MAX_FRAMES_IN_FLIGHT;
+					submittedBatch = &batch;
+				}
+			}
+		}
+
+		if(submittedBatch != nullptr) {
+			recordBatch(*submittedBatch);
+			m_recordingCopies.clear();
+
+			const VkSemaphoreSubmitInfo signalInfo{.sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO,
+																						 .pNext = nullptr,
+																						 .semaphore = m_transferTimeline->getHandle(),
+																						 .value = submittedBatch->transferValue,
+																						 .stageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT,
+																						 .deviceIndex = 0};
+			const VkCommandBufferSubmitInfo commandBufferInfo{.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO,
+																												.pNext = nullptr,
+																												.commandBuffer = submittedBatch->commandBuffer,
+																												.deviceMask = 0};
+			const VkSubmitInfo2 submitInfo{.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO_2,
+																		 .pNext = nullptr,
+																		 .flags = 0,
+																		 .waitSemaphoreInfoCount = 0,
+																		 .pWaitSemaphoreInfos = nullptr,
+																		 .commandBufferInfoCount = 1,
+																		 .pCommandBufferInfos = &commandBufferInfo,
+																		 .signalSemaphoreInfoCount = 1,
+																		 .pSignalSemaphoreInfos = &signalInfo};
+
+			if(vkQueueSubmit2(m_logicalDevice->getTransferQueue(), 1, &submitInfo, VK_NULL_HANDLE) != VK_SUCCESS) {
+				VN_LOG_CRITICAL("Failed to submit transfer queue.");
+				throw std::runtime_error("Failed to submit transfer queue.");
+			}
+			m_transferTimeline->commitSubmittedValue(submittedBatch->transferValue);
+		}
+
+		// waiting on the latest batch covers every earlier one, the timeline completes in submission order.
+		const uint64_t submittedValue = m_transferTimeline->lastSubmittedValue();
+		if(submittedValue == m_lastGraphicsWaitValue) {
+			return std::nullopt;
+		}
+		m_lastGraphicsWaitValue = submittedValue;
+
+		// uploads may feed any stage, from index fetches to fragment shader reads.
+		return VkSemaphoreSubmitInfo{.sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO,
+																 .pNext = nullptr,
+																 .semaphore = m_transferTimeline->getHandle(),
+																 .value = submittedValue,
+																 .stageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT,
+																 .deviceIndex = 0};
+	}
+
+	void UploadQueue::createRing() {
+		const VkBufferCreateInfo bufferInfo{.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+																				.pNext = nullptr,
+																				.flags = 0,
+																				.size = STAGING_RING_SIZE,
+																				.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+																				.sharingMode = VK_SHARING_MODE_EXCLUSIVE,
+																				.queueFamilyIndexCount = 0,
+																				.pQueueFamilyIndices = nullptr};
+
+		if(vkCreateBuffer(m_logicalDevice->getHandle(), &bufferInfo, nullptr, &m_ringBuffer) != VK_SUCCESS) {
+			VN_LOG_CRITICAL("Failed to create staging ring buffer.");
+			throw std::runtime_error("Failed to create staging ring buffer.");
+		}
+
+		// upload memory is host visible and coherent, writes need no flush and the allocator keeps it mapped.
+		m_ringAllocation = m_logicalDevice->getDeviceAllocator().allocateForBuffer(
+			m_ringBuffer, {.usage = MEMORY_USAGE_UPLOAD, .tiling = RESOURCE_TILING_LINEAR});
+		m_ringData = static_cast<std::byte *>(m_ringAllocation.mappedData);
+	}
+
+	void UploadQueue::createBatches() {
+		const VkCommandPoolCreateInfo poolInfo{.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO,
+																					 .pNext = nullptr,
+																					 .flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT,
+																					 .queueFamilyIndex = m_logicalDevice->getTransferFamilyIndex()};
+
+		for(Batch &batch : m_batches) {
+			if(vkCreateCommandPool(m_logicalDevice->getHandle(), &poolInfo, nullptr, &batch.commandPool) != VK_SUCCESS) {
+				VN_LOG_CRITICAL("Failed to create transfer pool.");
+				throw std::runtime_error("Failed to create transfer pool.");
+			}
+
+			const VkCommandBufferAllocateInfo allocInfo{.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
+																									.pNext = nullptr,
+																									.commandPool = batch.commandPool,
+																									.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY,
+																									.commandBufferCount = 1};
+			if(vkAllocateCommandBuffers(m_logicalDevice->getHandle(), &allocInfo, &batch.commandBuffer) != VK_SUCCESS) {
+				VN_LOG_CRITICAL("Failed to allocate transfer command buffer.");
+				throw std::runtime_error("Failed to allocate transfer command buffer.");
+			}
+		}
+	}
+
+	auto UploadQueue::enqueue(std::span<const std::byte> data, PendingCopy copy) -> std::optional<UploadTicket> {
+		if(data.empty()) {
+			return UploadTicket{};
+		}
+		if(data.size() > STAGING_RING_SIZE) {
+			VN_LOG_ERROR(std::format("Upload of {} bytes is larger than the {} byte staging ring and never fits.",
+															 data.size(), STAGING_RING_SIZE));
+			return std::nullopt;
+		}
+
+		const std::scoped_lock lock(m_mutex);
+		const std::optional<VkDeviceSize> stagingOffset = reserveRing(data.size());
+		if(!stagingOffset.has_value()) {
+			return std::nullopt;
+		}
+
+		std::memcpy(m_ringData + stagingOffset.value(), data.data(), data.size());
+		copy.stagingOffset = stagingOffset.value();
+		copy.size = data.size();
+		m_queuedCopies.push_back(copy);
+
+		// the next batch takes its value under the same lock, so this is the value the copy will be submitted with.
+		return UploadTicket{.transferValue = m_nextTransferValue};
+	}
+
+	auto UploadQueue::reserveRing(const VkDeviceSize &size) -> std::optional<VkDeviceSize> {
+		if(m_ringUsedBytes == 0) {
+			m_ringHead = 0;
+		}
+
+		// the free space is one contiguous run from the head around to the oldest batch still in flight, a copy that
+		// does not fit before the end of the ring starts over at zero and the skipped tail counts as used.
+		VkDeviceSize offset = alignUp(m_ringHead, STAGING_ALIGNMENT);
+		VkDeviceSize consumed = offset + size - m_ringHead;
+		if(offset + size > STAGING_RING_SIZE) {
+			offset = 0;
+			consumed = (STAGING_RING_SIZE - m_ringHead) + size;
+		}
+
+		if(m_ringUsedBytes + consumed > STAGING_RING_SIZE) {
+			m_transferTimeline->poll();
+			reclaimCompletedBatches();
+			if(m_ringUsedBytes + consumed > STAGING_RING_SIZE) {
+				return std::nullopt;
+			}
+		}
+
+		m_ringHead = (offset + size) % STAGING_RING_SIZE;
+		m_ringUsedBytes += consumed;
+		m_queuedRingBytes += consumed;
+		return offset;
+	}
+
+	void UploadQueue::reclaimCompletedBatches() {
+		// oldest first, the ring is only freed from its tail.
+		for(uint32_t i = 0; i < MAX_FRAMES_IN_FLIGHT; ++i) {
+			Batch &batch = m_batches[(m_nextBatch + i) % MAX_FRAMES_IN_FLIGHT];
+			if(batch.ringBytes == 0) {
+				continue;
+			}
+			if(!m_transferTimeline->isComplete(batch.transferValue)) {
+				break;
+			}
+			m_ringUsedBytes -= batch.ringBytes;
+			batch.ringBytes = 0;
+		}
+	}
+
+	void UploadQueue::recordBatch(const Batch &batch) {
+		if(vkResetCommandPool(m_logicalDevice->getHandle(), batch.commandPool, 0) != VK_SUCCESS) {
+			VN_LOG_CRITICAL("Failed to reset transfer pool.");
+			throw std::runtime_error("Failed to reset transfer pool.");
+		}
+
+		const VkCommandBufferBeginInfo beginInfo{.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+																						 .pNext = nullptr,
+																						 .flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT,
+																						 .pInheritanceInfo = nullptr};
+		if(vkBeginCommandBuffer(batch.commandBuffer, &beginInfo) != VK_SUCCESS) {
+			VN_LOG_CRITICAL("Failed to begin recording transfer buffer.");
+			throw std::runtime_error("Failed to begin recording transfer buffer.");
+		}
+
+		// image layouts are changed in two batched barriers around all copies, buffers need none, the timeline
+		// semaphore the graphics queue waits on makes the copies visible to it.
+		m_imageBarriers.clear();
+		for(const PendingCopy &copy : m_recordingCopies) {
+			if(copy.buffer != VK_NULL_HANDLE) {
+				continue;
+			}
+			const VkImageSubresourceLayers &subresource = copy.image.subresource;
+			m_imageBarriers.push_back({.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2,
+																 .pNext = nullptr,
+																 .srcStageMask = VK_PIPELINE_STAGE_2_NONE,
+																 .srcAccessMask = VK_ACCESS_2_NONE,
+																 .dstStageMask = VK_PIPELINE_STAGE_2_COPY_BIT,
+																 .dstAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT,
+																 .oldLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+																 .newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+																 .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+																 .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+																 .image = copy.image.image,
+																 .subresourceRange = {.aspectMask = subresource.aspectMask,
+																											.baseMipLevel = subresource.mipLevel,
+																											.levelCount = 1,
+																											.baseArrayLayer = subresource.baseArrayLayer,
+																											.layerCount = subresource.layerCount}});
+		}
+
+		VkDependencyInfo dependencyInfo{.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO,
+																		.pNext = nullptr,
+																		.dependencyFlags = 0,
+																		.memoryBarrierCount = 0,
+																		.pMemoryBarriers = nullptr,
+																		.bufferMemoryBarrierCount = 0,
+																		.pBufferMemoryBarriers = nullptr,
+																		.imageMemoryBarrierCount = static_cast<uint32_t>(m_imageBarriers.size()),
+																		.pImageMemoryBarriers = m_imageBarriers.data()};
+		if(!m_imageBarriers.empty()) {
+			vkCmdPipelineBarrier2(batch.commandBuffer, &dependencyInfo);
+		}
+
+		for(const PendingCopy &copy : m_recordingCopies) {
+			if(copy.buffer != VK_NULL_HANDLE) {
+				const VkBufferCopy region{.srcOffset = copy.stagingOffset, .dstOffset = copy.bufferOffset, .size = copy.size};
+				vkCmdCopyBuffer(batch.commandBuffer, m_ringBuffer, copy.buffer, 1, &region);
+				continue;
+			}
+
+			const VkBufferImageCopy region{.bufferOffset = copy.stagingOffset,
+																		 .bufferRowLength = 0,
+																		 .bufferImageHeight = 0,
+																		 .imageSubresource = copy.image.subresource,
+																		 .imageOffset = {0, 0, 0},
+																		 .imageExtent = copy.image.extent};
+			vkCmdCopyBufferToImage(batch.commandBuffer, m_ringBuffer, copy.image.image,
+														 VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+		}
+
+		if(!m_imageBarriers.empty()) {
+			uint32_t barrierIndex = 0;
+			for(const PendingCopy &copy : m_recordingCopies) {
+				if(copy.buffer != VK_NULL_HANDLE) {
+					continue;
+				}
+				VkImageMemoryBarrier2 &barrier = m_imageBarriers[barrierIndex++];
+				barrier.srcStageMask = VK_PIPELINE_STAGE_2_COPY_BIT;
+				barrier.srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+				barrier.dstStageMask = VK_PIPELINE_STAGE_2_NONE;
+				barrier.dstAccessMask = VK_ACCESS_2_NONE;
+				barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+				barrier.newLayout = copy.image.finalLayout;
+			}
+			vkCmdPipelineBarrier2(batch.commandBuffer, &dependencyInfo);
+		}
+
+		if(vkEndCommandBuffer(batch.commandBuffer) != VK_SUCCESS) {
+			VN_LOG_CRITICAL("Failed to record transfer buffer.");
+			throw std::runtime_error("Failed to record transfer buffer.");
+		}
+	}
+
+}  // namespace venus
@@ -0,0 +1,149 @@
+#ifndef VENUS_UPLOAD_QUEUE_HPP
+#define VENUS_UPLOAD_QUEUE_HPP
+
+// PROJECT
+#include "deviceAllocator.hpp"
+#include "renderConfig.hpp"
+
+// THIRD PARTY
+#include "volk.h"
+
+// STDLIB
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace venus {
+	class LogicalDevice;
+	class TimelineSemaphore;
+
+	// Identifies the batch an upload was submitted with, see 'UploadQueue::isComplete()'.
+	struct UploadTicket {
+		uint64_t transferValue = 0;
+	};
+
+	// Replaces one subresource of an image, whatever it held before is discarded.
+	struct ImageUploadDetails {
+		VkImage image;
+		VkImageSubresourceLayers subresource;
+		VkExtent3D extent;
+		VkImageLayout finalLayout;  // the layout the graphics queue finds the image in.
+	};
+
+	/**
+   * @brief Streams buffer and image data to the gpu through a staging ring on the transfer queue.
+   *
+   * @details Any thread may upload. The data is copied into a persistently mapped staging ring right away and the copy
+   *          is queued, the caller may free its data as soon as the call returns. Once per frame the render thread calls
+   *          'submit()', which records every queued copy into one command buffer and submits it to the transfer queue
+   *          signaling the transfer timeline. The frame's graphics submission waits on that value, so draws recorded
+   *          after 'submit()' see the data while rendering itself never waits on the cpu for a copy.
+   *
+   *          Staging memory is reclaimed in submission order once the transfer timeline passes each batch. When the
+   *          ring is full an upload returns nothing instead of blocking, the caller retries on a later frame. An upload
+   *          larger than the whole ring never fits and must be split.
+   *
+   *          Uploads hold a lock for their memcpy, 'submit()' only tries the lock and leaves the queued copies for the
+   *          next frame rather than waiting on a large copy.
+   *
+   *          Copies run on LogicalDevice's transfer queue. When that is not a graphics queue the destination resources
+   *          are used by two queue families, create them with VK_SHARING_MODE_CONCURRENT over 'getSharingFamilies()',
+   *          which then holds both families, so no ownership transfers are needed.
+   *
+   *          This object cannot be copied. This object cannot be moved.
+   */
+	class UploadQueue {
+	public:
+		explicit UploadQueue(const std::shared_ptr<LogicalDevice> &logicalDevicePtr);
+		~UploadQueue();
+
+		UploadQueue(const UploadQueue &) = delete;
+		auto operator=(const UploadQueue &) -> UploadQueue & = delete;
+
+		UploadQueue(const UploadQueue &&) = delete;
+		auto operator=(const UploadQueue &&) -> UploadQueue & = delete;
+
+		// Any thread. Nothing when the staging ring has no room for 'data' yet.
+		[[nodiscard]] auto uploadBuffer(VkBuffer buffer, const VkDeviceSize &offset, std::span<const std::byte> data)
+			-> std::optional<UploadTicket>;
+		// Any thread. 'data' holds the texels tightly packed, nothing when the staging ring has no room for it yet.
+		[[nodiscard]] auto uploadImage(const ImageUploadDetails &details, std::span<const std::byte> data)
+			-> std::optional<UploadTicket>;
+
+		// Any thread. Cached like the timeline it reads, it advances once per frame with 'submit()'.
+		[[nodiscard]] auto isComplete(const UploadTicket &ticket) const -> bool;
+
+		// Render thread only. True once the copy went out with a 'submit()', every graphics submission made afterwards
+		// is ordered after it, so draws recorded from now on may read the data.
+		[[nodiscard]] auto isSubmitted(const UploadTicket &ticket) const -> bool;
+
+		/**
+     * @brief Submits the copies queued since the last call, render thread only.
+     *
+     * @details Returns the wait the next graphics submission must add when a batch was submitted that no graphics
+     *          submission waited on yet. Never blocks and does not allocate once the ring and batches are warm.
+     */
+		[[nodiscard]] auto submit() -> std::optional<VkSemaphoreSubmitInfo>;
+
+		[[nodiscard]] auto getSharingFamilies() const -> std::span<const uint32_t> {
+			return {m_sharingFamilies.data(), m_sharingFamilyCount};
+		}
+
+	private:
+		std::shared_ptr<LogicalDevice> m_logicalDevice;
+		std::unique_ptr<TimelineSemaphore> m_transferTimeline;
+		std::array<uint32_t, 2> m_sharingFamilies{};
+		uint32_t m_sharingFamilyCount = 1;
+
+		VkBuffer m_ringBuffer = VK_NULL_HANDLE;
+		DeviceAllocation m_ringAllocation;
+		std::byte *m_ringData = nullptr;
+
+		struct PendingCopy {
+			VkDeviceSize stagingOffset;
+			VkDeviceSize size;
+			VkBuffer buffer;  // VK_NULL_HANDLE for image copies.
+			VkDeviceSize bufferOffset;
+			ImageUploadDetails image;
+		};
+
+		// one batch per frame in flight, a batch is only reused once the transfer timeline has passed it.
+		struct Batch {
+			VkCommandPool commandPool = VK_NULL_HANDLE;
+			VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+			uint64_t transferValue = 0;
+			VkDeviceSize ringBytes = 0;  // staging memory to reclaim once the batch completes.
+		};
+		std::array<Batch, MAX_FRAMES_IN_FLIGHT> m_batches;
+		uint32_t m_nextBatch = 0;
+		uint64_t m_lastGraphicsWaitValue = 0;
+
+		// guards the ring cursor, the queued copies and the batches' reclaim bookkeeping.
+		std::mutex m_mutex;
+		VkDeviceSize m_ringHead = 0;
+		VkDeviceSize m_ringUsedBytes = 0;
+		VkDeviceSize m_queuedRingBytes = 0;
+		std::vector<PendingCopy> m_queuedCopies;
+		// the value the next batch signals, ahead of the timeline's submitted value until that batch is submitted.
+		uint64_t m_nextTransferValue = 1;
+
+		// render thread only, swapped with the queued copies so neither vector reallocates once warm.
+		std::vector<PendingCopy> m_recordingCopies;
+		std::vector<VkImageMemoryBarrier2> m_imageBarriers;
+
+		void createRing();
+		void createBatches();
+		[[nodiscard]] auto enqueue(std::span<const std::byte> data, PendingCopy copy) -> std::optional<UploadTicket>;
+		[[nodiscard]] auto reserveRing(const VkDeviceSize &size) -> std::optional<VkDeviceSize>;
+		void reclaimCompletedBatches();
+		void recordBatch(const Batch &batch);
+	};
+
+}  // namespace venus
+
+#endif  // VENUS_UPLOAD_QUEUE_HPP
@@ -1,5 +1,6 @@
 #include "keyboardInput.hpp"
 #include "VN_logger.hpp"
+#include "window.hpp"
 
 // STDLIB
 #include <cstdlib>
@@ -13,6 +14,13 @@ namespace venus {
 			VN_LOG_INFO("End key was pressed.");
 			glfwSetWindowShouldClose(window, GLFW_TRUE);
 		}
+
+		if(key == GLFW_KEY_F11 && action == GLFW_PRESS) {
+			auto *venusWindow = static_cast<Window *>(glfwGetWindowUserPointer(window));
+			if(venusWindow != nullptr) {
+				venusWindow->toggleFullscreen();
+			}
+		}
 	}
 
 }  // namespace venus
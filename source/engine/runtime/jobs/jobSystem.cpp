@@ -0,0 +1,203 @@
+#include "jobSystem.hpp"
+#include "VN_logger.hpp"
+
+// STDLIB
+#include <bit>
+#include <cassert>
+#include <format>
+#include <stdexcept>
+
+namespace venus {
+	namespace {  // ANONYMOUS NAMESPACE BEGIN
+		constexpr uint32_t NOT_A_WORKER = UINT32_MAX;
+
+		// trivially constructible so accessing it never requires a tls-initialization guard.
+		thread_local uint32_t CURRENT_WORKER_INDEX = NOT_A_WORKER;
+
+		std::atomic<bool> JOB_SYSTEM_ALIVE = false;
+
+		auto nextRandom(uint32_t &state) -> uint32_t {
+			// xorshift32, only used to spread steal attempts so quality hardly matters.
+			state ^= state << 13U;
+			state ^= state >> 17U;
+			state ^= state << 5U;
+			return state;
+		}
+	}  // namespace
+	// ANONYMOUS NAMESPACE END
+
+	JobSystem::JobSystem(const uint32_t &threadCount) {
+		assert(threadCount > 0);
+		if(JOB_SYSTEM_ALIVE.exchange(true)) {
+			VN_LOG_CRITICAL("Only one job system may exist at a time.");
+			throw std::runtime_error("Only one job system may exist at a time.");
+		}
+
+		m_threadCount = threadCount;
+		const uint32_t workerCount = threadCount + MAX_ATTACHED_THREADS;
+		m_jobs = std::make_unique<Job[]>(workerCount * JOB_RING_CAPACITY);
+		m_jobsInFlight = std::make_unique<std::atomic<bool>[]>(workerCount * JOB_RING_CAPACITY);
+
+		m_workers.reserve(workerCount);
+		for(uint32_t i = 0; i < workerCount; ++i) {
+			m_workers.push_back(std::make_unique<Worker>());
+			m_workers.back()->firstJob = i * static_cast<uint32_t>(JOB_RING_CAPACITY);
+			m_workers.back()->stealSeed = i + 1;  // xorshift state must be non-zero.
+		}
+
+		CURRENT_WORKER_INDEX = 0;
+		m_threads.reserve(threadCount - 1);
+		for(uint32_t workerIndex = 1; workerIndex < threadCount; ++workerIndex) {
+			m_threads.emplace_back(&JobSystem::workerLoop, this, workerIndex);
+		}
+
+		VN_LOG_INFO(std::format("Job system created with {} threads.", threadCount));
+	}
+
+	JobSystem::~JobSystem() {
+		m_stopping.store(true, std::memory_order_release);
+		m_wakeEpoch.fetch_add(1, std::memory_order_release);
+		m_wakeEpoch.notify_all();
+		m_threads.clear();
+
+		CURRENT_WORKER_INDEX = NOT_A_WORKER;
+		JOB_SYSTEM_ALIVE.store(false);
+		VN_LOG_INFO("Job system has been destroyed.");
+	}
+
+	void JobSystem::attachCurrentThread() {
+		assert(CURRENT_WORKER_INDEX == NOT_A_WORKER);
+
+		uint32_t slotMask = m_attachedSlotMask.load(std::memory_order_relaxed);
+		uint32_t slot = 0;
+		do {
+			slot = static_cast<uint32_t>(std::countr_one(slotMask));
+			if(slot >= MAX_ATTACHED_THREADS) {
+				VN_LOG_CRITICAL("Too many threads attached to the job system.");
+				throw std::runtime_error("Too many threads attached to the job system.");
+			}
+		} while(!m_attachedSlotMask.compare_exchange_weak(slotMask, slotMask | (1U << slot), std::memory_order_acquire,
+																											 std::memory_order_relaxed));
+
+		CURRENT_WORKER_INDEX = m_threadCount + slot;
+	}
+
+	void JobSystem::detachCurrentThread() {
+		assert(CURRENT_WORKER_INDEX >= m_threadCount && CURRENT_WORKER_INDEX < m_workers.size());
+		assert(currentWorker().queue.approximateSize() == 0);
+
+		const uint32_t slot = CURRENT_WORKER_INDEX - m_threadCount;
+		CURRENT_WORKER_INDEX = NOT_A_WORKER;
+		m_attachedSlotMask.fetch_and(~(1U << slot), std::memory_order_release);
+	}
+
+	void JobSystem::wait(const JobCounter &counter) {
+		while(!counter.isDone()) {
+			Job *job = findJob();
+			if(job != nullptr) {
+				execute(*job);
+			} else {
+				std::this_thread::yield();
+			}
+		}
+	}
+
+	void JobSystem::workerLoop(const uint32_t &workerIndex) {
+		CURRENT_WORKER_INDEX = workerIndex;
+
+		while(!m_stopping.load(std::memory_order_acquire)) {
+			Job *job = findJob();
+			if(job != nullptr) {
+				execute(*job);
+				continue;
+			}
+
+			// announce the sleep and read the epoch before the final look, a job submitted in between either is found
+			// or changes the epoch so the wait falls through. Submitters skip the wake syscall while nobody sleeps.
+			m_sleepingWorkers.fetch_add(1, std::memory_order_seq_cst);
+			const uint32_t epoch = m_wakeEpoch.load(std::memory_order_seq_cst);
+			job = findJob();
+			if(job == nullptr) {
+				m_wakeEpoch.wait(epoch, std::memory_order_seq_cst);
+			}
+			m_sleepingWorkers.fetch_sub(1, std::memory_order_relaxed);
+
+			if(job != nullptr) {
+				execute(*job);
+			}
+		}
+	}
+
+	auto JobSystem::currentWorker() -> Worker & {
+		assert(CURRENT_WORKER_INDEX < m_workers.size() && "jobs may only be scheduled from job system threads.");
+		return *m_workers[CURRENT_WORKER_INDEX];
+	}
+
+	auto JobSystem::allocateJob() -> Job * {
+		Worker &worker = currentWorker();
+		const uint32_t slot = worker.firstJob + (worker.nextJob % JOB_RING_CAPACITY);
+		// more jobs in flight than the ring holds, e.g. a parallelFor of many chunks, the oldest one is not done yet.
+		if(m_jobsInFlight[slot].load(std::memory_order_acquire)) {
+			return nullptr;
+		}
+
+		++worker.nextJob;
+		m_jobsInFlight[slot].store(true, std::memory_order_relaxed);
+		return &m_jobs[slot];
+	}
+
+	void JobSystem::submit(Job &job) {
+		if(!currentWorker().queue.push(&job)) {
+			// the deque is full, running the job right away is always correct just not parallel.
+			execute(job);
+			return;
+		}
+
+		m_wakeEpoch.fetch_add(1, std::memory_order_seq_cst);
+		if(m_sleepingWorkers.load(std::memory_order_seq_cst) != 0) {
+			m_wakeEpoch.notify_one();
+		}
+	}
+
+	auto JobSystem::findJob() -> Job * {
+		Worker &worker = currentWorker();
+		Job *job = worker.queue.pop();
+		if(job != nullptr) {
+			return job;
+		}
+
+		const auto workerCount = static_cast<uint32_t>(m_workers.size());
+		// start at a random victim so idle threads do not all hammer the same deque.
+		const uint32_t firstVictim = nextRandom(worker.stealSeed) % workerCount;
+		for(uint32_t i = 0; i < workerCount; ++i) {
+			Worker &victim = *m_workers[(firstVictim + i) % workerCount];
+			if(&victim == &worker) {
+				continue;
+			}
+
+			job = victim.queue.steal();
+			if(job != nullptr) {
+				return job;
+			}
+		}
+		return nullptr;
+	}
+
+	void JobSystem::execute(Job &job) {
+		// picked up before its dependency finished, help with other jobs until it has.
+		if(job.dependency != nullptr) {
+			wait(*job.dependency);
+		}
+
+		job.invoke(job);
+
+		// the owner may refill the slot as soon as it is released, read what is still needed first.
+		JobCounter *counter = job.counter;
+		m_jobsInFlight[&job - m_jobs.get()].store(false, std::memory_order_release);
+
+		if(counter != nullptr) {
+			counter->m_pending.fetch_sub(1, std::memory_order_release);
+		}
+	}
+
+}  // namespace venus
@@ -0,0 +1,185 @@
+#ifndef VENUS_JOB_SYSTEM_HPP
+#define VENUS_JOB_SYSTEM_HPP
+
+// PROJECT
+#include "workStealingDeque.hpp"
+
+// STDLIB
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace venus {
+
+	// Counts unfinished jobs, scheduling with a counter increments it and completing the job decrements it.
+	class JobCounter {
+	public:
+		JobCounter() = default;
+		~JobCounter() = default;
+
+		JobCounter(const JobCounter &) = delete;
+		auto operator=(const JobCounter &) -> JobCounter & = delete;
+
+		JobCounter(const JobCounter &&) = delete;
+		auto operator=(const JobCounter &&) -> JobCounter & = delete;
+
+		[[nodiscard]] auto isDone() const -> bool { return m_pending.load(std::memory_order_acquire) == 0; }
+
+	private:
+		friend class JobSystem;
+		std::atomic<uint32_t> m_pending = 0;
+	};
+
+	/**
+   * @brief A work-stealing job scheduler.
+   *
+   * @details Every thread owns a Chase-Lev deque, jobs scheduled from a thread are pushed onto its own deque and idle
+   *          threads steal from the others. The thread constructing the job system becomes worker zero, so the main
+   *          thread takes part in the work whenever it waits on a counter instead of blocking.
+   *
+   *          Jobs are stored inline in a per-thread ring of JOB_RING_CAPACITY slots, scheduling never allocates. When
+   *          the next slot still holds a job that is queued or running, the new job runs on the scheduling thread
+   *          instead. The callable must fit JOB_PAYLOAD_SIZE bytes and be trivially destructible, capture by reference
+   *          or pointer.
+   *          Jobs must not throw, an exception escaping a job terminates the process.
+   *
+   *          A job scheduled with a dependency counter only runs once that counter reaches zero, a thread picking it up
+   *          early helps with other work until then. Jobs may only be scheduled from threads owned by the job system, or
+   *          from up to MAX_ATTACHED_THREADS other threads, such as the render thread, that attached themselves first.
+   *
+   *          Only one job system may exist at a time. This object cannot be copied. This object cannot be moved.
+   */
+	class JobSystem {
+	public:
+		// 'threadCount' includes the constructing thread, so one means every job runs on the caller when it waits.
+		explicit JobSystem(const uint32_t &threadCount);
+		~JobSystem();
+
+		JobSystem(const JobSystem &) = delete;
+		auto operator=(const JobSystem &) -> JobSystem & = delete;
+
+		JobSystem(const JobSystem &&) = delete;
+		auto operator=(const JobSystem &&) -> JobSystem & = delete;
+
+		template<typename Func>
+		void schedule(Func &&func, JobCounter *counter = nullptr, const JobCounter *dependency = nullptr);
+
+		// Runs other jobs on the calling thread until the counter reaches zero.
+		void wait(const JobCounter &counter);
+
+		// Calls 'func(begin, end)' for consecutive ranges of at most 'grainSize' indices covering [0, count) and
+		// returns once all of them are done. The first range runs on the calling thread.
+		template<typename Func>
+		void parallelFor(const uint32_t &count, const uint32_t &grainSize, const Func &func);
+
+		// Gives the calling thread its own deque so it may schedule and wait, its jobs can be stolen like any other.
+		// A thread must detach before it exits and only once every job it scheduled has finished.
+		void attachCurrentThread();
+		void detachCurrentThread();
+
+		// Number of threads running jobs, the constructing thread included and attached threads excluded.
+		[[nodiscard]] auto getThreadCount() const -> uint32_t { return m_threadCount; }
+
+		static constexpr size_t JOB_PAYLOAD_SIZE = 40;
+		static constexpr size_t JOB_RING_CAPACITY = 4096;
+		static constexpr uint32_t MAX_ATTACHED_THREADS = 4;
+
+	private:
+		static constexpr size_t CACHE_LINE_SIZE = 64;
+
+		struct alignas(CACHE_LINE_SIZE) Job {
+			void (*invoke)(Job &job) noexcept;
+			JobCounter *counter;
+			const JobCounter *dependency;
+			alignas(alignof(void *)) std::array<std::byte, JOB_PAYLOAD_SIZE> payload;
+		};
+		static_assert(sizeof(Job) == CACHE_LINE_SIZE, "a job should fill exactly one cache line.");
+
+		struct Worker {
+			WorkStealingDeque<Job, JOB_RING_CAPACITY> queue;
+			// the worker's ring is [firstJob, firstJob + JOB_RING_CAPACITY) of 'm_jobs'.
+			uint32_t firstJob = 0;
+			uint32_t nextJob = 0;
+			uint32_t stealSeed = 0;
+		};
+
+		// worker slots for the job threads followed by MAX_ATTACHED_THREADS slots for attached threads.
+		std::vector<std::unique_ptr<Worker>> m_workers;
+		// the job rings of all workers back to back, so 'execute()' finds a job's slot from its address alone.
+		std::unique_ptr<Job[]> m_jobs;
+		// set while the job in the slot is queued or running, only its owner sets it and only 'execute()' clears it.
+		std::unique_ptr<std::atomic<bool>[]> m_jobsInFlight;
+		std::vector<std::jthread> m_threads;
+		uint32_t m_threadCount = 0;
+		std::atomic<uint32_t> m_attachedSlotMask = 0;
+
+		std::atomic<uint32_t> m_wakeEpoch = 0;
+		std::atomic<uint32_t> m_sleepingWorkers = 0;
+		std::atomic<bool> m_stopping = false;
+
+		void workerLoop(const uint32_t &workerIndex);
+
+		[[nodiscard]] auto currentWorker() -> Worker &;
+		// Nothing when the worker's next slot is still in flight.
+		[[nodiscard]] auto allocateJob() -> Job *;
+		void submit(Job &job);
+		[[nodiscard]] auto findJob() -> Job *;
+		void execute(Job &job);
+	};
+
+	template<typename Func>
+	void JobSystem::schedule(Func &&func, JobCounter *counter, const JobCounter *dependency) {
+		using Callable = std::decay_t<Func>;
+		static_assert(sizeof(Callable) <= JOB_PAYLOAD_SIZE, "job callable is too large, capture by reference instead.");
+		static_assert(alignof(Callable) <= alignof(void *), "job callable is over-aligned.");
+		static_assert(std::is_trivially_destructible_v<Callable>, "job callables are never destroyed.");
+
+		Job *job = allocateJob();
+		if(job == nullptr) {
+			// every slot of the ring is in flight, running the job right away is always correct just not parallel.
+			if(dependency != nullptr) {
+				wait(*dependency);
+			}
+			func();
+			return;
+		}
+
+		::new(static_cast<void *>(job->payload.data())) Callable(std::forward<Func>(func));
+		job->invoke = [](Job &self) noexcept { (*std::launder(reinterpret_cast<Callable *>(self.payload.data())))(); };
+		job->counter = counter;
+		job->dependency = dependency;
+
+		if(counter != nullptr) {
+			counter->m_pending.fetch_add(1, std::memory_order_relaxed);
+		}
+		submit(*job);
+	}
+
+	template<typename Func>
+	void JobSystem::parallelFor(const uint32_t &count, const uint32_t &grainSize, const Func &func) {
+		if(count == 0) {
+			return;
+		}
+
+		const uint32_t grain = std::max(grainSize, 1U);
+		JobCounter counter;
+		for(uint32_t begin = grain; begin < count; begin += std::min(grain, count - begin)) {
+			const uint32_t end = begin + std::min(grain, count - begin);
+			schedule([&func, begin, end]() { func(begin, end); }, &counter);
+		}
+
+		func(0U, std::min(grain, count));
+		wait(counter);
+	}
+
+}  // namespace venus
+
+#endif  // VENUS_JOB_SYSTEM_HPP
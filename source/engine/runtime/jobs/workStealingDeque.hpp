@@ -0,0 +1,106 @@
+#ifndef VENUS_WORK_STEALING_DEQUE_HPP
+#define VENUS_WORK_STEALING_DEQUE_HPP
+
+// STDLIB
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace venus {
+
+	/**
+   * @brief A fixed capacity Chase-Lev work-stealing deque of pointers.
+   *
+   * @details The owning thread pushes and pops at the bottom, any other thread may steal from the top.
+   *          Owner operations are wait-free, a steal can only fail by losing a race for the last items.
+   *          Memory orderings follow Le, Pop, Cohen and Nardelli, "Correct and Efficient Work-Stealing for Weak
+   *          Memory Models" (PPoPP 2013), the buffer is fixed so it never needs to grow.
+   *
+   *          This object cannot be copied. This object cannot be moved.
+   */
+	template<typename T, size_t Capacity>
+	class WorkStealingDeque {
+		static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "capacity must be a power of two.");
+
+	public:
+		WorkStealingDeque() = default;
+		~WorkStealingDeque() = default;
+
+		WorkStealingDeque(const WorkStealingDeque &) = delete;
+		auto operator=(const WorkStealingDeque &) -> WorkStealingDeque & = delete;
+
+		WorkStealingDeque(const WorkStealingDeque &&) = delete;
+		auto operator=(const WorkStealingDeque &&) -> WorkStealingDeque & = delete;
+
+		// Owner only, returns false when the deque is full.
+		auto push(T *item) -> bool {
+			const int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+			const int64_t top = m_top.load(std::memory_order_acquire);
+			if(bottom - top >= static_cast<int64_t>(Capacity)) {
+				return false;
+			}
+
+			// release on the slot as well as the fence keeps race detectors, which do not model fences, accurate.
+			m_items[static_cast<size_t>(bottom) & MASK].store(item, std::memory_order_release);
+			std::atomic_thread_fence(std::memory_order_release);
+			m_bottom.store(bottom + 1, std::memory_order_relaxed);
+			return true;
+		}
+
+		// Owner only, returns the most recently pushed item or nullptr when empty.
+		auto pop() -> T * {
+			const int64_t bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+			m_bottom.store(bottom, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			int64_t top = m_top.load(std::memory_order_relaxed);
+
+			if(top > bottom) {
+				m_bottom.store(bottom + 1, std::memory_order_relaxed);
+				return nullptr;
+			}
+
+			T *item = m_items[static_cast<size_t>(bottom) & MASK].load(std::memory_order_relaxed);
+			if(top == bottom) {
+				// last item, race any thief for it.
+				if(!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+					item = nullptr;
+				}
+				m_bottom.store(bottom + 1, std::memory_order_relaxed);
+			}
+			return item;
+		}
+
+		// Any thread, returns the oldest item or nullptr when empty or when another thread won the race.
+		auto steal() -> T * {
+			int64_t top = m_top.load(std::memory_order_acquire);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			const int64_t bottom = m_bottom.load(std::memory_order_acquire);
+			if(top >= bottom) {
+				return nullptr;
+			}
+
+			T *item = m_items[static_cast<size_t>(top) & MASK].load(std::memory_order_acquire);
+			if(!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+				return nullptr;
+			}
+			return item;
+		}
+
+		[[nodiscard]] auto approximateSize() const -> int64_t {
+			return m_bottom.load(std::memory_order_relaxed) - m_top.load(std::memory_order_relaxed);
+		}
+
+	private:
+		static constexpr size_t MASK = Capacity - 1;
+		static constexpr size_t CACHE_LINE_SIZE = 64;
+
+		// top is written by thieves and bottom by the owner, keeping them apart avoids false sharing.
+		alignas(CACHE_LINE_SIZE) std::atomic<int64_t> m_top = 0;
+		alignas(CACHE_LINE_SIZE) std::atomic<int64_t> m_bottom = 0;
+		alignas(CACHE_LINE_SIZE) std::array<std::atomic<T *>, Capacity> m_items{};
+	};
+
+}  // namespace venus
+
+#endif  // VENUS_WORK_STEALING_DEQUE_HPP
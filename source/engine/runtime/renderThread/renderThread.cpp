@@ -0,0 +1,74 @@
+#include "renderThread.hpp"
+#include "VN_logger.hpp"
+#include "jobSystem.hpp"
+#include "renderer.hpp"
+
+// THIRD PARTY
+#define GLFW_INCLUDE_NONE
+#include "GLFW/glfw3.h"
+
+namespace venus {
+
+	RenderThread::RenderThread(const std::shared_ptr<Renderer> &rendererPtr,
+														 const std::shared_ptr<JobSystem> &jobSystemPtr):
+		m_renderer(rendererPtr), m_jobSystem(jobSystemPtr), m_thread(&RenderThread::renderLoop, this) {
+		VN_LOG_INFO("Render thread has been started.");
+	}
+
+	RenderThread::~RenderThread() {
+		if(m_thread.joinable()) {
+			m_stopping.store(true, std::memory_order_release);
+			m_publishedFrames.fetch_add(1, std::memory_order_release);
+			m_publishedFrames.notify_one();
+			m_thread.join();
+		}
+		VN_LOG_INFO("Render thread has been destroyed.");
+	}
+
+	void RenderThread::publishFrame() {
+		m_frameStates.publish();
+		m_publishedFrames.fetch_add(1, std::memory_order_release);
+		m_publishedFrames.notify_one();
+	}
+
+	void RenderThread::stop() {
+		m_stopping.store(true, std::memory_order_release);
+		m_publishedFrames.fetch_add(1, std::memory_order_release);
+		m_publishedFrames.notify_one();
+		m_thread.join();
+
+		if(m_renderError) {
+			std::rethrow_exception(m_renderError);
+		}
+	}
+
+	void RenderThread::renderLoop() {
+		m_jobSystem->attachCurrentThread();
+
+		try {
+			while(true) {
+				// read before looking for a state, a publish after the look changes it so the wait below falls through.
+				const uint64_t publishedFrames = m_publishedFrames.load(std::memory_order_acquire);
+				if(m_frameStates.consume()) {
+					glfwPostEmptyEvent();  // wakes the main thread to produce the next state while this one is drawn.
+					m_renderer->draw(m_frameStates.readBuffer());
+					m_renderedFrames.fetch_add(1, std::memory_order_release);
+					continue;
+				}
+
+				if(m_stopping.load(std::memory_order_acquire)) {
+					break;
+				}
+				m_publishedFrames.wait(publishedFrames, std::memory_order_acquire);
+			}
+		} catch(...) {
+			VN_LOG_CRITICAL("Render thread stopped after an error.");
+			m_renderError = std::current_exception();
+			m_failed.store(true, std::memory_order_release);
+			glfwPostEmptyEvent();
+		}
+
+		m_jobSystem->detachCurrentThread();
+	}
+
+}  // namespace venus
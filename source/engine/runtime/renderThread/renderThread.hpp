@@ -0,0 +1,79 @@
+#ifndef VENUS_RENDER_THREAD_HPP
+#define VENUS_RENDER_THREAD_HPP
+
+// PROJECT
+#include "frameState.hpp"
+#include "tripleBuffer.hpp"
+
+// STDLIB
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <thread>
+
+namespace venus {
+	class Renderer;
+	class JobSystem;
+
+	/**
+   * @brief Runs the renderer on a dedicated thread fed with frame states from the main thread.
+   *
+   * @details The main thread keeps polling glfw and produces one FrameState per frame into a triple buffer, the render
+   *          thread draws the newest published state. A blocking fence wait or present therefore never stalls event
+   *          processing, and the main thread builds frame N+1 while frame N is being recorded and submitted.
+   *
+   *          Whenever the render thread takes a state it posts an empty glfw event, so a main thread sleeping in
+   *          glfwWaitEvents wakes up to produce the next one. The render thread attaches itself to the job system so
+   *          recording may still fan out across the workers.
+   *
+   *          An exception thrown while drawing stops the render thread, it is rethrown on the main thread by 'stop()'.
+   *
+   *          This object cannot be copied. This object cannot be moved.
+   */
+	class RenderThread {
+	public:
+		explicit RenderThread(const std::shared_ptr<Renderer> &rendererPtr, const std::shared_ptr<JobSystem> &jobSystemPtr);
+		~RenderThread();
+
+		RenderThread(const RenderThread &) = delete;
+		auto operator=(const RenderThread &) -> RenderThread & = delete;
+
+		RenderThread(const RenderThread &&) = delete;
+		auto operator=(const RenderThread &&) -> RenderThread & = delete;
+
+		// Main thread only, fill the returned state and then call 'publishFrame()'.
+		[[nodiscard]] auto frameState() -> FrameState & { return m_frameStates.writeBuffer(); }
+		void publishFrame();
+
+		// True once the render thread has taken the last published state, producing more before then only replaces it.
+		[[nodiscard]] auto isReadyForFrame() const -> bool { return !m_frameStates.hasUnconsumed(); }
+		[[nodiscard]] auto hasFailed() const -> bool { return m_failed.load(std::memory_order_acquire); }
+
+		// Draws the last published state if it is still pending, joins the thread and rethrows any render error.
+		void stop();
+
+		[[nodiscard]] auto getRenderedFrameCount() const -> uint64_t {
+			return m_renderedFrames.load(std::memory_order_acquire);
+		}
+
+	private:
+		std::shared_ptr<Renderer> m_renderer;
+		std::shared_ptr<JobSystem> m_jobSystem;
+
+		TripleBuffer<FrameState> m_frameStates;
+		std::atomic<uint64_t> m_publishedFrames = 0;  // bumped on every publish and on stop, the render thread waits on it.
+		std::atomic<uint64_t> m_renderedFrames = 0;
+		std::atomic<bool> m_stopping = false;
+		std::atomic<bool> m_failed = false;
+		std::exception_ptr m_renderError;
+
+		void renderLoop();
+
+		// declared last so every member above is constructed before the thread starts and outlives its join.
+		std::jthread m_thread;
+	};
+
+}  // namespace venus
+
+#endif  // VENUS_RENDER_THREAD_HPP
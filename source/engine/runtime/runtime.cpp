@@ -1,7 +1,11 @@
 #include "runtime.hpp"
 #include "VN_logger.hpp"
 #include "instance.hpp"
+#include "jobSystem.hpp"
+#include "pipelineCache.hpp"
+#include "renderThread.hpp"
 #include "renderer.hpp"
+#include "systemProperties.hpp"
 #include "window.hpp"
 
 // THIRD PARTY
@@ -10,6 +14,12 @@
 #define GLFW_INCLUDE_NONE
 #include "GLFW/glfw3.h"
 
+// STDLIB
+#include <algorithm>
+#include <chrono>
+#include <format>
+#include <limits>
+
 namespace venus {
 	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 	/**
@@ -23,6 +33,9 @@ namespace venus {
    *          This object must remain on the main thread, since it controls glfw initialization.
    *          This object must be the first runtime object created and initialized.
    *
+   *          When running headless glfw is initialized with its null platform, every window and surface created
+   *          afterwards is then display-less and backed by VK_EXT_headless_surface.
+   *
    *          This object is not copyable. This object is not moveable.
    * 
    */
@@ -33,10 +46,14 @@ namespace venus {
 		RuntimeBootstrapper(const RuntimeBootstrapper &&) = delete;
 		auto operator=(const RuntimeBootstrapper &&) -> RuntimeBootstrapper && = delete;
 
-		RuntimeBootstrapper(const ApplicationIdentityDetails &appID) {
+		RuntimeBootstrapper(const ApplicationIdentityDetails &appID, const bool &headless) {
 			// error callback must be set before initializing glfw
 			// initialize glfw first just in case it affects definitions loaded for vulkan
 			glfwSetErrorCallback(glfwErrorCallbackFunc);
+			if(headless) {
+				glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+				VN_LOG_INFO("Initializing glfw with the null platform for headless rendering.");
+			}
 			if(glfwInit() != GLFW_TRUE) {
 				VN_LOG_CRITICAL("Failed to initialize glfw.");
 				glfwSetErrorCallback(nullptr);
@@ -86,24 +103,137 @@ namespace venus {
 	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	Runtime::Runtime(const ApplicationConfigDetails &configDetails): m_details(configDetails) {
-		m_bootStrapper = std::make_unique<RuntimeBootstrapper>(configDetails.identity);
+		m_bootStrapper = std::make_unique<RuntimeBootstrapper>(configDetails.identity, configDetails.headlessConfig.enabled);
+		// hardware_concurrency may report zero when it cannot tell, the main thread alone still runs every job.
+		m_jobSystem = std::make_shared<JobSystem>(std::max(SystemProperties().getThreadCount(), 1U));
 		m_window = std::make_shared<Window>(m_details.windowConfig);
-		m_renderer = std::make_unique<Renderer>(m_window);
+
+		const auto RENDERER_START = std::chrono::steady_clock::now();
+		m_renderer = std::make_shared<Renderer>(m_window, m_jobSystem, m_details);
+		const std::chrono::duration<double, std::milli> RENDERER_CREATION =
+			std::chrono::steady_clock::now() - RENDERER_START;
+		m_rendererCreationMilliseconds = RENDERER_CREATION.count();
+
+		VN_LOG_INFO(std::format("Renderer created in {:.3f} ms, pipelines keep compiling in the background.",
+														m_rendererCreationMilliseconds));
 		VN_LOG_INFO("Venus Runtime has been created.");
 	}
 
 	void Runtime::startEngine() {
-		while(!m_window->shouldClose()) {
-			glfwPollEvents();  // polls for window and input events handled by glfw.
-			m_renderer->draw();
+		uint64_t frameLimit = std::numeric_limits<uint64_t>::max();
+		if(m_details.headlessConfig.enabled) {
+			frameLimit = m_details.headlessConfig.frameCount != 0 ? m_details.headlessConfig.frameCount :
+																															 DEFAULT_HEADLESS_FRAME_COUNT;
+			VN_LOG_INFO(std::format("Running headless for {} frames.", frameLimit));
+
+			// frames drawn while pipelines compile skip their draws and would flatter the measured throughput.
+			m_renderer->waitForPipelines();
 		}
 
+		m_loopStart = std::chrono::steady_clock::now();
+		m_lastFrameStateTime = m_loopStart;
+		const uint64_t frameCount =
+			m_details.renderThreadConfig.enabled ? runWithRenderThread(frameLimit) : runSingleThreaded(frameLimit);
+
 		vkDeviceWaitIdle(volkGetLoadedDevice());
+
+		// the wait above ensures every submitted frame has actually been rendered before we measure.
+		const std::chrono::duration<double> ELAPSED = std::chrono::steady_clock::now() - m_loopStart;
+		m_throughputReport = {.frameCount = frameCount,
+													.elapsedSeconds = ELAPSED.count(),
+													.framesPerSecond = ELAPSED.count() > 0.0 ? static_cast<double>(frameCount) / ELAPSED.count() : 0.0,
+													.averageFrameMilliseconds =
+														frameCount > 0 ? (ELAPSED.count() * 1000.0) / static_cast<double>(frameCount) : 0.0};
+
+		VN_LOG_INFO(std::format("Rendered {} frames in {:.3f}s, {:.1f} fps, {:.3f} ms per frame.",
+														m_throughputReport.frameCount, m_throughputReport.elapsedSeconds,
+														m_throughputReport.framesPerSecond, m_throughputReport.averageFrameMilliseconds));
+	}
+
+	auto Runtime::runSingleThreaded(const uint64_t &frameLimit) -> uint64_t {
+		FrameState frameState{};
+		uint64_t frameCount = 0;
+		while(!m_window->shouldClose() && frameCount < frameLimit) {
+			glfwPollEvents();  // polls for window and input events handled by glfw.
+			fillFrameState(frameState);
+			m_renderer->draw(frameState);
+			++frameCount;
+		}
+		return frameCount;
+	}
+
+	auto Runtime::runWithRenderThread(const uint64_t &frameLimit) -> uint64_t {
+		m_renderThread = std::make_unique<RenderThread>(m_renderer, m_jobSystem);
+
+		uint64_t producedFrames = 0;
+		while(!m_window->shouldClose() && producedFrames < frameLimit && !m_renderThread->hasFailed()) {
+			if(!m_renderThread->isReadyForFrame()) {
+				// the render thread posts an empty event when it takes a state, so this sleeps until input or that.
+				glfwWaitEvents();
+				continue;
+			}
+
+			glfwPollEvents();
+			fillFrameState(m_renderThread->frameState());
+			m_renderThread->publishFrame();
+			++producedFrames;
+		}
+
+		m_renderThread->stop();
+		const uint64_t renderedFrames = m_renderThread->getRenderedFrameCount();
+		m_renderThread.reset();
+		return renderedFrames;
+	}
+
+	void Runtime::fillFrameState(FrameState &frameState) {
+		const auto NOW = std::chrono::steady_clock::now();
+		frameState = {.frameNumber = m_frameNumber++,
+									.simulationSeconds = std::chrono::duration<double>(NOW - m_loopStart).count(),
+									.deltaSeconds = std::chrono::duration<float>(NOW - m_lastFrameStateTime).count(),
+									.drawList = 0};
+		m_lastFrameStateTime = NOW;
+
+		if(m_frameCallback) {
+			m_frameCallback(frameState);
+		}
+		// draws submitted from now on, by any thread, land in the next frame.
+		frameState.drawList = m_renderer->sealDrawList();
+	}
+
+	auto Runtime::createMesh(const MeshData &meshData) -> MeshHandle { return m_renderer->createMesh(meshData); }
+
+	void Runtime::destroyMesh(const MeshHandle &mesh) { m_renderer->destroyMesh(mesh); }
+
+	auto Runtime::createTexture(const TextureData &textureData) -> TextureHandle {
+		return m_renderer->createTexture(textureData);
+	}
+
+	void Runtime::destroyTexture(const TextureHandle &texture) { m_renderer->destroyTexture(texture); }
+
+	auto Runtime::createMaterial(const MaterialDetails &details) -> MaterialHandle {
+		return m_renderer->createMaterial(details);
+	}
+
+	auto Runtime::submitDraw(const DrawPacket &packet) -> bool { return m_renderer->submitDraw(packet); }
+
+	auto Runtime::getFrameTimingReport() const -> FrameTimingReport { return m_renderer->getFrameTimingReport(); }
+
+	auto Runtime::getStartupReport() const -> StartupReport {
+		// pipelines compile after the renderer is created, the report waits for them so their figures are complete.
+		m_renderer->waitForPipelines();
+		const PipelineCacheStatistics pipelineStatistics = m_renderer->getPipelineCacheStatistics();
+		return {.rendererCreationMilliseconds = m_rendererCreationMilliseconds,
+						.pipelineCreationMilliseconds = pipelineStatistics.creationMilliseconds,
+						.pipelineCacheHits = pipelineStatistics.hitCount,
+						.pipelineCacheMisses = pipelineStatistics.missCount,
+						.pipelineCacheLoaded = pipelineStatistics.loadedFromDisk};
 	}
 
 	Runtime::~Runtime() {
+		m_renderThread.reset();
 		m_renderer.reset();
 		m_window.reset();
+		m_jobSystem.reset();
 		m_bootStrapper.reset();
 		VN_LOG_INFO("Venus Runtime has been destroyed.");
 	}
@@ -2,15 +2,22 @@
 #define VENUS_ENGINE_RUNTIME_HPP
 
 // PROJECT
+#include "drawPacket.hpp"
+#include "frameState.hpp"
+#include "frameStatistics.hpp"
 #include "venusConfigOptions.hpp"
 
 // STDLIB
+#include <chrono>
 #include <memory>
+#include <utility>
 
 namespace venus {
 	class RuntimeBootstrapper;
 	class Window;
 	class Renderer;
+	class JobSystem;
+	class RenderThread;
 
 	/**
    * @brief A runtime manager object.
@@ -18,6 +25,11 @@ namespace venus {
    * @class Runtime
    *
    * @details This object manages the runtime loop and the necessary components for loop steps.
+   *          Headless runs stop after a fixed number of frames, the loop throughput is available afterwards. They wait
+   *          for background pipeline compilation before the loop starts, so every measured frame draws.
+   *          The job system is sized from SystemProperties, the main thread is one of its workers.
+   *          With a render thread the main thread only polls events and produces frame states, otherwise it also draws.
+   *          Producing a frame state runs the client's frame callback and then seals the frame's draw list.
    *
    *          This object cannot be copied. This object cannot be moved.
    */
@@ -33,12 +45,39 @@ namespace venus {
 
 		void startEngine();
 
+		[[nodiscard]] auto getThroughputReport() const -> FrameThroughputReport { return m_throughputReport; }
+		[[nodiscard]] auto getFrameTimingReport() const -> FrameTimingReport;
+		[[nodiscard]] auto getStartupReport() const -> StartupReport;
+
+		[[nodiscard]] auto createMesh(const MeshData &meshData) -> MeshHandle;
+		void destroyMesh(const MeshHandle &mesh);
+		[[nodiscard]] auto createTexture(const TextureData &textureData) -> TextureHandle;
+		void destroyTexture(const TextureHandle &texture);
+		[[nodiscard]] auto createMaterial(const MaterialDetails &details) -> MaterialHandle;
+		auto submitDraw(const DrawPacket &packet) -> bool;
+
+		// Must be set before 'startEngine()'.
+		void setFrameCallback(FrameCallback frameCallback) { m_frameCallback = std::move(frameCallback); }
+
 	private:
 		ApplicationConfigDetails m_details;
+		FrameThroughputReport m_throughputReport{};
+		double m_rendererCreationMilliseconds = 0.0;
 		std::unique_ptr<RuntimeBootstrapper> m_bootStrapper;
+		std::shared_ptr<JobSystem> m_jobSystem;  // JobSystem is needed by Renderer class.
 		std::shared_ptr<Window> m_window;  // Window is needed by Renderer class.
 
-		std::unique_ptr<Renderer> m_renderer;
+		std::shared_ptr<Renderer> m_renderer;
+		std::unique_ptr<RenderThread> m_renderThread;
+
+		FrameCallback m_frameCallback;
+		uint64_t m_frameNumber = 0;
+		std::chrono::steady_clock::time_point m_loopStart;
+		std::chrono::steady_clock::time_point m_lastFrameStateTime;
+		void fillFrameState(FrameState &frameState);
+
+		[[nodiscard]] auto runSingleThreaded(const uint64_t &frameLimit) -> uint64_t;
+		[[nodiscard]] auto runWithRenderThread(const uint64_t &frameLimit) -> uint64_t;
 	};
 
 }  // namespace venus
@@ -50,7 +50,14 @@ namespace venus {
 
 	Window::Window(const WindowConfigDetails &configDetails): m_details(configDetails) {
 		glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
-		glfwWindowHint(GLFW_RESIZABLE, GLFW_FALSE);
+		glfwWindowHint(GLFW_RESIZABLE, GLFW_TRUE);
+
+		// also where leaving fullscreen puts the window when it was created fullscreen, centered on the monitor.
+		const WindowResolution resolution = getDesiredResolution(m_details);
+		m_windowedPlacement = {.x = (m_mode->width - resolution.width) / 2,
+													 .y = (m_mode->height - resolution.height) / 2,
+													 .width = resolution.width,
+													 .height = resolution.height};
 
 		if((m_details.WindowModeFlag & WINDOW_MODE_NORMAL_FLAG_BIT) != 0) {
 			createNormalWindow();
@@ -67,6 +74,14 @@ namespace venus {
 
 		createSurface();
 
+		int framebufferWidth = 0;
+		int framebufferHeight = 0;
+		glfwGetFramebufferSize(m_window, &framebufferWidth, &framebufferHeight);
+		m_framebufferExtent.store(
+			{.width = static_cast<uint32_t>(framebufferWidth), .height = static_cast<uint32_t>(framebufferHeight)});
+
+		glfwSetWindowUserPointer(m_window, this);
+		glfwSetFramebufferSizeCallback(m_window, framebufferResizeCallback);
 		glfwSetKeyCallback(m_window, key_callback);
 
 		VN_LOG_INFO("Venus Window has been created.");
@@ -79,21 +94,22 @@ namespace venus {
 	}
 
 	void Window::createNormalWindow() {
-		auto resolution = getDesiredResolution(m_details);
-		m_window = glfwCreateWindow(resolution.width, resolution.height, m_details.title, nullptr, nullptr);
+		m_window =
+			glfwCreateWindow(m_windowedPlacement.width, m_windowedPlacement.height, m_details.title, nullptr, nullptr);
 		assert(m_window != nullptr);
 	}
 
 	void Window::createFullscreenWindow() {
-		auto resolution = getDesiredResolution(m_details);
-		m_window = glfwCreateWindow(resolution.width, resolution.height, m_details.title, m_monitor, nullptr);
+		m_window =
+			glfwCreateWindow(m_windowedPlacement.width, m_windowedPlacement.height, m_details.title, m_monitor, nullptr);
 		assert(m_window != nullptr);
 	}
 
 	void Window::createBorderlessWindow() {
-		auto resolution = getDesiredResolution(m_details);
-		m_window = glfwCreateWindow(resolution.width, resolution.height, m_details.title, nullptr, nullptr);
-		glfwSetWindowMonitor(m_window, m_monitor, 0, 0, resolution.width, resolution.height, GLFW_DONT_CARE);
+		m_window =
+			glfwCreateWindow(m_windowedPlacement.width, m_windowedPlacement.height, m_details.title, nullptr, nullptr);
+		glfwSetWindowMonitor(m_window, m_monitor, 0, 0, m_windowedPlacement.width, m_windowedPlacement.height,
+												 GLFW_DONT_CARE);
 		assert(m_window != nullptr);
 	}
 
@@ -124,13 +140,27 @@ namespace venus {
 
 	void Window::changeResolution(uint16_t width, uint16_t height) { glfwSetWindowSize(m_window, width, height); }
 
-	auto Window::getCurrentSurfaceExtent() -> VkExtent2D {
-		int glfw_width = 0;
-		int glfw_height = 0;
+	void Window::framebufferResizeCallback(GLFWwindow *window, int width, int height) {
+		auto *venusWindow = static_cast<Window *>(glfwGetWindowUserPointer(window));
+		assert(venusWindow != nullptr);
 
-		glfwGetFramebufferSize(m_window, &glfw_width, &glfw_height);
+		venusWindow->m_framebufferExtent.store(
+			{.width = static_cast<uint32_t>(width), .height = static_cast<uint32_t>(height)});
+		venusWindow->m_framebufferResized.store(true);
+	}
+
+	void Window::toggleFullscreen() {
+		if(glfwGetWindowMonitor(m_window) != nullptr) {
+			glfwSetWindowMonitor(m_window, nullptr, m_windowedPlacement.x, m_windowedPlacement.y, m_windowedPlacement.width,
+													 m_windowedPlacement.height, GLFW_DONT_CARE);
+			VN_LOG_INFO("Window has left fullscreen.");
+			return;
+		}
 
-		return {.width = static_cast<uint32_t>(glfw_width), .height = static_cast<uint32_t>(glfw_height)};
+		glfwGetWindowPos(m_window, &m_windowedPlacement.x, &m_windowedPlacement.y);
+		glfwGetWindowSize(m_window, &m_windowedPlacement.width, &m_windowedPlacement.height);
+		glfwSetWindowMonitor(m_window, m_monitor, 0, 0, m_mode->width, m_mode->height, m_mode->refreshRate);
+		VN_LOG_INFO("Window has entered fullscreen.");
 	}
 
 }  // namespace venus
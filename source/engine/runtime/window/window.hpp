@@ -10,6 +10,9 @@
 #define GLFW_INCLUDE_NONE
 #include "GLFW/glfw3.h"
 
+// STDLIB
+#include <atomic>
+
 namespace venus {
 	/**
    * @brief A window-system-integration object.
@@ -20,6 +23,9 @@ namespace venus {
    *          This object cannot be copied. This object cannot be moved.
    * 
    *          Creates different windows with different aspect ratios and resolutions depending upon the bit flags in configDetails.
+   *
+   *          Windows are resizable, framebuffer size changes are recorded by a glfw callback and consumed by the renderer
+   *          which rebuilds its swapchain in place. The cached framebuffer extent may be read from any thread.
    */
 	class Window {
 	public:
@@ -33,7 +39,16 @@ namespace venus {
 
 		[[nodiscard]] auto shouldClose() const { return static_cast<bool>(glfwWindowShouldClose(m_window)); }
 		[[nodiscard]] auto getSurfaceHandle() const { return m_surface; }
-		[[nodiscard]] auto getCurrentSurfaceExtent() -> VkExtent2D;
+		[[nodiscard]] auto getPresentPolicy() const -> PresentPolicyFlags {
+			return m_details.PresentPolicyFlag != 0 ? m_details.PresentPolicyFlag : PRESENT_POLICY_LOW_LATENCY_FLAG_BIT;
+		}
+		[[nodiscard]] auto getCurrentSurfaceExtent() const -> VkExtent2D { return m_framebufferExtent.load(); }
+
+		// Returns true once for every framebuffer resize since the previous call.
+		[[nodiscard]] auto consumeFramebufferResize() -> bool { return m_framebufferResized.exchange(false); }
+
+		// Switches between fullscreen on the primary monitor and the previous windowed placement, main thread only.
+		void toggleFullscreen();
 
 	private:
 		WindowConfigDetails m_details;
@@ -44,6 +59,19 @@ namespace venus {
 
 		VkSurfaceKHR m_surface = VK_NULL_HANDLE;
 
+		std::atomic<VkExtent2D> m_framebufferExtent{VkExtent2D{.width = 0, .height = 0}};
+		std::atomic<bool> m_framebufferResized = false;
+		static void framebufferResizeCallback(GLFWwindow *window, int width, int height);
+
+		// the desired resolution until the window first enters fullscreen, then where it was before.
+		struct WindowedPlacement {
+			int x;
+			int y;
+			int width;
+			int height;
+		};
+		WindowedPlacement m_windowedPlacement{};
+
 		void createNormalWindow();
 		void createFullscreenWindow();
 		void createBorderlessWindow();
@@ -0,0 +1,16 @@
+// The bindless set, laid out as BindlessDescriptors creates it. Resources are indexed by the uint the renderer hands
+// out for them, wrap indices that differ between invocations in nonuniformEXT.
+// Needs GL_EXT_nonuniform_qualifier.
+
+layout(set = 0, binding = 0) uniform texture2D bindlessTextures[];
+layout(set = 0, binding = 1) uniform sampler bindlessSamplers[];
+// storage buffers as raw words, a shader wanting typed access declares its own block at binding 2.
+layout(set = 0, binding = 2) readonly buffer BindlessBuffer {
+  uint words[];
+} bindlessBuffers[];
+
+// the linear, repeating sampler that always exists.
+const uint DEFAULT_SAMPLER = 0u;
+
+// index meaning no resource.
+const uint NO_RESOURCE = 0xFFFFFFFFu;
@@ -0,0 +1,19 @@
+// One draw of the frame as the renderer writes it, laid out as DrawInstance in drawCuller.hpp.
+// Included by shaders that read the frame's instances through the buffer address in their push constants.
+
+struct DrawInstance {
+  mat4 transform; // mesh to clip space
+  vec4 baseColor;
+  vec3 boundsMin; // mesh space box around the mesh
+  uint firstIndex;
+  vec3 boundsMax;
+  uint indexCount;
+  int vertexOffset;
+  uint batch; // counter the culling pass appends the draw to
+  uint firstCommand; // first indirect command of the batch
+  uint baseColorTexture; // sampled image of the bindless set, 0xFFFFFFFF for none
+};
+
+layout(buffer_reference, std430, buffer_reference_align = 16) readonly buffer DrawInstances {
+  DrawInstance instances[];
+};
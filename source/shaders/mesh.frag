@@ -0,0 +1,18 @@
+#version 460
+#extension GL_GOOGLE_include_directive : require
+#extension GL_EXT_nonuniform_qualifier : require
+
+#include "bindless.glsl"
+
+layout(location = 0) in vec4 fragColor;
+layout(location = 1) in vec2 fragUV;
+layout(location = 2) flat in uint fragTexture;
+layout(location = 0) out vec4 outColor;
+
+void main(){
+  outColor = fragColor;
+  // draws of different materials may share a subgroup, so the index is not uniform.
+  if(fragTexture != NO_RESOURCE){
+    outColor *= texture(sampler2D(bindlessTextures[nonuniformEXT(fragTexture)], bindlessSamplers[DEFAULT_SAMPLER]), fragUV);
+  }
+}
@@ -0,0 +1,30 @@
+#version 460
+#extension GL_GOOGLE_include_directive : require
+#extension GL_EXT_buffer_reference : require
+
+#include "drawInstance.glsl"
+
+layout(location = 0) in vec3 inPosition;
+layout(location = 1) in vec3 inNormal;
+layout(location = 2) in vec2 inUV;
+
+layout(push_constant) uniform DrawConstants {
+  DrawInstances frame; // indexed by the instance the culling pass wrote into the draw
+} draw;
+
+layout(location = 0) out vec4 fragColor;
+layout(location = 1) out vec2 fragUV;
+layout(location = 2) flat out uint fragTexture;
+
+// fixed light from the viewer, enough to tell the faces of a mesh apart.
+const vec3 LIGHT_DIRECTION = vec3(0.0, 0.0, -1.0);
+
+void main(){
+  DrawInstance instance = draw.frame.instances[gl_InstanceIndex];
+  gl_Position = instance.transform * vec4(inPosition, 1.0);
+  vec3 normal = normalize(mat3(instance.transform) * inNormal);
+  float lighting = 0.35 + 0.65 * max(dot(normal, LIGHT_DIRECTION), 0.0);
+  fragColor = vec4(instance.baseColor.rgb * lighting, instance.baseColor.a);
+  fragUV = inUV;
+  fragTexture = instance.baseColorTexture;
+}
@@ -1,5 +1,9 @@
 #! /bin/bash
 
+# shaders are compiled and embedded by the build, see cmake/embedShaders.cmake.
+# this script only produces loose .spv files for the development override, pass the output directory to
+# V_client with '--shader-dir' to use them without rebuilding.
+
 # relative path to shader sources
 cd ../../source/shaders;
 # relative path to glslc FROM shader sources